@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "interfaces.hpp"
+
+namespace MatrixTransform {
+
+    // Serves multiply requests from local clients on a Unix socket (see serve_protocol.hpp).
+    // Operands and results stay in buffers the clients share by file descriptor, so nothing
+    // is copied through the socket. A scheduler thread groups pending requests by shape and
+    // runs each group as one multiplyBatch() on the backend, as soon as it holds maxBatch
+    // requests or its oldest request has waited batchWindow. A zero window batches whatever
+    // arrived while the previous batch ran.
+    class BatchServer {
+    public:
+        struct Options {
+            std::string socketPath = "/tmp/matrix_app.sock";
+            std::size_t maxBatch = 64;
+            std::chrono::microseconds batchWindow{200};
+        };
+
+        BatchServer(IMultiplier& backend, Options options);
+        ~BatchServer();
+
+        BatchServer(const BatchServer&) = delete;
+        BatchServer& operator=(const BatchServer&) = delete;
+
+        // Binds the socket and serves until stop() is called.
+        void run();
+
+        // Makes run() return. Async-signal-safe.
+        void stop();
+
+    private:
+        struct State;
+        std::unique_ptr<State> state_;
+    };
+
+} // namespace MatrixTransform
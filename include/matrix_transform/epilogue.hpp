@@ -0,0 +1,23 @@
+#pragma once
+#include "matrix_types.hpp"
+#include <optional>
+
+namespace MatrixTransform {
+
+enum class Activation { None, ReLU, GELU };
+
+// Element-wise work fused into the store of a product, so inference layers need no extra
+// passes over the output:
+//     c(i, j) = activation(scale * (a * b)(i, j) + bias) + residual(i, j)
+// bias holds one value per column of c (per output feature for row-major activations), or
+// one per row with biasPerRow; a null bias is skipped. residual has c's size and must not
+// overlap c. GELU uses the tanh approximation.
+struct Epilogue {
+    float scale = 1.0f;
+    const float* bias = nullptr;
+    bool biasPerRow = false;
+    Activation activation = Activation::None;
+    std::optional<ConstMatrixView> residual;
+};
+
+} // namespace MatrixTransform
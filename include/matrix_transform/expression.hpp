@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "interfaces.hpp"
+
+namespace MatrixTransform {
+
+    // Lazily recorded matrix expression: products, sums, differences and scalar scaling.
+    // Nothing is computed until an ExpressionEvaluator runs it. Leaves refer to caller-owned
+    // matrices, which must outlive the evaluation. Products flatten into chains, so
+    // Expression(a) * b * c * v is one chain whose order is chosen at evaluation time.
+    class Expression {
+    public:
+        Expression(const Matrix& matrix);
+
+        Eigen::Index rows() const;
+        Eigen::Index cols() const;
+
+        // Human-readable form of the recorded tree, e.g. "2 * [100x10] * [10x100] + [100x100]".
+        std::string toString() const;
+
+        friend Expression operator*(const Expression& lhs, const Expression& rhs);
+        friend Expression operator*(float scale, const Expression& expression);
+        friend Expression operator*(const Expression& expression, float scale);
+        friend Expression operator+(const Expression& lhs, const Expression& rhs);
+        friend Expression operator-(const Expression& lhs, const Expression& rhs);
+        friend Expression operator-(const Expression& expression);
+
+        struct Node;
+
+    private:
+        explicit Expression(std::shared_ptr<const Node> node);
+
+        std::shared_ptr<const Node> node_;
+
+        friend class ExpressionEvaluator;
+    };
+
+    // Runs expressions on a backend. Each product chain is parenthesized with the classic
+    // matrix-chain dynamic program (minimum multiply-adds). Scale factors become the GEMM's
+    // alpha, and sums accumulate into the output through beta = 1, so neither is a separate
+    // pass. Intermediates come from a pool owned by the evaluator and are reused across
+    // evaluations. Like the backends, an evaluator must not be shared between threads.
+    class ExpressionEvaluator {
+    public:
+        explicit ExpressionEvaluator(IMultiplier& multiplier);
+
+        Matrix evaluate(const Expression& expression);
+
+        // Resizes out to the result shape; out must not alias any leaf of the expression.
+        void evaluate(const Expression& expression, Matrix& out);
+
+        std::size_t pooledBuffers() const { return pool_.size(); }
+
+    private:
+        void evaluateInto(const Expression::Node& node, Matrix& out, float alpha, float beta);
+        void evaluateChain(const Expression::Node& node, Matrix& out, float alpha, float beta);
+        void evaluateRange(const std::vector<const Matrix*>& factors, const std::vector<std::size_t>& split,
+                           std::size_t i, std::size_t j, Matrix& out, float alpha, float beta);
+
+        Matrix acquire(Eigen::Index rows, Eigen::Index cols);
+        void release(Matrix&& buffer);
+
+        IMultiplier& multiplier_;
+        std::vector<Matrix> pool_;
+    };
+
+} // namespace MatrixTransform
@@ -1,13 +1,126 @@
 #pragma once
 #include "matrix_types.hpp"
+#include "epilogue.hpp"
+#include <cstddef>
+#include <functional>
+#include <future>
 #include <memory> 
+#include <vector>
 
 namespace MatrixTransform {
 
+// Right-hand operand prepared once by IMultiplier::prepare and reused across products. The
+// layout belongs to the backend that prepared it; handles are immutable, so one can be
+// shared by threads and by instances of the same backend. Other backends fall back to
+// unpack(), which rebuilds the plain matrix.
+class PackedOperand {
+public:
+    virtual ~PackedOperand() = default;
+
+    Eigen::Index rows() const { return rows_; }
+    Eigen::Index cols() const { return cols_; }
+
+    virtual Matrix unpack() const = 0;
+
+protected:
+    PackedOperand(Eigen::Index rows, Eigen::Index cols) : rows_(rows), cols_(cols) {}
+
+private:
+    Eigen::Index rows_;
+    Eigen::Index cols_;
+};
+
 class IMultiplier {
 public:
     virtual ~IMultiplier() = default; 
     virtual Matrix multiply(const Matrix& a, const Matrix& b) = 0;
+
+    // How accurate this backend's fp32 products are; Float32 unless it quantizes its
+    // operands, as INT8_AVX2 does.
+    virtual Precision precision() const;
+
+    // Reduced-precision products with fp32 results. The defaults dequantize (or widen) the
+    // operands and call the fp32 multiply; INT8_AVX2 and HALF_AVX2 run them natively.
+    // Backends that override the fp32 multiply add `using IMultiplier::multiply;` so these
+    // overloads stay visible.
+    virtual Matrix multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b);
+    virtual Matrix multiply(const MatrixBF16& a, const MatrixBF16& b);
+    virtual Matrix multiply(const MatrixF16& a, const MatrixF16& b);
+
+    // Sparse-times-dense product. The default densifies a; SPARSE and SPARSE_AUTO run it on
+    // the CSR storage directly.
+    virtual Matrix multiply(const SparseMatrix& a, const Matrix& b);
+
+    // Computes c = alpha * a * b + beta * c into a caller-provided output of size
+    // a.rows() x b.cols(); c is not read when beta == 0. Backends that own a workspace
+    // perform no heap allocation here once it has grown to the working size, which also
+    // means a single instance must not run gemm() concurrently from several threads.
+    virtual void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c);
+
+    // gemm() and multiply() on caller memory: Eigen maps, blocks and refs, or raw pointers
+    // with a leading dimension, storage order and transpose flag. The CPU backends read the
+    // operands in place and write C through its strides; the default copies into matrices.
+    virtual void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c);
+    Matrix multiply(ConstMatrixView a, ConstMatrixView b);
+
+    // Converts b, typically a weight matrix multiplied by many different a's, into this
+    // backend's preferred layout once: the blocked backends pack it into kernel panels and
+    // INT8_AVX2 quantizes and packs it, so products against the handle skip that O(k * n)
+    // work. The default keeps a copy of b. Backends that override gemm add
+    // `using IMultiplier::gemm;` so the packed overload stays visible.
+    virtual std::shared_ptr<const PackedOperand> prepare(ConstMatrixView b);
+    virtual Matrix multiply(ConstMatrixView a, const PackedOperand& b);
+    virtual void gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c);
+
+    // Computes c = activation(scale * a * b + bias) + residual as described by the epilogue
+    // (see epilogue.hpp) without further passes over c: the blocked backends, OMP_AVX2 among
+    // them, finish each strip of register tiles right after storing it, and CPU works
+    // through column panels that stay in cache. The default runs gemm and then one pass over c.
+    virtual void gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue);
+    virtual void gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue);
+    Matrix multiply(ConstMatrixView a, ConstMatrixView b, const Epilogue& epilogue);
+
+    // Structured products on views. syrk computes c = alpha * a * a^T + beta * c on one
+    // triangle of the square c and, with mirror, copies it into the other; otherwise the other
+    // triangle is left as it was. symm computes c = alpha * a * b + beta * c for a symmetric a
+    // of which only the given triangle is read, and trmm the same with a replaced by that
+    // triangle (with ones on the diagonal when unitDiagonal). Products with the structured
+    // operand on the right follow from transposed views, e.g. c^T = b^T * a^T. The defaults
+    // run a full gemm; the blocked backends compute only the needed blocks, about half the
+    // flops for syrk and trmm.
+    virtual void syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror);
+    virtual void symm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c, Triangle triangle);
+    virtual void trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                      Triangle triangle, bool unitDiagonal);
+
+    // Computes *c[i] = *a[i] * *b[i] for count independent pairs, resizing outputs as needed.
+    // Dimensions are validated once for the whole batch. Products whose dimensions are all
+    // in {4, 8, 16, 32, 64} run on unrolled fixed-size kernels in parallel across the batch.
+    // Other products too small to occupy every core (up to about 256^3) run one per thread
+    // through serialProduct() when the batch has several; the remaining pairs go through gemm().
+    virtual void multiplyBatch(const Matrix* const* a, const Matrix* const* b, Matrix* const* c, std::size_t count);
+
+    // The same on views, writing c[i] = a[i] * b[i] in place; outputs must already have the
+    // product's size.
+    virtual void multiplyBatch(const ConstMatrixView* a, const ConstMatrixView* b, const MatrixView* c, std::size_t count);
+
+    std::vector<Matrix> multiplyBatch(const std::vector<Matrix>& a, const std::vector<Matrix>& b);
+
+    // Queues a * b on the library's shared work-stealing pool and returns at once. The product
+    // is split into output tiles that interleave with the tiles of other in-flight requests;
+    // each tile runs single-threaded, so concurrent requests never oversubscribe the cores.
+    // By default tiles run through serialProduct(); backends whose arithmetic cannot be
+    // tiled that way override this. The operands are taken by value (move them in to avoid
+    // a copy). Safe to call concurrently from any thread, on any instance.
+    virtual std::future<Matrix> multiplyAsync(Matrix a, Matrix b);
+
+protected:
+    // c = a * b on the calling thread alone, with this backend's fp32 arithmetic. Batch
+    // entries and async tiles run several at once, the latter after this instance may be
+    // gone, so the function must not refer to the instance. The default uses Eigen; the
+    // blocked backends run their register kernel.
+    using SerialProduct = std::function<void(ConstMatrixView a, ConstMatrixView b, MatrixView c)>;
+    virtual SerialProduct serialProduct() const;
 };
 
-} // namespace MatrixTransform
\ No newline at end of file
+} // namespace MatrixTransform
@@ -1,3 +1,165 @@
+#pragma once
+
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cstdint>
+
+using Matrix = Eigen::MatrixXf;
+
+// Storage order of a matrix in caller memory.
+enum class StorageOrder { ColMajor, RowMajor };
+
+// Half of a square matrix referenced or written by the structured products.
+enum class Triangle { Lower, Upper };
+
+// Arithmetic behind a backend's fp32 products: single-precision accumulation, or operands
+// quantized to 8 bits before an integer product.
+enum class Precision { Float32, Int8 };
+
+// Non-owning, read-only view of a float matrix in caller memory. Element (i, j) lives at
+// data[i * rowStride + j * colStride], so column-major and row-major buffers with any leading
+// dimension, sub-blocks and transposes are all described without copying. Views convert
+// implicitly from Matrix and explicitly from Eigen maps, blocks and refs.
+class ConstMatrixView {
+public:
+    using StridedMap = Eigen::Map<const Matrix, 0, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+    // A rows x cols matrix stored with leading dimension ld in the given order; transposed
+    // views it as its cols x rows transpose.
+    ConstMatrixView(const float* data, Eigen::Index rows, Eigen::Index cols, Eigen::Index ld,
+                    StorageOrder order = StorageOrder::ColMajor, bool transposed = false)
+        : ConstMatrixView(strided(data, rows, cols,
+                                  order == StorageOrder::ColMajor ? 1 : ld,
+                                  order == StorageOrder::ColMajor ? ld : 1)) {
+        if (transposed) {
+            *this = transpose();
+        }
+    }
+
+    ConstMatrixView(const Matrix& m) : ConstMatrixView(strided(m.data(), m.rows(), m.cols(), 1, m.outerStride())) {}
+
+    template <typename Derived>
+    explicit ConstMatrixView(const Eigen::MapBase<Derived, Eigen::ReadOnlyAccessors>& m)
+        : ConstMatrixView(strided(m.data(), m.rows(), m.cols(),
+                                  Derived::IsRowMajor ? m.outerStride() : m.innerStride(),
+                                  Derived::IsRowMajor ? m.innerStride() : m.outerStride())) {}
+
+    static ConstMatrixView strided(const float* data, Eigen::Index rows, Eigen::Index cols,
+                                   Eigen::Index rowStride, Eigen::Index colStride) {
+        return ConstMatrixView(data, rows, cols, rowStride, colStride, 0);
+    }
+
+    const float* data() const { return data_; }
+    Eigen::Index rows() const { return rows_; }
+    Eigen::Index cols() const { return cols_; }
+    Eigen::Index rowStride() const { return rowStride_; }
+    Eigen::Index colStride() const { return colStride_; }
+
+    // Columns are contiguous, so data() and colStride() form a column-major (BLAS "N") operand.
+    bool isColumnMajor() const { return rowStride_ == 1; }
+
+    float operator()(Eigen::Index i, Eigen::Index j) const { return data_[i * rowStride_ + j * colStride_]; }
+
+    ConstMatrixView transpose() const { return strided(data_, cols_, rows_, colStride_, rowStride_); }
+
+    ConstMatrixView block(Eigen::Index row, Eigen::Index col, Eigen::Index rows, Eigen::Index cols) const {
+        return strided(data_ + row * rowStride_ + col * colStride_, rows, cols, rowStride_, colStride_);
+    }
+
+    StridedMap map() const { return StridedMap(data_, rows_, cols_, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(colStride_, rowStride_)); }
+
+private:
+    ConstMatrixView(const float* data, Eigen::Index rows, Eigen::Index cols, Eigen::Index rowStride,
+                    Eigen::Index colStride, int)
+        : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride), colStride_(colStride) {}
+
+    const float* data_;
+    Eigen::Index rows_;
+    Eigen::Index cols_;
+    Eigen::Index rowStride_;
+    Eigen::Index colStride_;
+};
+
+// Writable counterpart of ConstMatrixView, used for outputs.
+class MatrixView {
+public:
+    using StridedMap = Eigen::Map<Matrix, 0, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+    MatrixView(float* data, Eigen::Index rows, Eigen::Index cols, Eigen::Index ld,
+               StorageOrder order = StorageOrder::ColMajor, bool transposed = false)
+        : MatrixView(strided(data, rows, cols,
+                             order == StorageOrder::ColMajor ? 1 : ld,
+                             order == StorageOrder::ColMajor ? ld : 1)) {
+        if (transposed) {
+            *this = transpose();
+        }
+    }
+
+    MatrixView(Matrix& m) : MatrixView(strided(m.data(), m.rows(), m.cols(), 1, m.outerStride())) {}
+
+    template <typename Derived>
+    explicit MatrixView(const Eigen::MapBase<Derived, Eigen::WriteAccessors>& m)
+        : MatrixView(strided(const_cast<float*>(m.data()), m.rows(), m.cols(),
+                             Derived::IsRowMajor ? m.outerStride() : m.innerStride(),
+                             Derived::IsRowMajor ? m.innerStride() : m.outerStride())) {}
+
+    static MatrixView strided(float* data, Eigen::Index rows, Eigen::Index cols,
+                              Eigen::Index rowStride, Eigen::Index colStride) {
+        return MatrixView(data, rows, cols, rowStride, colStride, 0);
+    }
+
+    operator ConstMatrixView() const { return ConstMatrixView::strided(data_, rows_, cols_, rowStride_, colStride_); }
+
+    float* data() const { return data_; }
+    Eigen::Index rows() const { return rows_; }
+    Eigen::Index cols() const { return cols_; }
+    Eigen::Index rowStride() const { return rowStride_; }
+    Eigen::Index colStride() const { return colStride_; }
+    bool isColumnMajor() const { return rowStride_ == 1; }
+
+    float& operator()(Eigen::Index i, Eigen::Index j) const { return data_[i * rowStride_ + j * colStride_]; }
+
+    MatrixView transpose() const { return strided(data_, cols_, rows_, colStride_, rowStride_); }
+
+    MatrixView block(Eigen::Index row, Eigen::Index col, Eigen::Index rows, Eigen::Index cols) const {
+        return strided(data_ + row * rowStride_ + col * colStride_, rows, cols, rowStride_, colStride_);
+    }
+
+    StridedMap map() const { return StridedMap(data_, rows_, cols_, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(colStride_, rowStride_)); }
+
+private:
+    MatrixView(float* data, Eigen::Index rows, Eigen::Index cols, Eigen::Index rowStride,
+               Eigen::Index colStride, int)
+        : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride), colStride_(colStride) {}
+
+    float* data_;
+    Eigen::Index rows_;
+    Eigen::Index cols_;
+    Eigen::Index rowStride_;
+    Eigen::Index colStride_;
+};
+
+// Compressed sparse row storage for sparse left operands.
+using SparseMatrix = Eigen::SparseMatrix<float, Eigen::RowMajor>;
+
+// Reduced-precision storage. Products are accumulated in fp32.
+using MatrixBF16 = Eigen::Matrix<Eigen::bfloat16, Eigen::Dynamic, Eigen::Dynamic>;
+using MatrixF16 = Eigen::Matrix<Eigen::half, Eigen::Dynamic, Eigen::Dynamic>;
+
+// Affine-quantized matrix: real = scale * (q - zeroPoint).
+template <typename T>
+struct QuantizedMatrix {
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> values;
+    float scale = 1.0f;
+    std::int32_t zeroPoint = 0;
+
+    Eigen::Index rows() const { return values.rows(); }
+    Eigen::Index cols() const { return values.cols(); }
+
+    Matrix dequantize() const {
+        return scale * (values.template cast<float>().array() - static_cast<float>(zeroPoint)).matrix();
+    }
+};
 
-using Matrix = Eigen::MatrixXf;
\ No newline at end of file
+using QuantizedMatrixU8 = QuantizedMatrix<std::uint8_t>;
+using QuantizedMatrixS8 = QuantizedMatrix<std::int8_t>;
@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "interfaces.hpp"
+
+namespace MatrixTransform {
+
+    // IMultiplier entry points an instrumented backend records separately. Async records the
+    // time to submit the product, not to complete it; Reduced covers the int8/bf16/fp16 paths.
+    enum class MetricOp { Multiply, Gemm, Batch, Async, Sparse, Reduced };
+    constexpr int MetricOpCount = 6;
+
+    // Optional per-call counters read through Linux perf_event_open. TaskClock is the CPU time
+    // of all counted threads in nanoseconds; FlopEvents is a raw, CPU-specific event code.
+    enum class HardwareCounter { Cycles, Instructions, LlcMisses, FlopEvents, TaskClock };
+    constexpr int HardwareCounterCount = 5;
+
+    // Counters for one backend. Updates are lock-free apart from the shape table.
+    class BackendMetrics {
+    public:
+        // Latency bucket i counts calls of at most 2^(i + 10) ns (about 1 us up to 69 s);
+        // the last bucket is unbounded.
+        static constexpr int LatencyBuckets = 28;
+
+        struct OpCounters {
+            std::atomic<std::uint64_t> calls{0};
+            std::atomic<std::uint64_t> errors{0};
+            std::atomic<std::uint64_t> nanos{0};
+            std::atomic<std::uint64_t> flops{0};
+            std::atomic<std::uint64_t> bytesAllocated{0};
+            std::array<std::atomic<std::uint64_t>, LatencyBuckets> latency{};
+            std::array<std::atomic<std::uint64_t>, HardwareCounterCount> hardware{};
+        };
+
+        // hardware holds per-counter deltas for the call, or is null when counters are off.
+        void record(MetricOp op, std::uint64_t nanos, std::uint64_t flops, std::uint64_t bytesAllocated,
+                    const std::uint64_t* hardware);
+        void recordError(MetricOp op);
+        // Counts an (m x k) * (k x n) product, each dimension rounded up to a power of two.
+        void recordShape(Eigen::Index m, Eigen::Index n, Eigen::Index k, std::uint64_t count = 1);
+
+        const OpCounters& op(MetricOp op) const { return ops_[static_cast<int>(op)]; }
+        // Calls per rounded {m, n, k}.
+        std::map<std::array<std::uint64_t, 3>, std::uint64_t> shapes() const;
+        void reset();
+
+    private:
+        std::array<OpCounters, MetricOpCount> ops_;
+        mutable std::mutex shapeMutex_;
+        std::map<std::uint32_t, std::uint64_t> shapes_;
+    };
+
+    // Process-wide metrics, one BackendMetrics per instrumented backend name. Backends are
+    // instrumented by wrapping them (instrumentMultiplier, or "metrics": {"enabled": true} in
+    // the factory config), so uninstrumented backends pay nothing.
+    class MetricsRegistry {
+    public:
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        static MetricsRegistry& getInstance();
+
+        // Created on first use; the reference stays valid for the life of the process.
+        BackendMetrics& backend(const std::string& name);
+
+        // Opens the perf counters for the calling thread and the OpenMP team. Counters the
+        // kernel or CPU does not expose (as inside most VMs) are skipped; returns false if
+        // none could be opened. rawFlopEvent is a PERF_TYPE_RAW code, 0 to leave it out.
+        bool enableHardwareCounters(std::uint64_t rawFlopEvent = 0);
+
+        std::string toPrometheus() const;
+        std::string toJson() const;
+        // Writes JSON if path ends in ".json", Prometheus text otherwise.
+        void writeFile(const std::string& path) const;
+        void reset();
+
+    private:
+        MetricsRegistry() = default;
+        ~MetricsRegistry() = default;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::unique_ptr<BackendMetrics>> backends_;
+    };
+
+    // Wraps backend so every call is timed and recorded under name.
+    std::unique_ptr<IMultiplier> instrumentMultiplier(std::unique_ptr<IMultiplier> backend, const std::string& name);
+
+} // namespace MatrixTransform
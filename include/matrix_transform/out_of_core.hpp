@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include "interfaces.hpp"
+#include "tiled_matrix.hpp"
+
+namespace MatrixTransform {
+
+    // Streams C = A * B over tiled matrix files through any backend. C is produced one block
+    // of tiles at a time. For each block, panels of A and B are copied out of the mappings one
+    // k-tile at a time, and the next panel is loaded on a background thread while the
+    // backend runs gemm on the current one. Consumed pages are evicted right after copying,
+    // so the resident set stays within the budget: the C block, two panel buffers each for
+    // A and B, and the panel being paged in. The backend's own workspace is not counted.
+    class OutOfCoreMultiplier {
+    public:
+        OutOfCoreMultiplier(IMultiplier& backend, std::size_t memoryBudgetBytes);
+
+        // c must be writable, a.rows() x b.cols(), and all three files must share a tile size.
+        void multiply(const TiledMatrixFile& a, const TiledMatrixFile& b, TiledMatrixFile& c);
+
+    private:
+        IMultiplier& backend_;
+        std::size_t memoryBudgetBytes_;
+    };
+
+} // namespace MatrixTransform
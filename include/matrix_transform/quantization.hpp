@@ -0,0 +1,72 @@
+#pragma once
+#include "matrix_types.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace MatrixTransform {
+
+struct QuantizationParams {
+    float scale;
+    std::int32_t zeroPoint;
+};
+
+// u8 scale and zero point for values in [lo, hi]; the range is widened to include 0 so that
+// zero is exactly representable.
+inline QuantizationParams chooseU8Params(float lo, float hi, bool reduceRange = false) {
+    const float qmax = reduceRange ? 127.0f : 255.0f;
+    lo = std::min(0.0f, lo);
+    hi = std::max(0.0f, hi);
+    const float scale = hi > lo ? (hi - lo) / qmax : 1.0f;
+    return {scale, static_cast<std::int32_t>(std::clamp(std::nearbyint(-lo / scale), 0.0f, qmax))};
+}
+
+// Symmetric s8 scale for values with magnitude up to absMax.
+inline QuantizationParams chooseS8Params(float absMax) {
+    return {absMax > 0.0f ? absMax / 127.0f : 1.0f, 0};
+}
+
+// Asymmetric per-tensor quantization for activations (the left operand). With reduceRange
+// the codes are limited to [0, 127], which keeps the u8 x s8 pair sums of the AVX2 int8
+// kernel inside int16 on hosts without VNNI. The output overloads reuse q's storage. Both
+// quantizers read matrices and strided views in place.
+inline void quantizeU8(ConstMatrixView view, QuantizedMatrixU8& q, bool reduceRange = false) {
+    const ConstMatrixView::StridedMap m = view.map();
+    const float qmax = reduceRange ? 127.0f : 255.0f;
+    const QuantizationParams params = m.size() ? chooseU8Params(m.minCoeff(), m.maxCoeff(), reduceRange)
+                                               : chooseU8Params(0.0f, 0.0f, reduceRange);
+
+    q.scale = params.scale;
+    q.zeroPoint = params.zeroPoint;
+    const float inverse = 1.0f / q.scale;
+    const float zero = static_cast<float>(q.zeroPoint);
+    q.values = m.unaryExpr([=](float x) {
+        return static_cast<std::uint8_t>(std::clamp(std::nearbyint(x * inverse) + zero, 0.0f, qmax));
+    });
+}
+
+inline QuantizedMatrixU8 quantizeU8(ConstMatrixView m, bool reduceRange = false) {
+    QuantizedMatrixU8 q;
+    quantizeU8(m, q, reduceRange);
+    return q;
+}
+
+// Symmetric per-tensor quantization for weights (the right operand), codes in [-127, 127].
+inline void quantizeS8(ConstMatrixView view, QuantizedMatrixS8& q) {
+    const ConstMatrixView::StridedMap m = view.map();
+    const QuantizationParams params = chooseS8Params(m.size() ? m.cwiseAbs().maxCoeff() : 0.0f);
+
+    q.scale = params.scale;
+    q.zeroPoint = params.zeroPoint;
+    const float inverse = 1.0f / q.scale;
+    q.values = m.unaryExpr([=](float x) {
+        return static_cast<std::int8_t>(std::clamp(std::nearbyint(x * inverse), -127.0f, 127.0f));
+    });
+}
+
+inline QuantizedMatrixS8 quantizeS8(ConstMatrixView m) {
+    QuantizedMatrixS8 q;
+    quantizeS8(m, q);
+    return q;
+}
+
+} // namespace MatrixTransform
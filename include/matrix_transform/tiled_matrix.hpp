@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "matrix_types.hpp"
+
+namespace MatrixTransform {
+
+    // Memory-mapped matrix file in a simple tiled layout, for operands larger than RAM.
+    //
+    // Layout: a 4 KiB header ("MTTILE01", format version, tile size, rows, cols), then square
+    // tiles of tileSize x tileSize floats. The tiles are stored column-major in tile order
+    // (tile (ti, tj) is tile number tj * tileRowCount() + ti), and so are the elements
+    // within each tile. Edge tiles are zero padded to the full tile size, so every tile starts
+    // on a page boundary and can be multiplied without bounds checks. POSIX only.
+    class TiledMatrixFile {
+    public:
+        static constexpr Eigen::Index DefaultTileSize = 512;
+
+        // Creates (or truncates) a zero-filled file; the mapping is writable.
+        static TiledMatrixFile create(const std::string& path, Eigen::Index rows, Eigen::Index cols,
+                                      Eigen::Index tileSize = DefaultTileSize);
+        static TiledMatrixFile open(const std::string& path, bool writable = false);
+
+        // Converts an in-memory matrix to a tiled file, and back.
+        static void write(const std::string& path, const Matrix& matrix, Eigen::Index tileSize = DefaultTileSize);
+        Matrix toMatrix() const;
+
+        TiledMatrixFile(TiledMatrixFile&& other) noexcept;
+        TiledMatrixFile& operator=(TiledMatrixFile&& other) noexcept;
+        TiledMatrixFile(const TiledMatrixFile&) = delete;
+        TiledMatrixFile& operator=(const TiledMatrixFile&) = delete;
+        ~TiledMatrixFile();
+
+        Eigen::Index rows() const { return rows_; }
+        Eigen::Index cols() const { return cols_; }
+        Eigen::Index tileSize() const { return tileSize_; }
+        Eigen::Index tileRowCount() const { return (rows_ + tileSize_ - 1) / tileSize_; }
+        Eigen::Index tileColCount() const { return (cols_ + tileSize_ - 1) / tileSize_; }
+
+        // Column-major tileSize x tileSize block with leading dimension tileSize.
+        const float* tile(Eigen::Index ti, Eigen::Index tj) const;
+        float* tile(Eigen::Index ti, Eigen::Index tj);
+
+        // Paging hints for the tiles [ti, ti + tileRows) x [tj, tj + tileCols). prefetch starts
+        // asynchronous readahead; evict drops the pages from this process (dirty pages of a
+        // writable file are queued for writeback first and stay in the page cache).
+        void prefetch(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols) const;
+        void evict(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols) const;
+
+    private:
+        TiledMatrixFile() = default;
+        void map(int fd, bool writable);
+        void release();
+        std::size_t tileBytes() const { return static_cast<std::size_t>(tileSize_ * tileSize_) * sizeof(float); }
+        unsigned char* tileAddress(Eigen::Index ti, Eigen::Index tj) const;
+        void advise(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols, bool evict) const;
+
+        int fd_ = -1;
+        unsigned char* mapping_ = nullptr;
+        std::size_t mappedBytes_ = 0;
+        bool writable_ = false;
+        Eigen::Index rows_ = 0;
+        Eigen::Index cols_ = 0;
+        Eigen::Index tileSize_ = 0;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "matrix_transform/matrix_types.hpp"
+#include "matrix_transform/interfaces.hpp"
+#include "multiplier_registry.hpp"
+#include "cpu_features.hpp"
+#include "logger.hpp"
+#include "numa.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using MatrixTransform::IMultiplier;
+using MatrixTransform::MultiplierRegistry;
+
+namespace {
+
+    struct Shape {
+        std::string category;
+        Eigen::Index m;
+        Eigen::Index n;
+        Eigen::Index k;
+    };
+
+    struct Options {
+        std::vector<std::string> backends;
+        std::vector<int> threads;
+        int warmup = 2;
+        int repeats = 10;
+        bool quick = false;
+        std::string output = "matrix_bench.json";
+        std::string logLevel = "none";
+        std::string pinning = "none";
+        std::string numa = "off";
+    };
+
+    struct Stats {
+        double min;
+        double median;
+        double p90;
+        double p99;
+        double mean;
+    };
+
+    std::vector<std::string> split(const std::string& text) {
+        std::vector<std::string> parts;
+        std::stringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, ',')) {
+            if (!part.empty()) {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+
+    std::vector<Shape> benchmarkShapes(bool quick) {
+        if (quick) {
+            return {
+                {"square", 256, 256, 256},
+                {"square", 1024, 1024, 1024},
+                {"tall_skinny", 4096, 16, 1024},
+                {"gemv", 4096, 1, 4096},
+                {"small", 16, 16, 16},
+            };
+        }
+        return {
+            {"square", 128, 128, 128},
+            {"square", 512, 512, 512},
+            {"square", 1024, 1024, 1024},
+            {"square", 2048, 2048, 2048},
+            {"tall_skinny", 8192, 64, 256},
+            {"tall_skinny", 4096, 16, 4096},
+            {"tall_skinny", 16384, 4, 4096},
+            {"short_wide", 64, 8192, 256},
+            {"short_wide", 8, 16384, 4096},
+            {"gemv", 8192, 1, 8192},
+            {"gemv_t", 1, 8192, 8192},
+            {"gemv_long_k", 64, 1, 262144},
+            {"small", 8, 8, 8},
+            {"small", 16, 16, 16},
+            {"small", 32, 32, 32},
+            {"small", 64, 64, 64},
+        };
+    }
+
+    std::vector<int> defaultThreadCounts() {
+        int maxThreads = 1;
+#ifdef _OPENMP
+        maxThreads = omp_get_max_threads();
+#endif
+        std::vector<int> counts;
+        for (int t = 1; t < maxThreads; t *= 2) {
+            counts.push_back(t);
+        }
+        counts.push_back(maxThreads);
+        return counts;
+    }
+
+    void setThreads(int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+    }
+
+    // Nearest-rank percentile over sorted samples.
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+    }
+
+    Stats summarize(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (double s : samples) {
+            total += s;
+        }
+        return {samples.front(), percentile(samples, 0.5), percentile(samples, 0.9),
+                percentile(samples, 0.99), total / samples.size()};
+    }
+
+    // Relative error a correct product may show. fp32 rounding grows roughly with sqrt(k);
+    // quantizing each operand to 8 bits costs about 0.5% whatever the shape.
+    double tolerance(Precision precision, Eigen::Index k) {
+        switch (precision) {
+            case Precision::Int8:
+                return 2e-2;
+            case Precision::Float32:
+            default:
+                return 1e-5 * std::sqrt(double(k)) + 1e-6;
+        }
+    }
+
+    // Runs enough back-to-back calls that one sample covers at least ~200 microseconds, so
+    // sub-microsecond products are not lost in timer resolution. Returns seconds per call.
+    std::vector<double> timeGemm(IMultiplier& multiplier, const Matrix& a, const Matrix& b, Matrix& c,
+                                 int warmup, int repeats) {
+        using Clock = std::chrono::steady_clock;
+        for (int i = 0; i < warmup; ++i) {
+            multiplier.gemm(1.0f, a, b, 0.0f, c);
+        }
+
+        int iterations = 1;
+        for (;;) {
+            const Clock::time_point start = Clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                multiplier.gemm(1.0f, a, b, 0.0f, c);
+            }
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= 200e-6 || iterations >= (1 << 20)) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(repeats);
+        MatrixTransform::NumaStats::getInstance().reset();
+        for (int r = 0; r < repeats; ++r) {
+            const Clock::time_point start = Clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                multiplier.gemm(1.0f, a, b, 0.0f, c);
+            }
+            samples.push_back(std::chrono::duration<double>(Clock::now() - start).count() / iterations);
+        }
+        return samples;
+    }
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--backends A,B,...] [--threads 1,2,...] [--warmup N]"
+                  << " [--repeats N] [--output file.json] [--log-level level] [--quick]"
+                  << " [--pinning none|compact|spread] [--numa off|first_touch|replicate]" << std::endl;
+    }
+
+    bool parseOptions(int argc, char const* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--backends" && hasValue) {
+                options.backends = split(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                for (const std::string& t : split(argv[++i])) {
+                    options.threads.push_back(std::max(1, std::stoi(t)));
+                }
+            } else if (arg == "--warmup" && hasValue) {
+                options.warmup = std::max(0, std::stoi(argv[++i]));
+            } else if (arg == "--repeats" && hasValue) {
+                options.repeats = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--output" && hasValue) {
+                options.output = argv[++i];
+            } else if (arg == "--log-level" && hasValue) {
+                options.logLevel = argv[++i];
+            } else if (arg == "--pinning" && hasValue) {
+                options.pinning = argv[++i];
+            } else if (arg == "--numa" && hasValue) {
+                options.numa = argv[++i];
+            } else if (arg == "--quick") {
+                options.quick = true;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string timestamp() {
+        const std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        std::stringstream stream;
+        stream << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+        return stream.str();
+    }
+
+} // namespace
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        MatrixTransform::ThreadPlacement& placement = MatrixTransform::ThreadPlacement::global();
+        placement.pinning = MatrixTransform::ThreadPlacement::parsePinning(options.pinning);
+        placement.numa = MatrixTransform::ThreadPlacement::parseNuma(options.numa);
+    } catch (const std::exception&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    MatrixTransform::Logger::getInstance().setLevel(options.logLevel);
+    MatrixTransform::NumaStats::getInstance().setEnabled(true);
+    const std::size_t numaNodes = MatrixTransform::NumaTopology::get().nodes().size();
+    MultiplierRegistry& registry = MultiplierRegistry::getInstance();
+    if (options.backends.empty()) {
+        options.backends = registry.registeredKeys();
+    }
+    if (options.threads.empty()) {
+        options.threads = defaultThreadCounts();
+    }
+
+    nlohmann::json report;
+    report["meta"] = {
+        {"timestamp", timestamp()},
+        {"cpu_features", MatrixTransform::CpuFeatures::get().toString()},
+        {"warmup", options.warmup},
+        {"repeats", options.repeats},
+        {"threads", options.threads},
+        {"backends", options.backends},
+        {"numa_nodes", numaNodes},
+        {"pinning", options.pinning},
+        {"numa", options.numa},
+    };
+    report["results"] = nlohmann::json::array();
+
+    int failures = 0;
+    std::srand(42);
+    std::cout << std::left << std::setw(12) << "backend" << std::setw(13) << "shape" << std::setw(20) << "m x n x k"
+              << std::right << std::setw(8) << "threads" << std::setw(12) << "median us" << std::setw(12) << "p99 us"
+              << std::setw(10) << "GFLOP/s" << std::setw(12) << "rel error" << std::endl;
+
+    for (const Shape& shape : benchmarkShapes(options.quick)) {
+        Matrix a = Matrix::Random(shape.m, shape.k);
+        Matrix b = Matrix::Random(shape.k, shape.n);
+        Matrix c(shape.m, shape.n);
+        const Eigen::MatrixXd reference = a.cast<double>() * b.cast<double>();
+        const double referenceNorm = std::max(reference.norm(), 1e-30);
+
+        const double flops = 2.0 * shape.m * shape.n * shape.k;
+        const double bytes = sizeof(float) * (double(shape.m) * shape.k + double(shape.k) * shape.n + double(shape.m) * shape.n);
+        std::stringstream dims;
+        dims << shape.m << "x" << shape.n << "x" << shape.k;
+
+        for (const std::string& backend : options.backends) {
+            std::unique_ptr<IMultiplier> multiplier;
+            try {
+                multiplier = registry.createMultiplier(backend);
+            } catch (const std::exception& e) {
+                std::cerr << "Skipping backend " << backend << ": " << e.what() << std::endl;
+                continue;
+            }
+
+            for (int threads : options.threads) {
+                setThreads(threads);
+                nlohmann::json entry = {
+                    {"backend", backend},
+                    {"shape", shape.category},
+                    {"m", shape.m}, {"n", shape.n}, {"k", shape.k},
+                    {"threads", threads},
+                };
+
+                try {
+                    const std::vector<double> samples = timeGemm(*multiplier, a, b, c, options.warmup, options.repeats);
+                    const Stats stats = summarize(samples);
+                    const double relError = (c.cast<double>() - reference).norm() / referenceNorm;
+                    const double maxAbsError = (c.cast<double>() - reference).cwiseAbs().maxCoeff();
+                    const double allowed = tolerance(multiplier->precision(), shape.k);
+                    const bool passed = relError < allowed;
+                    failures += passed ? 0 : 1;
+
+                    entry["seconds"] = {
+                        {"min", stats.min}, {"median", stats.median}, {"p90", stats.p90},
+                        {"p99", stats.p99}, {"mean", stats.mean},
+                    };
+                    entry["samples"] = samples;
+                    entry["gflops"] = flops / stats.median / 1e9;
+                    entry["bytes_moved"] = bytes;
+                    entry["gbytes_per_second"] = bytes / stats.median / 1e9;
+                    entry["rel_error"] = relError;
+                    entry["tolerance"] = allowed;
+                    entry["max_abs_error"] = maxAbsError;
+                    entry["passed"] = passed;
+
+                    // Per-node share of the packed kernels' work during the timed runs.
+                    entry["numa_nodes"] = nlohmann::json::array();
+                    std::stringstream nodeSummary;
+                    const std::vector<MatrixTransform::NumaStats::Node> nodes = MatrixTransform::NumaStats::getInstance().snapshot();
+                    double nodeFlops = 0.0;
+                    for (const MatrixTransform::NumaStats::Node& node : nodes) {
+                        nodeFlops += node.flops;
+                    }
+                    for (const MatrixTransform::NumaStats::Node& node : nodes) {
+                        const double nodeGflops = node.busySeconds > 0.0 ? node.flops / node.busySeconds / 1e9 : 0.0;
+                        entry["numa_nodes"].push_back({
+                            {"node", node.node}, {"thread_calls", node.threadCalls},
+                            {"busy_seconds", node.busySeconds}, {"gflop", node.flops / 1e9},
+                            {"gflops_per_busy_thread", nodeGflops},
+                        });
+                        nodeSummary << "  node" << node.node << " " << std::fixed << std::setprecision(1)
+                                    << 100.0 * node.flops / nodeFlops << "% of flops at "
+                                    << nodeGflops << " GFLOP/s per thread";
+                    }
+
+                    std::cout << std::left << std::setw(12) << backend << std::setw(13) << shape.category
+                              << std::setw(20) << dims.str() << std::right << std::setw(8) << threads
+                              << std::setw(12) << std::fixed << std::setprecision(2) << stats.median * 1e6
+                              << std::setw(12) << stats.p99 * 1e6 << std::setw(10) << flops / stats.median / 1e9
+                              << std::setw(12) << std::scientific << std::setprecision(1) << relError
+                              << (passed ? "" : "  FAILED") << std::defaultfloat << std::endl;
+                    if (numaNodes > 1 && entry["numa_nodes"].size() > 0) {
+                        std::cout << nodeSummary.str() << std::defaultfloat << std::endl;
+                    }
+                } catch (const std::exception& e) {
+                    ++failures;
+                    entry["error"] = e.what();
+                    std::cerr << "Backend " << backend << " failed on " << dims.str() << ": " << e.what() << std::endl;
+                }
+                report["results"].push_back(entry);
+            }
+        }
+    }
+
+    std::ofstream output(options.output);
+    if (!output.is_open()) {
+        std::cerr << "Could not open output file: " << options.output << std::endl;
+        return 1;
+    }
+    output << report.dump(2) << std::endl;
+    std::cout << "Results written to " << options.output << std::endl;
+
+    if (failures > 0) {
+        std::cerr << failures << " run(s) failed or exceeded their error tolerance." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "nlohmann/json.hpp"
+#include "matrix_transform/matrix_types.hpp"
+#include "serve_protocol.hpp"
+
+// Load generator for matrix_app in server mode. Closed-loop clients, each with its own
+// connection and shared buffer, keep a fixed number of requests in flight; the concurrency
+// is stepped through --clients to trace throughput against tail latency.
+
+namespace ServeProtocol = MatrixTransform::ServeProtocol;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string socketPath = "/tmp/matrix_app.sock";
+        Eigen::Index m = 64, n = 64, k = 64;
+        std::vector<int> clients = {1, 2, 4, 8, 16, 32};
+        int pipeline = 1;
+        double seconds = 2.0;
+        double warmupSeconds = 0.5;
+        std::string output;
+    };
+
+    struct ClientResult {
+        std::vector<double> latencies;
+        std::uint64_t batched = 0;
+        std::uint64_t failures = 0;
+        double maxError = 0.0;
+        std::string error;
+    };
+
+    std::vector<std::string> split(const std::string& text, char separator) {
+        std::vector<std::string> parts;
+        std::stringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, separator)) {
+            if (!part.empty()) {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+
+    // Nearest-rank percentile over sorted samples.
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+    }
+
+    int connectTo(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        const int socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (socket >= 0 && connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(socket);
+            return -1;
+        }
+        return socket;
+    }
+
+    // One closed-loop client. Each in-flight request owns a slot of the buffer holding its A, B
+    // and C, and request ids encode the slot. Replies that arrive before measureFrom are not
+    // recorded.
+    void runClient(const Options& options, int index, Clock::time_point measureFrom, Clock::time_point stopAt,
+                   ClientResult& result) {
+        const std::size_t aCount = options.m * options.k, bCount = options.k * options.n, cCount = options.m * options.n;
+        const std::size_t slotBytes = sizeof(float) * (aCount + bCount + cCount);
+        const std::size_t bytes = slotBytes * options.pipeline;
+
+        const int socket = connectTo(options.socketPath);
+        if (socket < 0) {
+            result.error = "cannot connect to " + options.socketPath + ": " + std::strerror(errno);
+            return;
+        }
+        const int fd = memfd_create("matrix_loadgen", MFD_CLOEXEC);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            result.error = std::string("memfd: ") + std::strerror(errno);
+            close(socket);
+            return;
+        }
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            result.error = std::string("mmap: ") + std::strerror(errno);
+            close(fd);
+            close(socket);
+            return;
+        }
+        char* base = static_cast<char*>(mapping);
+
+        std::srand(index + 1);
+        for (int s = 0; s < options.pipeline; ++s) {
+            float* slot = reinterpret_cast<float*>(base + s * slotBytes);
+            Eigen::Map<Matrix>(slot, options.m, options.k).setRandom();
+            Eigen::Map<Matrix>(slot + aCount, options.k, options.n).setRandom();
+        }
+
+        ServeProtocol::Request attach{};
+        attach.version = ServeProtocol::Version;
+        attach.op = ServeProtocol::Op::Attach;
+        attach.bufferBytes = bytes;
+        ServeProtocol::Reply reply{};
+        if (!ServeProtocol::sendWithDescriptor(socket, attach, fd) || !ServeProtocol::receive(socket, reply) || reply.status != 0) {
+            result.error = std::string("attach failed: ") + reply.message;
+        }
+        close(fd);
+
+        std::vector<Clock::time_point> sent(options.pipeline);
+        std::vector<bool> checked(options.pipeline, false);
+        std::uint64_t sequence = 0;
+        auto submit = [&](std::size_t s) {
+            ServeProtocol::Request request{};
+            request.version = ServeProtocol::Version;
+            request.op = ServeProtocol::Op::Multiply;
+            request.id = sequence++ * options.pipeline + s;
+            request.m = options.m;
+            request.n = options.n;
+            request.k = options.k;
+            request.aOffset = s * slotBytes;
+            request.bOffset = request.aOffset + sizeof(float) * aCount;
+            request.cOffset = request.bOffset + sizeof(float) * bCount;
+            sent[s] = Clock::now();
+            return ServeProtocol::send(socket, request);
+        };
+
+        int inFlight = 0;
+        if (result.error.empty()) {
+            while (inFlight < options.pipeline && submit(inFlight)) {
+                ++inFlight;
+            }
+        }
+        while (inFlight > 0 && ServeProtocol::receive(socket, reply)) {
+            --inFlight;
+            const Clock::time_point now = Clock::now();
+            const std::size_t s = reply.id % options.pipeline;
+            if (reply.status != 0) {
+                ++result.failures;
+                if (result.error.empty()) {
+                    result.error = reply.message;
+                }
+            } else if (now >= measureFrom) {
+                result.latencies.push_back(std::chrono::duration<double>(now - sent[s]).count());
+                result.batched += reply.batchSize;
+            }
+            // The first result of every slot is checked against Eigen.
+            if (!checked[s] && reply.status == 0) {
+                const float* slot = reinterpret_cast<const float*>(base + s * slotBytes);
+                const Matrix reference = Eigen::Map<const Matrix>(slot, options.m, options.k) *
+                                         Eigen::Map<const Matrix>(slot + aCount, options.k, options.n);
+                const Eigen::Map<const Matrix> c(slot + aCount + bCount, options.m, options.n);
+                result.maxError = std::max<double>(result.maxError, (c - reference).cwiseAbs().maxCoeff() /
+                                                                    std::max(1e-30f, reference.cwiseAbs().maxCoeff()));
+                checked[s] = true;
+            }
+            if (now < stopAt && submit(s)) {
+                ++inFlight;
+            }
+        }
+
+        munmap(mapping, bytes);
+        close(socket);
+    }
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--socket path] [--shape MxNxK] [--clients 1,2,4,...]"
+                  << " [--pipeline N] [--seconds S] [--warmup S] [--output file.json]" << std::endl;
+        std::cerr << "Start the server with a config containing \"server\": {\"socket\": path}." << std::endl;
+    }
+
+    bool parseOptions(int argc, char const* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--socket" && hasValue) {
+                options.socketPath = argv[++i];
+            } else if (arg == "--shape" && hasValue) {
+                const std::vector<std::string> dims = split(argv[++i], 'x');
+                if (dims.size() != 3) {
+                    return false;
+                }
+                options.m = std::max(1, std::stoi(dims[0]));
+                options.n = std::max(1, std::stoi(dims[1]));
+                options.k = std::max(1, std::stoi(dims[2]));
+            } else if (arg == "--clients" && hasValue) {
+                options.clients.clear();
+                for (const std::string& c : split(argv[++i], ',')) {
+                    options.clients.push_back(std::max(1, std::stoi(c)));
+                }
+            } else if (arg == "--pipeline" && hasValue) {
+                options.pipeline = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--seconds" && hasValue) {
+                options.seconds = std::max(0.1, std::stod(argv[++i]));
+            } else if (arg == "--warmup" && hasValue) {
+                options.warmupSeconds = std::max(0.0, std::stod(argv[++i]));
+            } else if (arg == "--output" && hasValue) {
+                options.output = argv[++i];
+            } else {
+                return false;
+            }
+        }
+        return !options.clients.empty();
+    }
+
+} // namespace
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const double flops = 2.0 * options.m * options.n * options.k;
+    nlohmann::json report;
+    report["meta"] = {
+        {"socket", options.socketPath},
+        {"m", options.m}, {"n", options.n}, {"k", options.k},
+        {"pipeline", options.pipeline},
+        {"seconds", options.seconds},
+    };
+    report["results"] = nlohmann::json::array();
+
+    std::cout << std::right << std::setw(8) << "clients" << std::setw(12) << "req/s" << std::setw(10) << "GFLOP/s"
+              << std::setw(11) << "avg batch" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us"
+              << std::setw(12) << "rel error" << std::endl;
+
+    int status = 0;
+    for (int clientCount : options.clients) {
+        std::vector<ClientResult> results(clientCount);
+        std::vector<std::thread> threads;
+        const Clock::time_point measureFrom = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.warmupSeconds));
+        const Clock::time_point stopAt = measureFrom + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+        for (int c = 0; c < clientCount; ++c) {
+            threads.emplace_back(runClient, std::cref(options), c, measureFrom, stopAt, std::ref(results[c]));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<double> latencies;
+        std::uint64_t batched = 0, failures = 0;
+        double maxError = 0.0;
+        for (const ClientResult& result : results) {
+            if (!result.error.empty()) {
+                std::cerr << "Client error: " << result.error << std::endl;
+                status = 1;
+            }
+            latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+            batched += result.batched;
+            failures += result.failures;
+            maxError = std::max(maxError, result.maxError);
+        }
+        if (latencies.empty()) {
+            std::cerr << "No replies at " << clientCount << " clients." << std::endl;
+            status = 1;
+            break;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const double throughput = latencies.size() / options.seconds;
+        const double averageBatch = static_cast<double>(batched) / latencies.size();
+        const double p50 = percentile(latencies, 0.5), p99 = percentile(latencies, 0.99);
+
+        std::cout << std::right << std::setw(8) << clientCount << std::fixed << std::setprecision(0)
+                  << std::setw(12) << throughput << std::setprecision(2) << std::setw(10) << throughput * flops / 1e9
+                  << std::setprecision(1) << std::setw(11) << averageBatch << std::setprecision(0)
+                  << std::setw(10) << p50 * 1e6 << std::setw(10) << p99 * 1e6
+                  << std::scientific << std::setprecision(2) << std::setw(12) << maxError << std::defaultfloat << std::endl;
+
+        report["results"].push_back({
+            {"clients", clientCount},
+            {"requests", latencies.size()},
+            {"failures", failures},
+            {"requests_per_second", throughput},
+            {"gflops", throughput * flops / 1e9},
+            {"average_batch", averageBatch},
+            {"latency_seconds", {{"p50", p50}, {"p90", percentile(latencies, 0.9)}, {"p99", p99}, {"max", latencies.back()}}},
+            {"max_rel_error", maxError},
+        });
+    }
+
+    if (!options.output.empty()) {
+        std::ofstream file(options.output);
+        file << report.dump(2) << std::endl;
+        std::cout << "Results written to " << options.output << std::endl;
+    }
+    return status;
+}
@@ -0,0 +1,367 @@
+#include "blocked_gemm.hpp"
+#include "microkernels.hpp"
+#include "epilogue_tile.hpp"
+#include "workspace.hpp"
+#include "cpu_features.hpp"
+#include <Eigen/Core>
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index MaxTile = 32 * 16;
+
+        Index roundUp(Index value, Index multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        // Packs the mb x kb block of A at (ic, pc) into row panels of mr, zero padding the last one.
+        // Reduced-precision inputs are widened to fp32 here, so the kernels only ever see floats.
+        template <typename T>
+        void packA(Index mr, Index mb, Index kb, const T* a, Index rsA, Index csA, float* dst) {
+            for (Index ir = 0; ir < mb; ir += mr) {
+                const Index rows = std::min(mr, mb - ir);
+                const T* src = a + ir * rsA;
+                for (Index p = 0; p < kb; ++p) {
+                    const T* col = src + p * csA;
+                    if constexpr (std::is_same_v<T, float>) {
+                        if (rsA == 1) {
+                            std::copy(col, col + rows, dst);
+                        } else {
+                            for (Index i = 0; i < rows; ++i) {
+                                dst[i] = col[i * rsA];
+                            }
+                        }
+                    } else {
+                        for (Index i = 0; i < rows; ++i) {
+                            dst[i] = static_cast<float>(col[i * rsA]);
+                        }
+                    }
+                    std::fill(dst + rows, dst + mr, 0.0f);
+                    dst += mr;
+                }
+            }
+        }
+
+        void scaleC(Index m, Index n, float beta, float* c, Index ldc) {
+            for (Index j = 0; j < n; ++j) {
+                float* cj = c + j * ldc;
+                if (beta == 0.0f) {
+                    std::fill(cj, cj + m, 0.0f);
+                } else {
+                    for (Index i = 0; i < m; ++i) {
+                        cj[i] *= beta;
+                    }
+                }
+            }
+        }
+
+        // Packs one kb x nr sliver of B into a column panel, zero padding missing columns.
+        template <typename T>
+        void packBPanel(Index nr, Index cols, Index kb, const T* b, Index rsB, Index csB, float* dst) {
+            for (Index p = 0; p < kb; ++p) {
+                const T* row = b + p * rsB;
+                for (Index j = 0; j < cols; ++j) {
+                    dst[j] = static_cast<float>(row[j * csB]);
+                }
+                std::fill(dst + cols, dst + nr, 0.0f);
+                dst += nr;
+            }
+        }
+
+        // Runs the register kernel over every mr x nr tile of an mb x nb block of C.
+        // Edge tiles are computed into a local buffer and merged.
+        // With an epilogue (on the last KC block), each mb x nr column strip of C is finished as
+        // soon as its tiles are stored, while it is still in L1. row and col locate c in the
+        // full output.
+        void macroKernel(const MicroKernel& kernel, Index mb, Index nb, Index kb, float alpha,
+                         const float* aPack, const float* bPack, float beta, float* c, Index ldc,
+                         const Epilogue* epilogue, Index row, Index col) {
+            alignas(64) float tile[MaxTile];
+            for (Index jr = 0; jr < nb; jr += kernel.nr) {
+                const Index cols = std::min(kernel.nr, nb - jr);
+                const float* bPanel = bPack + jr * kb;
+                if (epilogue != nullptr) {
+                    prefetchEpilogue(*epilogue, row, col + jr, mb, cols);
+                }
+                for (Index ir = 0; ir < mb; ir += kernel.mr) {
+                    const Index rows = std::min(kernel.mr, mb - ir);
+                    const float* aPanel = aPack + ir * kb;
+                    float* cTile = c + ir + jr * ldc;
+                    if (rows == kernel.mr && cols == kernel.nr) {
+                        kernel.compute(kb, alpha, aPanel, bPanel, beta, cTile, ldc);
+                        continue;
+                    }
+                    kernel.compute(kb, alpha, aPanel, bPanel, 0.0f, tile, kernel.mr);
+                    for (Index j = 0; j < cols; ++j) {
+                        for (Index i = 0; i < rows; ++i) {
+                            float& out = cTile[i + j * ldc];
+                            out = tile[i + j * kernel.mr] + (beta == 0.0f ? 0.0f : beta * out);
+                        }
+                    }
+                }
+                if (epilogue != nullptr) {
+                    applyEpilogue(*epilogue, row, col + jr, mb, cols, c + jr * ldc, ldc);
+                }
+            }
+        }
+    }
+
+    const MicroKernel& scalarMicroKernel() {
+        static const MicroKernel kernel{"SCALAR_8x4", 8, 4, 128, 256, 2048, &scalarKernel8x4};
+        return kernel;
+    }
+
+#ifdef WITH_X86_KERNELS
+    const MicroKernel& avx2MicroKernel() {
+        static const MicroKernel kernel{"AVX2_FMA_16x6", 16, 6, 128, 256, 3072, &avx2Kernel16x6};
+        return kernel;
+    }
+
+    const MicroKernel& avx512MicroKernel() {
+        static const MicroKernel kernel{"AVX512F_32x12", 32, 12, 128, 384, 3072, &avx512Kernel32x12};
+        return kernel;
+    }
+#endif
+
+    const MicroKernel& selectMicroKernel() {
+#ifdef WITH_X86_KERNELS
+        const CpuFeatures& features = CpuFeatures::get();
+        if (features.avx512f) {
+            return avx512MicroKernel();
+        }
+        if (features.avx2 && features.fma) {
+            return avx2MicroKernel();
+        }
+#endif
+        return scalarMicroKernel();
+    }
+
+    const TeamLayout* teamLayout(const ThreadPlacement& placement, int threads) {
+        if (threads <= 1 || (placement.pinning == PinPolicy::None && placement.numa == NumaMode::Off)) {
+            return nullptr;
+        }
+#ifdef _OPENMP
+        if (omp_in_parallel()) {
+            return nullptr;
+        }
+#endif
+        const PinPolicy pinning = placement.pinning == PinPolicy::None ? PinPolicy::Compact : placement.pinning;
+        return &NumaTopology::get().layout(pinning, threads);
+    }
+
+    namespace {
+        // Shared driver: packs B per KC x NC block, or reads the blocks from bPacked when it
+        // was laid out by packB.
+        template <typename TA, typename TB>
+        void runBlockedGemm(const MicroKernel& kernel, Index m, Index n, Index k,
+                            float alpha, const TA* a, Index rsA, Index csA,
+                            const TB* b, Index rsB, Index csB, const float* bPacked,
+                            float beta, float* c, Index ldc, Workspace& workspace, int threads,
+                            const ThreadPlacement& placement, const Epilogue* epilogue) {
+            if (m == 0 || n == 0) {
+                return;
+            }
+            if (k == 0 || alpha == 0.0f) {
+                scaleC(m, n, beta, c, ldc);
+                if (epilogue != nullptr) {
+                    applyEpilogue(*epilogue, 0, 0, m, n, c, ldc);
+                }
+                return;
+            }
+
+#ifdef _OPENMP
+            if (threads <= 0) {
+                threads = omp_get_max_threads();
+            }
+#else
+            threads = 1;
+#endif
+            // Shrink MC so that every thread gets at least one row block of A.
+            const Index mc = std::max(kernel.mr, std::min(kernel.mc, roundUp((m + threads - 1) / threads, kernel.mr)));
+            const Index kc = std::min(kernel.kc, k);
+            const Index nc = std::min(kernel.nc, roundUp(n, kernel.nr));
+
+            const TeamLayout* layout = teamLayout(placement, threads);
+            // A prepacked B is shared read-only by every thread and needs no panel slots.
+            const int replicas = bPacked != nullptr ? 0
+                               : layout != nullptr && placement.numa == NumaMode::Replicate
+                                     ? static_cast<int>(layout->replicaSize.size()) : 1;
+            NumaStats& stats = NumaStats::getInstance();
+            const bool timed = stats.enabled();
+
+            // Slots 0..replicas-1 hold the B panel (one per NUMA node when replicating), the next
+            // `threads` slots the per-thread A blocks. Every buffer is first written by a thread
+            // that reads it, so its pages land on that thread's node.
+            for (int r = 0; r < replicas; ++r) {
+                workspace.acquire(r, static_cast<std::size_t>(kc * nc));
+            }
+            for (int t = 0; t < threads; ++t) {
+                workspace.acquire(replicas + t, static_cast<std::size_t>(mc * kc));
+            }
+
+            #pragma omp parallel num_threads(threads)
+            {
+                int tid = 0;
+                int team = 1;
+#ifdef _OPENMP
+                tid = omp_get_thread_num();
+                team = omp_get_num_threads();
+#endif
+                // The runtime may grant fewer threads than requested (thread limits, nesting);
+                // the layout then no longer matches the team, so every thread shares replica 0.
+                const TeamLayout* teamPlacement = team == threads ? layout : nullptr;
+                const bool replicate = replicas > 1 && teamPlacement != nullptr;
+                if (teamPlacement != nullptr) {
+                    pinCurrentThread(teamPlacement->cpu[tid]);
+                } else if (threads > 1 && placement.pinning == PinPolicy::None && placement.numa == NumaMode::Off) {
+                    pinCurrentThread(-1);
+                }
+                const int replica = replicate ? teamPlacement->replica[tid] : 0;
+                float* bPanel = bPacked == nullptr ? workspace.data(replica) : nullptr;
+                float* aPack = workspace.data(replicas + tid);
+
+                using Clock = std::chrono::steady_clock;
+                Clock::duration busy{};
+                double flops = 0.0;
+
+                for (Index jc = 0; jc < n; jc += nc) {
+                    const Index nb = std::min(nc, n - jc);
+                    for (Index pc = 0; pc < k; pc += kc) {
+                        const Index kb = std::min(kc, k - pc);
+                        const float betaBlock = pc == 0 ? beta : 1.0f;
+                        const Epilogue* finish = pc + kb == k ? epilogue : nullptr;
+                        const float* bPack = bPanel;
+
+                        if (bPacked != nullptr) {
+                            bPack = bPacked + jc * k + roundUp(nb, kernel.nr) * pc;
+                        } else if (replicate) {
+                            // Each node's threads pack their own copy of the panel.
+                            const Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+                            const Index panels = (nb + kernel.nr - 1) / kernel.nr;
+                            for (Index p = teamPlacement->replicaRank[tid]; p < panels; p += teamPlacement->replicaSize[replica]) {
+                                const Index jr = p * kernel.nr;
+                                packBPanel(kernel.nr, std::min(kernel.nr, nb - jr), kb,
+                                           b + pc * rsB + (jc + jr) * csB, rsB, csB, bPanel + jr * kb);
+                            }
+                            if (timed) {
+                                busy += Clock::now() - start;
+                            }
+                            #pragma omp barrier
+                        } else {
+                            #pragma omp for schedule(static)
+                            for (Index jr = 0; jr < nb; jr += kernel.nr) {
+                                const Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+                                packBPanel(kernel.nr, std::min(kernel.nr, nb - jr), kb,
+                                           b + pc * rsB + (jc + jr) * csB, rsB, csB, bPanel + jr * kb);
+                                if (timed) {
+                                    busy += Clock::now() - start;
+                                }
+                            }
+                        }
+
+                        #pragma omp for schedule(dynamic)
+                        for (Index ic = 0; ic < m; ic += mc) {
+                            const Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+                            const Index mb = std::min(mc, m - ic);
+                            packA(kernel.mr, mb, kb, a + ic * rsA + pc * csA, rsA, csA, aPack);
+                            macroKernel(kernel, mb, nb, kb, alpha, aPack, bPack, betaBlock, c + ic + jc * ldc, ldc,
+                                        finish, ic, jc);
+                            if (timed) {
+                                busy += Clock::now() - start;
+                                flops += 2.0 * mb * nb * kb;
+                            }
+                        }
+                    }
+                }
+
+                if (timed) {
+                    const int node = teamPlacement != nullptr ? teamPlacement->node[tid] : NumaTopology::get().currentNode();
+                    stats.record(node, std::chrono::duration<double>(busy).count(), flops);
+                }
+            }
+        }
+    }
+
+    template <typename TA, typename TB>
+    void blockedGemm(const MicroKernel& kernel, Index m, Index n, Index k,
+                     float alpha, const TA* a, Index rsA, Index csA,
+                     const TB* b, Index rsB, Index csB,
+                     float beta, float* c, Index ldc, Workspace& workspace, int threads,
+                     const ThreadPlacement& placement, const Epilogue* epilogue) {
+        runBlockedGemm(kernel, m, n, k, alpha, a, rsA, csA, b, rsB, csB, nullptr,
+                       beta, c, ldc, workspace, threads, placement, epilogue);
+    }
+
+    std::size_t packedBSize(const MicroKernel& kernel, Index k, Index n) {
+        return static_cast<std::size_t>(roundUp(n, kernel.nr) * k);
+    }
+
+    // Block (jc, pc) starts at jc * k + roundUp(nb, nr) * pc: every earlier column block is a
+    // full NC wide, and NC is a multiple of NR.
+    void packB(const MicroKernel& kernel, Index k, Index n, const float* b, Index rsB, Index csB, float* dst) {
+        const Index kc = std::min(kernel.kc, k);
+        const Index nc = std::min(kernel.nc, roundUp(n, kernel.nr));
+        for (Index jc = 0; jc < n; jc += nc) {
+            const Index nb = std::min(nc, n - jc);
+            for (Index pc = 0; pc < k; pc += kc) {
+                const Index kb = std::min(kc, k - pc);
+                float* block = dst + jc * k + roundUp(nb, kernel.nr) * pc;
+                #pragma omp parallel for schedule(static)
+                for (Index jr = 0; jr < nb; jr += kernel.nr) {
+                    packBPanel(kernel.nr, std::min(kernel.nr, nb - jr), kb,
+                               b + pc * rsB + (jc + jr) * csB, rsB, csB, block + jr * kb);
+                }
+            }
+        }
+    }
+
+    void unpackB(const MicroKernel& kernel, Index k, Index n, const float* packed, float* b, Index ldb) {
+        const Index kc = std::min(kernel.kc, k);
+        const Index nc = std::min(kernel.nc, roundUp(n, kernel.nr));
+        for (Index jc = 0; jc < n; jc += nc) {
+            const Index nb = std::min(nc, n - jc);
+            for (Index pc = 0; pc < k; pc += kc) {
+                const Index kb = std::min(kc, k - pc);
+                const float* block = packed + jc * k + roundUp(nb, kernel.nr) * pc;
+                for (Index jr = 0; jr < nb; jr += kernel.nr) {
+                    const float* panel = block + jr * kb;
+                    for (Index j = 0; j < std::min(kernel.nr, nb - jr); ++j) {
+                        for (Index p = 0; p < kb; ++p) {
+                            b[(pc + p) + (jc + jr + j) * ldb] = panel[p * kernel.nr + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void blockedGemmPacked(const MicroKernel& kernel, Index m, Index n, Index k,
+                           float alpha, const float* a, Index rsA, Index csA, const float* bPacked,
+                           float beta, float* c, Index ldc, Workspace& workspace, int threads,
+                           const ThreadPlacement& placement, const Epilogue* epilogue) {
+        runBlockedGemm<float, float>(kernel, m, n, k, alpha, a, rsA, csA, nullptr, 0, 0, bPacked,
+                                     beta, c, ldc, workspace, threads, placement, epilogue);
+    }
+
+    template void blockedGemm<float, float>(const MicroKernel&, Index, Index, Index, float,
+                                            const float*, Index, Index, const float*, Index, Index,
+                                            float, float*, Index, Workspace&, int, const ThreadPlacement&, const Epilogue*);
+    template void blockedGemm<Eigen::bfloat16, Eigen::bfloat16>(const MicroKernel&, Index, Index, Index, float,
+                                                                const Eigen::bfloat16*, Index, Index,
+                                                                const Eigen::bfloat16*, Index, Index,
+                                                                float, float*, Index, Workspace&, int, const ThreadPlacement&, const Epilogue*);
+    template void blockedGemm<Eigen::half, Eigen::half>(const MicroKernel&, Index, Index, Index, float,
+                                                        const Eigen::half*, Index, Index,
+                                                        const Eigen::half*, Index, Index,
+                                                        float, float*, Index, Workspace&, int, const ThreadPlacement&, const Epilogue*);
+
+} // namespace Kernels
+} // namespace MatrixTransform
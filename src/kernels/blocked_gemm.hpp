@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include "numa.hpp"
+
+namespace MatrixTransform {
+
+class Workspace;
+struct Epilogue;
+
+namespace Kernels {
+
+    using Index = std::ptrdiff_t;
+
+    // Computes one mr x nr register tile: C = alpha * A_panel * B_panel + beta * C.
+    // A_panel stores kc columns of mr packed rows, B_panel stores kc rows of nr packed columns.
+    // C is column-major with leading dimension ldc and is not read when beta == 0.
+    using MicroKernelFn = void (*)(Index kc, float alpha, const float* a, const float* b,
+                                   float beta, float* c, Index ldc);
+
+    struct MicroKernel {
+        const char* name;
+        Index mr;
+        Index nr;
+        Index mc;
+        Index kc;
+        Index nc;
+        MicroKernelFn compute;
+    };
+
+    // Portable 8x4 kernel, available on every build and host.
+    const MicroKernel& scalarMicroKernel();
+
+#ifdef WITH_X86_KERNELS
+    // Descriptor for the 16x6 AVX2+FMA kernel. Blocking: an MC x KC panel of A (128 KiB)
+    // stays in L2, a KC x NR sliver of B in L1 and the KC x NC panel of B (3 MiB) in L3.
+    const MicroKernel& avx2MicroKernel();
+
+    // 32x12 AVX-512F kernel, blocked for the 1 MiB L2 of Skylake-SP class cores.
+    const MicroKernel& avx512MicroKernel();
+#endif
+
+    // Fastest kernel supported by the running CPU.
+    const MicroKernel& selectMicroKernel();
+
+    // GotoBLAS-style blocked GEMM: C = alpha * A * B + beta * C.
+    // A (m x k) and B (k x n) are addressed through row/column strides, so column-major,
+    // row-major and transposed operands are all packed without an intermediate copy.
+    // C (m x n) is column-major with leading dimension ldc and is not read when beta == 0.
+    // Packing buffers come from the workspace and are reused across calls. threads == 0 uses
+    // the OpenMP default team size. placement pins a top-level team and decides whether the
+    // packed B panel is shared or replicated per NUMA node; nested calls are never pinned.
+    // Instantiated for float, Eigen::bfloat16 and Eigen::half operands; reduced-precision
+    // operands are widened while packing and accumulated in fp32. An epilogue's bias,
+    // activation and residual are applied to each column strip of tiles as its last KC
+    // block is stored; its scale is not applied (pass it as alpha).
+    template <typename TA, typename TB>
+    void blockedGemm(const MicroKernel& kernel, Index m, Index n, Index k,
+                     float alpha, const TA* a, Index rsA, Index csA,
+                     const TB* b, Index rsB, Index csB,
+                     float beta, float* c, Index ldc, Workspace& workspace, int threads = 0,
+                     const ThreadPlacement& placement = ThreadPlacement(), const Epilogue* epilogue = nullptr);
+
+    // B (k x n) packed once for reuse: every KC x NC block in the panel layout blockedGemm
+    // builds per call, stored back to back. The layout depends on the kernel's nr, kc and nc.
+    std::size_t packedBSize(const MicroKernel& kernel, Index k, Index n);
+    void packB(const MicroKernel& kernel, Index k, Index n, const float* b, Index rsB, Index csB, float* dst);
+    // Inverse of packB into a column-major k x n matrix with leading dimension ldb.
+    void unpackB(const MicroKernel& kernel, Index k, Index n, const float* packed, float* b, Index ldb);
+
+    // blockedGemm with B already packed by packB for the same kernel; only A is packed per call.
+    void blockedGemmPacked(const MicroKernel& kernel, Index m, Index n, Index k,
+                           float alpha, const float* a, Index rsA, Index csA, const float* bPacked,
+                           float beta, float* c, Index ldc, Workspace& workspace, int threads = 0,
+                           const ThreadPlacement& placement = ThreadPlacement(), const Epilogue* epilogue = nullptr);
+
+    // Layout for a team that should be pinned under placement, or nullptr when the team is
+    // nested, single-threaded or placement asks for nothing. NUMA modes imply compact pinning.
+    const TeamLayout* teamLayout(const ThreadPlacement& placement, int threads);
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,93 @@
+#include "epilogue_tile.hpp"
+#include <Eigen/Core>
+#include <algorithm>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // Bias, activation and a contiguous residual in one vectorizable pass per column.
+        // GELU runs on Eigen's vectorized tanh as a separate pass over the column, which is
+        // still in L1.
+        template <Activation Act, bool RowBias, bool Residual>
+        void finishTile(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols, float* c, Index ldc) {
+            const float* rowBias = RowBias ? epilogue.bias + row : nullptr;
+            const ConstMatrixView* residual = Residual ? &*epilogue.residual : nullptr;
+            for (Index j = 0; j < cols; ++j) {
+                float* __restrict cj = c + j * ldc;
+                const float columnBias = !RowBias && epilogue.bias != nullptr ? epilogue.bias[col + j] : 0.0f;
+                const float* __restrict rj = Residual ? residual->data() + row + (col + j) * residual->colStride() : nullptr;
+                for (Index i = 0; i < rows; ++i) {
+                    float x = cj[i] + (RowBias ? rowBias[i] : columnBias);
+                    if constexpr (Act == Activation::ReLU) {
+                        x = std::max(x, 0.0f);
+                    }
+                    if constexpr (Residual && Act != Activation::GELU) {
+                        x += rj[i];
+                    }
+                    cj[i] = x;
+                }
+                if constexpr (Act == Activation::GELU) {
+                    Eigen::Map<Eigen::ArrayXf> x(cj, rows);
+                    x = 0.5f * x * (1.0f + (0.7978845608f * (x + 0.044715f * x.cube())).tanh());
+                    if constexpr (Residual) {
+                        x += Eigen::Map<const Eigen::ArrayXf>(rj, rows);
+                    }
+                }
+            }
+        }
+
+        template <Activation Act>
+        void finishTile(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols, float* c, Index ldc) {
+            const bool rowBias = epilogue.bias != nullptr && epilogue.biasPerRow;
+            if (epilogue.residual && epilogue.residual->rowStride() != 1) {
+                // Residuals with strided columns are added in a separate pass.
+                Epilogue rest = epilogue;
+                rest.residual.reset();
+                finishTile<Act>(rest, row, col, rows, cols, c, ldc);
+                Eigen::Map<Eigen::MatrixXf, 0, Eigen::OuterStride<>>(c, rows, cols, Eigen::OuterStride<>(ldc)) +=
+                    epilogue.residual->block(row, col, rows, cols).map();
+            } else if (epilogue.residual && rowBias) {
+                finishTile<Act, true, true>(epilogue, row, col, rows, cols, c, ldc);
+            } else if (epilogue.residual) {
+                finishTile<Act, false, true>(epilogue, row, col, rows, cols, c, ldc);
+            } else if (rowBias) {
+                finishTile<Act, true, false>(epilogue, row, col, rows, cols, c, ldc);
+            } else {
+                finishTile<Act, false, false>(epilogue, row, col, rows, cols, c, ldc);
+            }
+        }
+    }
+
+    void prefetchEpilogue(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols) {
+        if (!epilogue.residual || epilogue.residual->rowStride() != 1) {
+            return;
+        }
+        const ConstMatrixView& residual = *epilogue.residual;
+        constexpr Index LineFloats = 64 / sizeof(float);
+        for (Index j = 0; j < cols; ++j) {
+            const float* column = residual.data() + row + (col + j) * residual.colStride();
+            for (Index i = 0; i < rows; i += LineFloats) {
+                __builtin_prefetch(column + i);
+            }
+        }
+    }
+
+    void applyEpilogue(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols, float* c, Index ldc) {
+        switch (epilogue.activation) {
+        case Activation::ReLU:
+            finishTile<Activation::ReLU>(epilogue, row, col, rows, cols, c, ldc);
+            break;
+        case Activation::GELU:
+            finishTile<Activation::GELU>(epilogue, row, col, rows, cols, c, ldc);
+            break;
+        default:
+            if (epilogue.bias != nullptr || epilogue.residual) {
+                finishTile<Activation::None>(epilogue, row, col, rows, cols, c, ldc);
+            }
+            break;
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
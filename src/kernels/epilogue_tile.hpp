@@ -0,0 +1,36 @@
+#pragma once
+
+#include "matrix_transform/epilogue.hpp"
+#include <cstddef>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    using Index = std::ptrdiff_t;
+
+    // Applies the bias, activation and residual of epilogue to the rows x cols tile at (row,
+    // col) of a column-major C that already holds scale * A * B. Called on each tile right
+    // after it is stored, while it is still in L1.
+    void applyEpilogue(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols, float* c, Index ldc);
+
+    // Prefetches the residual of a tile that applyEpilogue will finish later, so the short
+    // strided column reads of a tile do not stall on memory.
+    void prefetchEpilogue(const Epilogue& epilogue, Index row, Index col, Index rows, Index cols);
+
+    // True when the residual, if any, has the output's size.
+    inline bool epilogueFits(const Epilogue& epilogue, Index rows, Index cols) {
+        return !epilogue.residual || (epilogue.residual->rows() == rows && epilogue.residual->cols() == cols);
+    }
+
+    // The same epilogue for the transposed product C^T = B^T * A^T.
+    inline Epilogue transposeEpilogue(const Epilogue& epilogue) {
+        Epilogue transposed = epilogue;
+        transposed.biasPerRow = !epilogue.biasPerRow;
+        if (epilogue.residual) {
+            transposed.residual = epilogue.residual->transpose();
+        }
+        return transposed;
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,359 @@
+#include "int8_gemm.hpp"
+#include "workspace.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index GroupBytes = 4;
+        constexpr Index MaxTile = 16 * 6;
+        constexpr Index SkinnyRows = 512;
+
+        // Both AVX2 kernels share a layout so that prepacked B serves either of them. KC is a
+        // multiple of the group width; an MC x KC block of A (256 KiB) stays in L2 and the
+        // KC x NC panel of B (3 MiB) in L3.
+        const Int8Kernel maddubsKernel{"AVX2_MADDUBS_16x4", 16, 4, 256, 1024, 3072, &int8KernelMaddubs16x4};
+        const Int8Kernel splitKernel{"AVX2_MADDUBS_SPLIT_16x4", 16, 4, 256, 1024, 3072, &int8KernelMaddubsSplit16x4};
+#ifdef WITH_AVXVNNI_KERNELS
+        const Int8Kernel vnniKernel{"AVXVNNI_16x6", 16, 6, 256, 1024, 3072, &int8KernelVnni16x6};
+#endif
+
+        Index roundUp(Index value, Index multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        template <typename T>
+        T* acquireBytes(Workspace& workspace, std::size_t slot, std::size_t count) {
+            return reinterpret_cast<T*>(workspace.acquire(slot, (count * sizeof(T) + sizeof(float) - 1) / sizeof(float)));
+        }
+
+        template <typename T>
+        T* slotBytes(Workspace& workspace, std::size_t slot) {
+            return reinterpret_cast<T*>(workspace.data(slot));
+        }
+
+        int teamSize(int threads) {
+#ifdef _OPENMP
+            return threads > 0 ? threads : omp_get_max_threads();
+#else
+            (void)threads;
+            return 1;
+#endif
+        }
+
+        int threadId() {
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+        }
+
+        void scaleC(Index m, Index n, float beta, float* c, Index ldc) {
+            for (Index j = 0; j < n; ++j) {
+                float* cj = c + j * ldc;
+                if (beta == 0.0f) {
+                    std::fill(cj, cj + m, 0.0f);
+                } else {
+                    for (Index i = 0; i < m; ++i) {
+                        cj[i] *= beta;
+                    }
+                }
+            }
+        }
+
+        std::int32_t rightCode(const Int8Right& b, Index p, Index j) {
+            if (b.codes != nullptr) {
+                return b.codes[p * b.rs + j * b.cs];
+            }
+            const float q = std::nearbyint(b.values[p * b.rs + j * b.cs] * b.inverseScale);
+            return static_cast<std::int32_t>(std::clamp(q, -127.0f, 127.0f));
+        }
+
+        // Whether every u8 code of A is <= 127, so the maddubs kernel cannot saturate.
+        bool narrowCodes(Index m, Index k, const Int8Left& a) {
+            if (a.codes == nullptr) {
+                return a.maxCode <= 127;
+            }
+            const bool columns = a.rs == 1 || a.cs != 1;
+            const Index outer = columns ? k : m;
+            const Index inner = columns ? m : k;
+            const Index innerStride = columns ? a.rs : a.cs;
+            const Index outerStride = columns ? a.cs : a.rs;
+            std::uint8_t high = 0;
+            for (Index o = 0; o < outer; ++o) {
+                const std::uint8_t* line = a.codes + o * outerStride;
+                for (Index i = 0; i < inner; ++i) {
+                    high |= line[i * innerStride];
+                }
+            }
+            return high <= 127;
+        }
+
+        const Int8Kernel& kernelFor(Index m, Index k, const Int8Left& a) {
+#ifdef WITH_AVXVNNI_KERNELS
+            if (CpuFeatures::get().avxvnni) {
+                return vnniKernel;
+            }
+#endif
+            return selectInt8Kernel(narrowCodes(m, k, a));
+        }
+
+        // Adds the zero-point corrections of one KC block to an mr x nr tile and stores it:
+        //   C = alpha * (T - zeroB * rowSumA - zeroA * colSumB + kb * zeroA * zeroB) + beta * C
+        void storeTile(Index rows, Index cols, Index mr, const std::int32_t* tile, const std::int32_t* rowSum,
+                       const std::int32_t* colSum, std::int32_t zeroA, std::int32_t zeroB, Index kb,
+                       float alpha, float beta, float* c, Index ldc) {
+            const std::int64_t both = static_cast<std::int64_t>(kb) * zeroA * zeroB;
+            for (Index j = 0; j < cols; ++j) {
+                const std::int64_t column = static_cast<std::int64_t>(zeroA) * colSum[j] - both;
+                const std::int32_t* t = tile + j * mr;
+                float* cj = c + j * ldc;
+                for (Index i = 0; i < rows; ++i) {
+                    const std::int64_t value = t[i] - static_cast<std::int64_t>(zeroB) * rowSum[i] - column;
+                    const float product = alpha * static_cast<float>(value);
+                    cj[i] = beta == 0.0f ? product : product + beta * cj[i];
+                }
+            }
+        }
+
+        // Shared driver of int8Gemm and int8GemmPacked: B comes either from b, packed per KC x NC
+        // block into workspace slots 0 (codes) and 1 (column sums), or prepacked from bPacked.
+        // Each thread then owns two slots, an MC x KC block of A and its row sums.
+        void runInt8Gemm(const Int8Kernel& kernel, Index m, Index n, Index k, const Int8Left& a,
+                         const Int8Right* b, const std::uint8_t* bPacked, std::int32_t zeroB,
+                         float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads) {
+            threads = teamSize(threads);
+            const Index mr = kernel.mr;
+            const Index nr = kernel.nr;
+            const Index mc = std::max(mr, std::min(kernel.mc, roundUp((m + threads - 1) / threads, mr)));
+            const Index kc = std::min(kernel.kc, roundUp(k, GroupBytes));
+            const Index nc = std::min(kernel.nc, roundUp(n, nr));
+            const Index kp = roundUp(k, GroupBytes);
+            const std::int32_t* packedSums = bPacked != nullptr
+                ? reinterpret_cast<const std::int32_t*>(bPacked + roundUp(n, nr) * kp) : nullptr;
+
+            if (bPacked == nullptr) {
+                acquireBytes<std::int8_t>(workspace, 0, static_cast<std::size_t>(kc * nc));
+                acquireBytes<std::int32_t>(workspace, 1, static_cast<std::size_t>(nc));
+            }
+            for (int t = 0; t < threads; ++t) {
+                acquireBytes<std::uint8_t>(workspace, 2 + 2 * t, static_cast<std::size_t>(mc * kc));
+                acquireBytes<std::int32_t>(workspace, 3 + 2 * t, static_cast<std::size_t>(mc));
+            }
+
+            #pragma omp parallel num_threads(threads)
+            {
+                const int tid = threadId();
+                std::uint8_t* aPack = slotBytes<std::uint8_t>(workspace, 2 + 2 * tid);
+                std::int32_t* rowSum = slotBytes<std::int32_t>(workspace, 3 + 2 * tid);
+                std::int8_t* bPanel = bPacked == nullptr ? slotBytes<std::int8_t>(workspace, 0) : nullptr;
+                std::int32_t* colPanel = bPacked == nullptr ? slotBytes<std::int32_t>(workspace, 1) : nullptr;
+                alignas(64) std::int32_t tile[MaxTile];
+
+                for (Index jc = 0; jc < n; jc += nc) {
+                    const Index nb = std::min(nc, n - jc);
+                    for (Index pc = 0; pc < k; pc += kc) {
+                        const Index kb = std::min(kc, k - pc);
+                        const Index kbp = roundUp(kb, GroupBytes);
+                        const float betaBlock = pc == 0 ? beta : 1.0f;
+                        const std::int8_t* bPack = bPanel;
+                        const std::int32_t* colSum = colPanel;
+
+                        if (bPacked != nullptr) {
+                            bPack = reinterpret_cast<const std::int8_t*>(bPacked + jc * kp + roundUp(nb, nr) * pc);
+                            colSum = packedSums + (pc / kc) * n + jc;
+                        } else {
+                            #pragma omp for schedule(static)
+                            for (Index jr = 0; jr < nb; jr += nr) {
+                                int8PackBAvx2(*b, pc, jc + jr, nr, std::min(nr, nb - jr), kb, bPanel + jr * kbp, colPanel + jr);
+                            }
+                        }
+
+                        #pragma omp for schedule(dynamic)
+                        for (Index ic = 0; ic < m; ic += mc) {
+                            const Index mb = std::min(mc, m - ic);
+                            for (Index ir = 0; ir < mb; ir += mr) {
+                                int8PackAAvx2(a, ic + ir, pc, mr, std::min(mr, mb - ir), kb, aPack + ir * kbp, rowSum + ir);
+                            }
+                            for (Index jr = 0; jr < nb; jr += nr) {
+                                const Index cols = std::min(nr, nb - jr);
+                                for (Index ir = 0; ir < mb; ir += mr) {
+                                    kernel.compute(kbp / GroupBytes, aPack + ir * kbp, bPack + jr * kbp, tile);
+                                    storeTile(std::min(mr, mb - ir), cols, mr, tile, rowSum + ir, colSum + jr,
+                                              a.zeroPoint, zeroB, kb, alpha, betaBlock,
+                                              c + (ic + ir) + (jc + jr) * ldc, ldc);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // n <= Int8SkinnyMaxN: B is widened once to y = qB - zeroB (k x n int32, slot 0) with its
+        // column sums, then row chunks of A are streamed against it without packing:
+        //   C = alpha * (qA . y - zeroA * sum_p y) + beta * C
+        void runInt8Skinny(Index m, Index n, Index k, const Int8Left& a, const Int8Right& b,
+                           float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads) {
+            threads = teamSize(threads);
+            std::int32_t* y = acquireBytes<std::int32_t>(workspace, 0, static_cast<std::size_t>(k * n + n));
+            std::int32_t* ySum = y + k * n;
+            for (Index j = 0; j < n; ++j) {
+                std::int32_t sum = 0;
+                for (Index p = 0; p < k; ++p) {
+                    const std::int32_t value = rightCode(b, p, j) - b.zeroPoint;
+                    y[p + j * k] = value;
+                    sum += value;
+                }
+                ySum[j] = sum;
+            }
+            for (int t = 0; t < threads; ++t) {
+                acquireBytes<std::int32_t>(workspace, 1 + t, static_cast<std::size_t>(SkinnyRows * n));
+            }
+
+            #pragma omp parallel num_threads(threads)
+            {
+                std::int32_t* acc = slotBytes<std::int32_t>(workspace, 1 + threadId());
+                #pragma omp for schedule(dynamic)
+                for (Index i0 = 0; i0 < m; i0 += SkinnyRows) {
+                    const Index rows = std::min(SkinnyRows, m - i0);
+                    int8SkinnyAvx2(a, i0, rows, k, n, y, k, acc, rows);
+                    for (Index j = 0; j < n; ++j) {
+                        const std::int64_t shift = static_cast<std::int64_t>(a.zeroPoint) * ySum[j];
+                        float* cj = c + i0 + j * ldc;
+                        for (Index i = 0; i < rows; ++i) {
+                            const float product = alpha * static_cast<float>(acc[i + j * rows] - shift);
+                            cj[i] = beta == 0.0f ? product : product + beta * cj[i];
+                        }
+                    }
+                }
+            }
+        }
+
+        bool useSkinny(Index n, Index k) {
+            return n <= Int8SkinnyMaxN && k <= Int8SkinnyMaxK;
+        }
+
+        bool trivial(Index m, Index n, Index k, float alpha, float beta, float* c, Index ldc) {
+            if (m == 0 || n == 0) {
+                return true;
+            }
+            if (k == 0 || alpha == 0.0f) {
+                scaleC(m, n, beta, c, ldc);
+                return true;
+            }
+            return false;
+        }
+
+        // Host layout of prepacked operands; the AVX2 kernels share theirs.
+        const Int8Kernel& packedLayout() {
+            return selectInt8Kernel(true);
+        }
+    }
+
+    const Int8Kernel& selectInt8Kernel(bool narrowA) {
+#ifdef WITH_AVXVNNI_KERNELS
+        if (CpuFeatures::get().avxvnni) {
+            return vnniKernel;
+        }
+#endif
+        return narrowA ? maddubsKernel : splitKernel;
+    }
+
+    void int8Gemm(Index m, Index n, Index k, const Int8Left& a, const Int8Right& b,
+                  float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads) {
+        if (trivial(m, n, k, alpha, beta, c, ldc)) {
+            return;
+        }
+        if (useSkinny(n, k)) {
+            runInt8Skinny(m, n, k, a, b, alpha, beta, c, ldc, workspace, threads);
+            return;
+        }
+        runInt8Gemm(kernelFor(m, k, a), m, n, k, a, &b, nullptr, b.zeroPoint, alpha, beta, c, ldc, workspace, threads);
+    }
+
+    std::size_t int8PackedBSize(Index k, Index n) {
+        const Int8Kernel& kernel = packedLayout();
+        const Index kc = std::min(kernel.kc, roundUp(k, GroupBytes));
+        const Index blocks = k > 0 ? (k + kc - 1) / kc : 0;
+        return static_cast<std::size_t>(roundUp(n, kernel.nr) * roundUp(k, GroupBytes) + blocks * n * 4);
+    }
+
+    // Block (jc, pc) starts at jc * kp + roundUp(nb, nr) * pc, as in packB; the column sums of
+    // block pc follow all the codes, n per block.
+    void int8PackB(Index k, Index n, const Int8Right& b, std::uint8_t* dst) {
+        const Int8Kernel& kernel = packedLayout();
+        const Index nr = kernel.nr;
+        const Index kc = std::min(kernel.kc, roundUp(k, GroupBytes));
+        const Index nc = std::min(kernel.nc, roundUp(n, nr));
+        const Index kp = roundUp(k, GroupBytes);
+        std::int32_t* sums = reinterpret_cast<std::int32_t*>(dst + roundUp(n, nr) * kp);
+        for (Index jc = 0; jc < n; jc += nc) {
+            const Index nb = std::min(nc, n - jc);
+            for (Index pc = 0; pc < k; pc += kc) {
+                const Index kb = std::min(kc, k - pc);
+                const Index kbp = roundUp(kb, GroupBytes);
+                std::int8_t* block = reinterpret_cast<std::int8_t*>(dst + jc * kp + roundUp(nb, nr) * pc);
+                #pragma omp parallel for schedule(static)
+                for (Index jr = 0; jr < nb; jr += nr) {
+                    std::int32_t panelSum[MaxTile];
+                    const Index cols = std::min(nr, nb - jr);
+                    int8PackBAvx2(b, pc, jc + jr, nr, cols, kb, block + jr * kbp, panelSum);
+                    std::copy(panelSum, panelSum + cols, sums + (pc / kc) * n + jc + jr);
+                }
+            }
+        }
+    }
+
+    void int8UnpackB(Index k, Index n, const std::uint8_t* packed, std::int8_t* b, Index ldb) {
+        const Int8Kernel& kernel = packedLayout();
+        const Index nr = kernel.nr;
+        const Index kc = std::min(kernel.kc, roundUp(k, GroupBytes));
+        const Index nc = std::min(kernel.nc, roundUp(n, nr));
+        const Index kp = roundUp(k, GroupBytes);
+        for (Index jc = 0; jc < n; jc += nc) {
+            const Index nb = std::min(nc, n - jc);
+            for (Index pc = 0; pc < k; pc += kc) {
+                const Index kb = std::min(kc, k - pc);
+                const Index kbp = roundUp(kb, GroupBytes);
+                const std::int8_t* block = reinterpret_cast<const std::int8_t*>(packed + jc * kp + roundUp(nb, nr) * pc);
+                for (Index jr = 0; jr < nb; jr += nr) {
+                    const std::int8_t* panel = block + jr * kbp;
+                    for (Index j = 0; j < std::min(nr, nb - jr); ++j) {
+                        for (Index p = 0; p < kb; ++p) {
+                            b[(pc + p) + (jc + jr + j) * ldb] = panel[p / GroupBytes * nr * GroupBytes + j * GroupBytes + p % GroupBytes];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void int8GemmPacked(Index m, Index n, Index k, const Int8Left& a,
+                        const std::uint8_t* bPacked, std::int32_t zeroB,
+                        float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads) {
+        if (trivial(m, n, k, alpha, beta, c, ldc)) {
+            return;
+        }
+        if (useSkinny(n, k)) {
+            // A handful of columns: the codes are unpacked and streamed like an unpacked B.
+            std::vector<std::int8_t> codes(static_cast<std::size_t>(k * n));
+            int8UnpackB(k, n, bPacked, codes.data(), k);
+            runInt8Skinny(m, n, k, a, Int8Right{codes.data(), nullptr, 1, k, zeroB, 1.0f}, alpha, beta, c, ldc, workspace, threads);
+            return;
+        }
+        runInt8Gemm(kernelFor(m, k, a), m, n, k, a, nullptr, bPacked, zeroB, alpha, beta, c, ldc, workspace, threads);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
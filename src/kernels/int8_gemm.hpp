@@ -0,0 +1,110 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+#include <cstdint>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // Left operand of a u8 x s8 product, m x k through row/column strides: u8 codes read in
+    // place, or fp32 values (codes == nullptr) quantized as they are read, to
+    // clamp(nearbyint(x * inverseScale) + zeroPoint, 0, maxCode).
+    struct Int8Left {
+        const std::uint8_t* codes;
+        const float* values;
+        Index rs;
+        Index cs;
+        std::int32_t zeroPoint;
+        float inverseScale;
+        std::int32_t maxCode;
+    };
+
+    // Right operand, k x n: s8 codes, or fp32 values quantized symmetrically to
+    // clamp(nearbyint(x * inverseScale), -127, 127), in which case zeroPoint is 0.
+    struct Int8Right {
+        const std::int8_t* codes;
+        const float* values;
+        Index rs;
+        Index cs;
+        std::int32_t zeroPoint;
+        float inverseScale;
+    };
+
+    // Integer products of one packed A panel and one packed B panel over `groups` groups of
+    // four k, accumulated in int32 registers and stored as an mr x nr column-major tile.
+    using Int8TileFn = void (*)(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile);
+
+    struct Int8Kernel {
+        const char* name;
+        Index mr;
+        Index nr;
+        Index mc;
+        Index kc;
+        Index nc;
+        Int8TileFn compute;
+    };
+
+#ifdef WITH_X86_KERNELS
+    // Packed panels take k in groups of four bytes, the width of one vpdpbusd / maddubs lane:
+    // per group an A panel holds mr rows of four consecutive codes and a B panel nr columns of
+    // four. Missing rows, columns and the tail of the last group are zero. The packers also
+    // sum each row / column over the real k, for folding the zero points in afterwards:
+    //   C = alpha * (A.B - zeroB * rowSumA - zeroA * colSumB + k * zeroA * zeroB) + beta * C
+    // Both are defined in the AVX2 translation unit and shared by every int8 kernel.
+    void int8PackAAvx2(const Int8Left& a, Index i0, Index p0, Index mr, Index rows, Index kb,
+                       std::uint8_t* dst, std::int32_t* rowSum);
+    void int8PackBAvx2(const Int8Right& b, Index p0, Index j0, Index nr, Index cols, Index kb,
+                       std::int8_t* dst, std::int32_t* colSum);
+
+    // Register kernels, 16 rows (two ymm of int32 lanes) by nr columns. The maddubs kernel
+    // requires A codes <= 127, since its pair sums saturate int16 otherwise; the split kernel,
+    // which multiplies the high seven bits and the low bit of A separately, and the AVX-VNNI
+    // kernel are exact for the full u8 range. Both AVX2 kernels share one panel layout.
+    void int8KernelMaddubs16x4(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile);
+    void int8KernelMaddubsSplit16x4(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile);
+#ifdef WITH_AVXVNNI_KERNELS
+    void int8KernelVnni16x6(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile);
+#endif
+
+    // Widest n served by the skinny path, and the longest k it sums in one int32 pass.
+    constexpr Index Int8SkinnyMaxN = 8;
+    constexpr Index Int8SkinnyMaxK = 16384;
+
+    // Rows [i0, i0 + rows) of sum_p qa(i, p) * y(p, j) for the n <= Int8SkinnyMaxN columns of
+    // y (k x n int32, column-major with leading dimension ldy), read straight from A without
+    // packing, into acc (rows x n, leading dimension ldacc).
+    void int8SkinnyAvx2(const Int8Left& a, Index i0, Index rows, Index k, Index n,
+                        const std::int32_t* y, Index ldy, std::int32_t* acc, Index ldacc);
+
+    // Extends [lo, hi] to cover every element of a strided rows x cols fp32 matrix.
+    void floatRangeAvx2(const float* x, Index rows, Index cols, Index rs, Index cs, float& lo, float& hi);
+
+    // Fastest exact kernel for this host; narrowA promises A codes <= 127.
+    const Int8Kernel& selectInt8Kernel(bool narrowA);
+
+    // C = alpha * (A - zeroA) * (B - zeroB) + beta * C, blocked like blockedGemm: B is packed
+    // per KC x NC block and shared by the team, each thread packs MC x KC blocks of A and runs
+    // the register kernel over them. fp32 operands are quantized while they are packed, so
+    // they are read once per block and never stored as codes. Products with
+    // n <= Int8SkinnyMaxN stream A through int8SkinnyAvx2 instead of packing it.
+    // C is column-major and is not read when beta == 0. threads == 0 uses the OpenMP default
+    // team size. Requires AVX2.
+    void int8Gemm(Index m, Index n, Index k, const Int8Left& a, const Int8Right& b,
+                  float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads = 0);
+
+    // B (k x n) packed once for reuse on this host: every KC x NC block in the panel layout
+    // int8Gemm builds per call, stored back to back and followed by each block's column sums.
+    // Sizes are in bytes.
+    std::size_t int8PackedBSize(Index k, Index n);
+    void int8PackB(Index k, Index n, const Int8Right& b, std::uint8_t* dst);
+    // Inverse of int8PackB into column-major s8 codes with leading dimension ldb.
+    void int8UnpackB(Index k, Index n, const std::uint8_t* packed, std::int8_t* b, Index ldb);
+
+    // int8Gemm with B prepacked by int8PackB; only A is packed per call.
+    void int8GemmPacked(Index m, Index n, Index k, const Int8Left& a,
+                        const std::uint8_t* bPacked, std::int32_t zeroB,
+                        float alpha, float beta, float* c, Index ldc, Workspace& workspace, int threads = 0);
+#endif
+
+} // namespace Kernels
+} // namespace MatrixTransform
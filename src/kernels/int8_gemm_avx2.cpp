@@ -0,0 +1,456 @@
+#include "int8_gemm_impl.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Compiled with -mavx2. Blocking and threading live in int8_gemm.cpp.
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // u8 x s8 pairs summed to int16 (saturating), then widened to int32 pairs.
+        struct MaddubsDot {
+            using Operand = __m256i;
+            static __m256i prepare(__m256i a) { return a; }
+            static __m256i accumulate(__m256i acc, __m256i a, __m256i b) {
+                const __m256i pairs = _mm256_maddubs_epi16(a, b);
+                return _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, _mm256_set1_epi16(1)));
+            }
+        };
+
+        // A split into its high seven bits and its low bit, so neither maddubs saturates; the
+        // high half's pair sums are doubled as they are widened.
+        struct MaddubsSplitDot {
+            struct Operand {
+                __m256i high;
+                __m256i low;
+            };
+            static Operand prepare(__m256i a) {
+                return {_mm256_and_si256(_mm256_srli_epi16(a, 1), _mm256_set1_epi8(0x7f)),
+                        _mm256_and_si256(a, _mm256_set1_epi8(1))};
+            }
+            static __m256i accumulate(__m256i acc, const Operand& a, __m256i b) {
+                const __m256i high = _mm256_madd_epi16(_mm256_maddubs_epi16(a.high, b), _mm256_set1_epi16(2));
+                const __m256i low = _mm256_madd_epi16(_mm256_maddubs_epi16(a.low, b), _mm256_set1_epi16(1));
+                return _mm256_add_epi32(acc, _mm256_add_epi32(high, low));
+            }
+        };
+
+        // Eight fp32 values to clamped int32 codes. cvtps rounds to nearest even, as nearbyint
+        // does in the default rounding mode, so these match quantizeU8 / quantizeS8.
+        inline __m256i quantize8(const float* x, __m256 inverse, __m256i zero, __m256i lo, __m256i hi) {
+            const __m256i q = _mm256_add_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(x), inverse)), zero);
+            return _mm256_min_epi32(_mm256_max_epi32(q, lo), hi);
+        }
+
+        inline std::int32_t quantize1(float x, float inverse, std::int32_t zero, std::int32_t lo, std::int32_t hi) {
+            return std::clamp(static_cast<std::int32_t>(std::nearbyint(x * inverse)) + zero, lo, hi);
+        }
+
+        // Eight int32 codes in [0, 255] (or [-128, 127] when Signed) to eight bytes in order.
+        template <bool Signed>
+        inline __m128i narrow8(__m256i v) {
+            const __m128i lo = _mm256_castsi256_si128(v);
+            const __m128i hi = _mm256_extracti128_si256(v, 1);
+            const __m128i words = Signed ? _mm_packs_epi32(lo, hi) : _mm_packus_epi32(lo, hi);
+            return Signed ? _mm_packs_epi16(words, words) : _mm_packus_epi16(words, words);
+        }
+
+        // Scalar view of either operand, for edges and strides the vector paths do not cover.
+        struct LeftCodes {
+            const Int8Left& a;
+            std::int32_t operator()(Index i, Index p) const {
+                if (a.codes != nullptr) {
+                    return a.codes[i * a.rs + p * a.cs];
+                }
+                return quantize1(a.values[i * a.rs + p * a.cs], a.inverseScale, a.zeroPoint, 0, a.maxCode);
+            }
+        };
+
+        struct RightCodes {
+            const Int8Right& b;
+            std::int32_t operator()(Index p, Index j) const {
+                if (b.codes != nullptr) {
+                    return b.codes[p * b.rs + j * b.cs];
+                }
+                return quantize1(b.values[p * b.rs + j * b.cs], b.inverseScale, 0, -127, 127);
+            }
+        };
+
+        // 16 consecutive codes of column p of a column-major A, rows [i, i + 16).
+        inline __m128i leftColumn16(const Int8Left& a, Index i, Index p) {
+            if (a.codes != nullptr) {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.codes + i + p * a.cs));
+            }
+            const float* x = a.values + i + p * a.cs;
+            const __m256 inverse = _mm256_set1_ps(a.inverseScale);
+            const __m256i zero = _mm256_set1_epi32(a.zeroPoint);
+            const __m256i lo = _mm256_setzero_si256();
+            const __m256i hi = _mm256_set1_epi32(a.maxCode);
+            return _mm_unpacklo_epi64(narrow8<false>(quantize8(x, inverse, zero, lo, hi)),
+                                      narrow8<false>(quantize8(x + 8, inverse, zero, lo, hi)));
+        }
+
+        // Sums the four bytes of each int32 lane: u8 lanes when the codes are unsigned,
+        // s8 lanes otherwise.
+        template <bool Signed>
+        inline __m128i laneSums(__m128i codes) {
+            const __m128i pairs = Signed ? _mm_maddubs_epi16(_mm_set1_epi8(1), codes)
+                                         : _mm_maddubs_epi16(codes, _mm_set1_epi8(1));
+            return _mm_madd_epi16(pairs, _mm_set1_epi16(1));
+        }
+    }
+
+    void int8KernelMaddubs16x4(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile) {
+        int8Tile<MaddubsDot, 4>(groups, a, b, tile);
+    }
+
+    // Twice the work per product, so the panel is covered two columns at a time to keep the
+    // split operands and accumulators in registers; the layout matches the 16x4 kernel.
+    void int8KernelMaddubsSplit16x4(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile) {
+        int8Tile<MaddubsSplitDot, 2, 4>(groups, a, b, tile);
+        int8Tile<MaddubsSplitDot, 2, 4>(groups, a, b + 2 * GroupBytes, tile + 2 * TileRows);
+    }
+
+    void int8PackAAvx2(const Int8Left& a, Index i0, Index p0, Index mr, Index rows, Index kb,
+                       std::uint8_t* dst, std::int32_t* rowSum) {
+        const Index groups = (kb + GroupBytes - 1) / GroupBytes;
+        const Index panelBytes = mr * GroupBytes;
+
+        if (mr == TileRows && rows == TileRows && a.rs == 1) {
+            // Column-major: four 16-byte columns per group, interleaved bytewise and then by
+            // pairs into the 16 rows of four codes the kernels read.
+            __m128i sums[4] = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+            for (Index g = 0; g < groups; ++g) {
+                const Index p = p0 + g * GroupBytes;
+                const Index count = std::min(GroupBytes, p0 + kb - p);
+                __m128i col[4];
+                for (Index t = 0; t < 4; ++t) {
+                    col[t] = t < count ? leftColumn16(a, i0, p + t) : _mm_setzero_si128();
+                }
+                const __m128i low01 = _mm_unpacklo_epi8(col[0], col[1]);
+                const __m128i high01 = _mm_unpackhi_epi8(col[0], col[1]);
+                const __m128i low23 = _mm_unpacklo_epi8(col[2], col[3]);
+                const __m128i high23 = _mm_unpackhi_epi8(col[2], col[3]);
+                const __m128i rows4[4] = {_mm_unpacklo_epi16(low01, low23), _mm_unpackhi_epi16(low01, low23),
+                                          _mm_unpacklo_epi16(high01, high23), _mm_unpackhi_epi16(high01, high23)};
+                __m128i* out = reinterpret_cast<__m128i*>(dst + g * panelBytes);
+                for (int r = 0; r < 4; ++r) {
+                    _mm_store_si128(out + r, rows4[r]);
+                    sums[r] = _mm_add_epi32(sums[r], laneSums<false>(rows4[r]));
+                }
+            }
+            for (int r = 0; r < 4; ++r) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rowSum + 4 * r), sums[r]);
+            }
+            return;
+        }
+
+        std::memset(dst, 0, static_cast<std::size_t>(groups * panelBytes));
+        std::fill(rowSum, rowSum + mr, 0);
+        if (a.cs == 1 && a.codes != nullptr) {
+            // Row-major codes: each group is four consecutive bytes of a row.
+            for (Index i = 0; i < rows; ++i) {
+                const std::uint8_t* src = a.codes + (i0 + i) * a.rs + p0;
+                std::int32_t sum = 0;
+                for (Index p = 0; p < kb; ++p) {
+                    dst[p / GroupBytes * panelBytes + i * GroupBytes + p % GroupBytes] = src[p];
+                    sum += src[p];
+                }
+                rowSum[i] = sum;
+            }
+            return;
+        }
+        if (a.cs == 1) {
+            // Row-major values: quantized eight at a time into two groups.
+            const __m256 inverse = _mm256_set1_ps(a.inverseScale);
+            const __m256i zero = _mm256_set1_epi32(a.zeroPoint);
+            const __m256i lo = _mm256_setzero_si256();
+            const __m256i hi = _mm256_set1_epi32(a.maxCode);
+            const Index kv = kb / 8 * 8;
+            for (Index i = 0; i < rows; ++i) {
+                const float* src = a.values + (i0 + i) * a.rs + p0;
+                __m128i sum = _mm_setzero_si128();
+                for (Index p = 0; p < kv; p += 8) {
+                    const __m128i codes = narrow8<false>(quantize8(src + p, inverse, zero, lo, hi));
+                    const std::int32_t first = _mm_cvtsi128_si32(codes);
+                    const std::int32_t second = _mm_extract_epi32(codes, 1);
+                    std::memcpy(dst + p / GroupBytes * panelBytes + i * GroupBytes, &first, sizeof(first));
+                    std::memcpy(dst + (p / GroupBytes + 1) * panelBytes + i * GroupBytes, &second, sizeof(second));
+                    sum = _mm_add_epi32(sum, laneSums<false>(codes));
+                }
+                std::int32_t total = _mm_cvtsi128_si32(sum) + _mm_extract_epi32(sum, 1);
+                for (Index p = kv; p < kb; ++p) {
+                    const std::int32_t code = quantize1(src[p], a.inverseScale, a.zeroPoint, 0, a.maxCode);
+                    dst[p / GroupBytes * panelBytes + i * GroupBytes + p % GroupBytes] = static_cast<std::uint8_t>(code);
+                    total += code;
+                }
+                rowSum[i] = total;
+            }
+            return;
+        }
+        const LeftCodes code{a};
+        for (Index i = 0; i < rows; ++i) {
+            std::int32_t sum = 0;
+            for (Index p = 0; p < kb; ++p) {
+                const std::int32_t q = code(i0 + i, p0 + p);
+                dst[p / GroupBytes * panelBytes + i * GroupBytes + p % GroupBytes] = static_cast<std::uint8_t>(q);
+                sum += q;
+            }
+            rowSum[i] = sum;
+        }
+    }
+
+    void int8PackBAvx2(const Int8Right& b, Index p0, Index j0, Index nr, Index cols, Index kb,
+                       std::int8_t* dst, std::int32_t* colSum) {
+        const Index groups = (kb + GroupBytes - 1) / GroupBytes;
+        const Index panelBytes = nr * GroupBytes;
+        std::fill(colSum, colSum + nr, 0);
+        if (cols < nr || kb % GroupBytes != 0) {
+            std::memset(dst, 0, static_cast<std::size_t>(groups * panelBytes));
+        }
+
+        if (b.rs == 1 && b.codes != nullptr) {
+            // Column-major codes: every group of a column is four contiguous bytes already.
+            const Index kFull = kb / GroupBytes * GroupBytes;
+            for (Index j = 0; j < cols; ++j) {
+                const std::int8_t* src = b.codes + p0 + (j0 + j) * b.cs;
+                std::int8_t* out = dst + j * GroupBytes;
+                std::int32_t sum = 0;
+                for (Index p = 0; p < kFull; p += GroupBytes) {
+                    std::memcpy(out + p / GroupBytes * panelBytes, src + p, GroupBytes);
+                }
+                for (Index p = kFull; p < kb; ++p) {
+                    out[kFull / GroupBytes * panelBytes + p - kFull] = src[p];
+                }
+                for (Index p = 0; p < kb; ++p) {
+                    sum += src[p];
+                }
+                colSum[j] = sum;
+            }
+            return;
+        }
+        if (b.rs == 1) {
+            // Column-major values: quantized eight at a time into two groups.
+            const __m256 inverse = _mm256_set1_ps(b.inverseScale);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i lo = _mm256_set1_epi32(-127);
+            const __m256i hi = _mm256_set1_epi32(127);
+            const Index kv = kb / 8 * 8;
+            for (Index j = 0; j < cols; ++j) {
+                const float* src = b.values + p0 + (j0 + j) * b.cs;
+                std::int8_t* out = dst + j * GroupBytes;
+                __m128i sum = _mm_setzero_si128();
+                for (Index p = 0; p < kv; p += 8) {
+                    const __m128i codes = narrow8<true>(quantize8(src + p, inverse, zero, lo, hi));
+                    const std::int32_t first = _mm_cvtsi128_si32(codes);
+                    const std::int32_t second = _mm_extract_epi32(codes, 1);
+                    std::memcpy(out + p / GroupBytes * panelBytes, &first, sizeof(first));
+                    std::memcpy(out + (p / GroupBytes + 1) * panelBytes, &second, sizeof(second));
+                    sum = _mm_add_epi32(sum, laneSums<true>(codes));
+                }
+                std::int32_t total = _mm_cvtsi128_si32(sum) + _mm_extract_epi32(sum, 1);
+                for (Index p = kv; p < kb; ++p) {
+                    const std::int32_t code = quantize1(src[p], b.inverseScale, 0, -127, 127);
+                    out[p / GroupBytes * panelBytes + p % GroupBytes] = static_cast<std::int8_t>(code);
+                    total += code;
+                }
+                colSum[j] = total;
+            }
+            return;
+        }
+        const RightCodes code{b};
+        for (Index j = 0; j < cols; ++j) {
+            std::int32_t sum = 0;
+            for (Index p = 0; p < kb; ++p) {
+                const std::int32_t q = code(p0 + p, j0 + j);
+                dst[p / GroupBytes * panelBytes + j * GroupBytes + p % GroupBytes] = static_cast<std::int8_t>(q);
+                sum += q;
+            }
+            colSum[j] = sum;
+        }
+    }
+
+    namespace {
+        // Eight rows of column p of a column-major A as int32 codes.
+        inline __m256i leftColumn8(const Int8Left& a, const float* values, const std::uint8_t* codes, Index p,
+                                   __m256 inverse, __m256i zero, __m256i hi) {
+            if (codes != nullptr) {
+                return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes + p * a.cs)));
+            }
+            return quantize8(values + p * a.cs, inverse, zero, _mm256_setzero_si256(), hi);
+        }
+
+        // Column-major A: strips of eight rows by N columns of y, accumulated in registers over a
+        // slice of k and added to acc, which stays in L1 while the slice's columns of A stream in.
+        template <int N>
+        void skinnyAxpy(const Int8Left& a, Index i0, Index rows, Index k,
+                        const std::int32_t* y, Index ldy, std::int32_t* acc, Index ldacc) {
+            constexpr Index KBlock = 16;
+            const __m256 inverse = _mm256_set1_ps(a.inverseScale);
+            const __m256i zero = _mm256_set1_epi32(a.zeroPoint);
+            const __m256i hi = _mm256_set1_epi32(a.maxCode);
+            const Index strips = rows / 8 * 8;
+            for (Index p0 = 0; p0 < k; p0 += KBlock) {
+                const Index pEnd = std::min(k, p0 + KBlock);
+                for (Index i = 0; i < strips; i += 8) {
+                    const float* values = a.values != nullptr ? a.values + i0 + i : nullptr;
+                    const std::uint8_t* codes = a.codes != nullptr ? a.codes + i0 + i : nullptr;
+                    __m256i sum[N];
+                    for (int j = 0; j < N; ++j) {
+                        sum[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i + j * ldacc));
+                    }
+                    for (Index p = p0; p < pEnd; ++p) {
+                        const __m256i q = leftColumn8(a, values, codes, p, inverse, zero, hi);
+                        for (int j = 0; j < N; ++j) {
+                            sum[j] = _mm256_add_epi32(sum[j], _mm256_mullo_epi32(q, _mm256_set1_epi32(y[p + j * ldy])));
+                        }
+                    }
+                    for (int j = 0; j < N; ++j) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i + j * ldacc), sum[j]);
+                    }
+                }
+            }
+            const LeftCodes code{a};
+            for (Index i = strips; i < rows; ++i) {
+                for (Index p = 0; p < k; ++p) {
+                    const std::int32_t q = code(i0 + i, p);
+                    for (int j = 0; j < N; ++j) {
+                        acc[i + j * ldacc] += q * y[p + j * ldy];
+                    }
+                }
+            }
+        }
+
+        inline std::int32_t horizontalSum(__m256i v) {
+            __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+            s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+            return _mm_cvtsi128_si32(s);
+        }
+
+        // Row-major A: each row quantized eight codes at a time and dotted with N columns of y.
+        template <int N>
+        void skinnyDot(const Int8Left& a, Index i0, Index rows, Index k,
+                       const std::int32_t* y, Index ldy, std::int32_t* acc, Index ldacc) {
+            const __m256 inverse = _mm256_set1_ps(a.inverseScale);
+            const __m256i zero = _mm256_set1_epi32(a.zeroPoint);
+            const __m256i hi = _mm256_set1_epi32(a.maxCode);
+            const Index kv = k / 8 * 8;
+            const LeftCodes code{a};
+            for (Index i = 0; i < rows; ++i) {
+                __m256i sum[N];
+                for (int j = 0; j < N; ++j) {
+                    sum[j] = _mm256_setzero_si256();
+                }
+                for (Index p = 0; p < kv; p += 8) {
+                    const __m256i q = a.codes != nullptr
+                        ? _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a.codes + (i0 + i) * a.rs + p)))
+                        : quantize8(a.values + (i0 + i) * a.rs + p, inverse, zero, _mm256_setzero_si256(), hi);
+                    for (int j = 0; j < N; ++j) {
+                        const __m256i yj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + p + j * ldy));
+                        sum[j] = _mm256_add_epi32(sum[j], _mm256_mullo_epi32(q, yj));
+                    }
+                }
+                for (int j = 0; j < N; ++j) {
+                    std::int32_t total = horizontalSum(sum[j]);
+                    for (Index p = kv; p < k; ++p) {
+                        total += code(i0 + i, p) * y[p + j * ldy];
+                    }
+                    acc[i + j * ldacc] = total;
+                }
+            }
+        }
+
+        template <int N>
+        void skinnyColumns(const Int8Left& a, Index i0, Index rows, Index k,
+                           const std::int32_t* y, Index ldy, std::int32_t* acc, Index ldacc) {
+            if (a.rs == 1) {
+                for (int j = 0; j < N; ++j) {
+                    std::fill(acc + j * ldacc, acc + j * ldacc + rows, 0);
+                }
+                skinnyAxpy<N>(a, i0, rows, k, y, ldy, acc, ldacc);
+            } else if (a.cs == 1) {
+                skinnyDot<N>(a, i0, rows, k, y, ldy, acc, ldacc);
+            } else {
+                const LeftCodes code{a};
+                for (Index i = 0; i < rows; ++i) {
+                    for (int j = 0; j < N; ++j) {
+                        std::int32_t total = 0;
+                        for (Index p = 0; p < k; ++p) {
+                            total += code(i0 + i, p) * y[p + j * ldy];
+                        }
+                        acc[i + j * ldacc] = total;
+                    }
+                }
+            }
+        }
+    }
+
+    void int8SkinnyAvx2(const Int8Left& a, Index i0, Index rows, Index k, Index n,
+                        const std::int32_t* y, Index ldy, std::int32_t* acc, Index ldacc) {
+        // Up to four columns per pass keep 2 * 4 + 2 ymm live.
+        for (Index j = 0; j < n; j += 4) {
+            const std::int32_t* yj = y + j * ldy;
+            std::int32_t* accj = acc + j * ldacc;
+            switch (std::min<Index>(4, n - j)) {
+                case 4: skinnyColumns<4>(a, i0, rows, k, yj, ldy, accj, ldacc); break;
+                case 3: skinnyColumns<3>(a, i0, rows, k, yj, ldy, accj, ldacc); break;
+                case 2: skinnyColumns<2>(a, i0, rows, k, yj, ldy, accj, ldacc); break;
+                default: skinnyColumns<1>(a, i0, rows, k, yj, ldy, accj, ldacc); break;
+            }
+        }
+    }
+
+    void floatRangeAvx2(const float* x, Index rows, Index cols, Index rs, Index cs, float& lo, float& hi) {
+        // Four independent min / max chains hide the latency of vminps / vmaxps.
+        __m256 vlo[4];
+        __m256 vhi[4];
+        for (int u = 0; u < 4; ++u) {
+            vlo[u] = _mm256_set1_ps(lo);
+            vhi[u] = _mm256_set1_ps(hi);
+        }
+        float slo = lo;
+        float shi = hi;
+        // Walk the contiguous dimension when there is one.
+        const bool columns = rs == 1 || cs != 1;
+        const Index outer = columns ? cols : rows;
+        const Index inner = columns ? rows : cols;
+        const Index innerStride = columns ? rs : cs;
+        const Index outerStride = columns ? cs : rs;
+        for (Index o = 0; o < outer; ++o) {
+            const float* line = x + o * outerStride;
+            Index i = 0;
+            if (innerStride == 1) {
+                for (; i + 32 <= inner; i += 32) {
+                    for (int u = 0; u < 4; ++u) {
+                        const __m256 v = _mm256_loadu_ps(line + i + 8 * u);
+                        vlo[u] = _mm256_min_ps(vlo[u], v);
+                        vhi[u] = _mm256_max_ps(vhi[u], v);
+                    }
+                }
+                for (; i + 8 <= inner; i += 8) {
+                    const __m256 v = _mm256_loadu_ps(line + i);
+                    vlo[0] = _mm256_min_ps(vlo[0], v);
+                    vhi[0] = _mm256_max_ps(vhi[0], v);
+                }
+            }
+            for (; i < inner; ++i) {
+                slo = std::min(slo, line[i * innerStride]);
+                shi = std::max(shi, line[i * innerStride]);
+            }
+        }
+        alignas(32) float l[8];
+        alignas(32) float h[8];
+        _mm256_store_ps(l, _mm256_min_ps(_mm256_min_ps(vlo[0], vlo[1]), _mm256_min_ps(vlo[2], vlo[3])));
+        _mm256_store_ps(h, _mm256_max_ps(_mm256_max_ps(vhi[0], vhi[1]), _mm256_max_ps(vhi[2], vhi[3])));
+        for (int t = 0; t < 8; ++t) {
+            slo = std::min(slo, l[t]);
+            shi = std::max(shi, h[t]);
+        }
+        lo = slo;
+        hi = shi;
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
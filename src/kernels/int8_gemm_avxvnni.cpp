@@ -0,0 +1,25 @@
+#include "int8_gemm_impl.hpp"
+
+// Compiled with -mavx2 -mavxvnni. Packing lives in the AVX2 translation unit.
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // vpdpbusd: four u8 x s8 products summed straight into each int32 lane.
+        struct VnniDot {
+            using Operand = __m256i;
+            static __m256i prepare(__m256i a) { return a; }
+            static __m256i accumulate(__m256i acc, __m256i a, __m256i b) {
+                return _mm256_dpbusd_avx_epi32(acc, a, b);
+            }
+        };
+    }
+
+    // 12 accumulators, two A vectors and one broadcast: 15 of the 16 ymm registers.
+    void int8KernelVnni16x6(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile) {
+        int8Tile<VnniDot, 6>(groups, a, b, tile);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,56 @@
+#pragma once
+
+// Shared body of the int8 register kernels. Included only by translation units built for AVX2
+// or wider; everything is in an anonymous namespace so each TU keeps its own copy.
+
+#include "int8_gemm.hpp"
+#include <immintrin.h>
+#include <cstring>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index TileRows = 16;
+        constexpr Index GroupBytes = 4;
+
+        // 16 x NR tile over a packed A panel (64 bytes per group of k: 16 rows of four codes)
+        // and a packed B panel (4 * NR bytes per group). Each group loads A once as two ymm of
+        // int32 lanes, one lane per row, and broadcasts each column's four B codes against it,
+        // so all 2 * NR int32 accumulators stay in registers for the whole panel.
+        // Dot::prepare turns a vector of A codes into the kernel's operand, and
+        // Dot::accumulate adds the four u8 x s8 products of every lane to the accumulator.
+        // PanelNR is the width of the B panel when the tile covers only its first NR columns.
+        // The column loops are unrolled so that acc is promoted to registers at every -O level.
+        template <typename Dot, int NR, int PanelNR = NR>
+        inline void int8Tile(Index groups, const std::uint8_t* a, const std::int8_t* b, std::int32_t* tile) {
+            __m256i acc[NR][2];
+            #pragma GCC unroll 8
+            for (int j = 0; j < NR; ++j) {
+                acc[j][0] = _mm256_setzero_si256();
+                acc[j][1] = _mm256_setzero_si256();
+            }
+            for (Index g = 0; g < groups; ++g) {
+                const typename Dot::Operand a0 = Dot::prepare(_mm256_load_si256(reinterpret_cast<const __m256i*>(a)));
+                const typename Dot::Operand a1 = Dot::prepare(_mm256_load_si256(reinterpret_cast<const __m256i*>(a + 32)));
+                #pragma GCC unroll 8
+                for (int j = 0; j < NR; ++j) {
+                    std::int32_t word;
+                    std::memcpy(&word, b + GroupBytes * j, sizeof(word));
+                    const __m256i bj = _mm256_set1_epi32(word);
+                    acc[j][0] = Dot::accumulate(acc[j][0], a0, bj);
+                    acc[j][1] = Dot::accumulate(acc[j][1], a1, bj);
+                }
+                a += TileRows * GroupBytes;
+                b += PanelNR * GroupBytes;
+            }
+            #pragma GCC unroll 8
+            for (int j = 0; j < NR; ++j) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(tile + j * TileRows), acc[j][0]);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(tile + j * TileRows + 8), acc[j][1]);
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
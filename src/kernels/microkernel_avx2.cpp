@@ -0,0 +1,72 @@
+#include "microkernels.hpp"
+#include <immintrin.h>
+
+// Compiled with -mavx2 -mfma. Only the register kernel lives here so that no
+// shared inline code is ever emitted with AVX2 instructions.
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index MR = 16;
+        constexpr Index NR = 6;
+    }
+
+    // 16x6 tile: two ymm rows per column of C, 12 accumulators, one broadcast per column.
+    void avx2Kernel16x6(Index kc, float alpha, const float* a, const float* b,
+                        float beta, float* c, Index ldc) {
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+        __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+        for (Index p = 0; p < kc; ++p) {
+            const __m256 a0 = _mm256_load_ps(a);
+            const __m256 a1 = _mm256_load_ps(a + 8);
+            __m256 bj;
+
+            bj = _mm256_broadcast_ss(b + 0);
+            c00 = _mm256_fmadd_ps(a0, bj, c00);
+            c01 = _mm256_fmadd_ps(a1, bj, c01);
+            bj = _mm256_broadcast_ss(b + 1);
+            c10 = _mm256_fmadd_ps(a0, bj, c10);
+            c11 = _mm256_fmadd_ps(a1, bj, c11);
+            bj = _mm256_broadcast_ss(b + 2);
+            c20 = _mm256_fmadd_ps(a0, bj, c20);
+            c21 = _mm256_fmadd_ps(a1, bj, c21);
+            bj = _mm256_broadcast_ss(b + 3);
+            c30 = _mm256_fmadd_ps(a0, bj, c30);
+            c31 = _mm256_fmadd_ps(a1, bj, c31);
+            bj = _mm256_broadcast_ss(b + 4);
+            c40 = _mm256_fmadd_ps(a0, bj, c40);
+            c41 = _mm256_fmadd_ps(a1, bj, c41);
+            bj = _mm256_broadcast_ss(b + 5);
+            c50 = _mm256_fmadd_ps(a0, bj, c50);
+            c51 = _mm256_fmadd_ps(a1, bj, c51);
+
+            a += MR;
+            b += NR;
+        }
+
+        const __m256 va = _mm256_set1_ps(alpha);
+        __m256 acc[NR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+
+        if (beta == 0.0f) {
+            for (Index j = 0; j < NR; ++j) {
+                _mm256_storeu_ps(c + j * ldc, _mm256_mul_ps(va, acc[j][0]));
+                _mm256_storeu_ps(c + j * ldc + 8, _mm256_mul_ps(va, acc[j][1]));
+            }
+        } else {
+            const __m256 vb = _mm256_set1_ps(beta);
+            for (Index j = 0; j < NR; ++j) {
+                float* cj = c + j * ldc;
+                _mm256_storeu_ps(cj, _mm256_fmadd_ps(va, acc[j][0], _mm256_mul_ps(vb, _mm256_loadu_ps(cj))));
+                _mm256_storeu_ps(cj + 8, _mm256_fmadd_ps(va, acc[j][1], _mm256_mul_ps(vb, _mm256_loadu_ps(cj + 8))));
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,56 @@
+#include "microkernels.hpp"
+#include <immintrin.h>
+
+// Compiled with -mavx512f. Only reached after the runtime CPU probe reports AVX-512F.
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index MR = 32;
+        constexpr Index NR = 12;
+    }
+
+    // 32x12 tile: two zmm rows per column of C, 24 accumulators, one broadcast per column.
+    void avx512Kernel32x12(Index kc, float alpha, const float* a, const float* b,
+                           float beta, float* c, Index ldc) {
+        __m512 acc[NR][2];
+        #pragma GCC unroll 12
+        for (Index j = 0; j < NR; ++j) {
+            acc[j][0] = _mm512_setzero_ps();
+            acc[j][1] = _mm512_setzero_ps();
+        }
+
+        for (Index p = 0; p < kc; ++p) {
+            const __m512 a0 = _mm512_load_ps(a);
+            const __m512 a1 = _mm512_load_ps(a + 16);
+            #pragma GCC unroll 12
+            for (Index j = 0; j < NR; ++j) {
+                const __m512 bj = _mm512_set1_ps(b[j]);
+                acc[j][0] = _mm512_fmadd_ps(a0, bj, acc[j][0]);
+                acc[j][1] = _mm512_fmadd_ps(a1, bj, acc[j][1]);
+            }
+            a += MR;
+            b += NR;
+        }
+
+        const __m512 va = _mm512_set1_ps(alpha);
+        if (beta == 0.0f) {
+            #pragma GCC unroll 12
+            for (Index j = 0; j < NR; ++j) {
+                _mm512_storeu_ps(c + j * ldc, _mm512_mul_ps(va, acc[j][0]));
+                _mm512_storeu_ps(c + j * ldc + 16, _mm512_mul_ps(va, acc[j][1]));
+            }
+        } else {
+            const __m512 vb = _mm512_set1_ps(beta);
+            #pragma GCC unroll 12
+            for (Index j = 0; j < NR; ++j) {
+                float* cj = c + j * ldc;
+                _mm512_storeu_ps(cj, _mm512_fmadd_ps(va, acc[j][0], _mm512_mul_ps(vb, _mm512_loadu_ps(cj))));
+                _mm512_storeu_ps(cj + 16, _mm512_fmadd_ps(va, acc[j][1], _mm512_mul_ps(vb, _mm512_loadu_ps(cj + 16))));
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,37 @@
+#include "microkernels.hpp"
+
+// Portable fallback built with the baseline target flags; safe on every host.
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index MR = 8;
+        constexpr Index NR = 4;
+    }
+
+    void scalarKernel8x4(Index kc, float alpha, const float* a, const float* b,
+                         float beta, float* c, Index ldc) {
+        float acc[NR][MR] = {};
+
+        for (Index p = 0; p < kc; ++p) {
+            for (Index j = 0; j < NR; ++j) {
+                const float bj = b[j];
+                for (Index i = 0; i < MR; ++i) {
+                    acc[j][i] += a[i] * bj;
+                }
+            }
+            a += MR;
+            b += NR;
+        }
+
+        for (Index j = 0; j < NR; ++j) {
+            float* cj = c + j * ldc;
+            for (Index i = 0; i < MR; ++i) {
+                cj[i] = alpha * acc[j][i] + (beta == 0.0f ? 0.0f : beta * cj[i]);
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // Register kernels, each defined in a translation unit built for its own ISA.
+    void scalarKernel8x4(Index kc, float alpha, const float* a, const float* b,
+                         float beta, float* c, Index ldc);
+
+#ifdef WITH_X86_KERNELS
+    void avx2Kernel16x6(Index kc, float alpha, const float* a, const float* b,
+                        float beta, float* c, Index ldc);
+
+    void avx512Kernel32x12(Index kc, float alpha, const float* a, const float* b,
+                           float beta, float* c, Index ldc);
+#endif
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,47 @@
+#include "parallel_runtime.hpp"
+#include <omp.h>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        void setThreads(int threads) {
+            omp_set_num_threads(threads);
+        }
+
+        int maxThreads() {
+            return omp_get_max_threads();
+        }
+
+        bool inParallel() {
+            return omp_in_parallel() != 0;
+        }
+
+        void parallelFor(std::ptrdiff_t count, bool dynamic, const std::function<void(std::ptrdiff_t)>& body) {
+            if (dynamic) {
+                #pragma omp parallel for schedule(dynamic)
+                for (std::ptrdiff_t i = 0; i < count; ++i) {
+                    body(i);
+                }
+            } else {
+                #pragma omp parallel for schedule(static)
+                for (std::ptrdiff_t i = 0; i < count; ++i) {
+                    body(i);
+                }
+            }
+        }
+
+        void onEachThread(int team, const std::function<void()>& body) {
+            #pragma omp parallel num_threads(team)
+            body();
+        }
+
+        // Installs the OpenMP team in matrix_core as soon as this library is loaded.
+        const bool installed = [] {
+            ParallelRuntime::getInstance().install({setThreads, maxThreads, inParallel, parallelFor, onEachThread});
+            return true;
+        }();
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,145 @@
+#include "skinny_gemm.hpp"
+#include "workspace.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // Rows per task: the axpy form keeps AxpyRows x n accumulators in L1 while it streams
+        // columns of X; the dot form reuses each packed column of Y across DotRows rows.
+        constexpr Index AxpyRows = 512;
+        constexpr Index DotRows = 32;
+        // Shortest slice of the reduction worth a task of its own when splitting over k.
+        constexpr Index MinSplitK = 1024;
+        // Below this many multiply-adds the team costs more than it saves.
+        constexpr Index MinParallelWork = 64 * 1024;
+
+        struct SkinnyKernels {
+            SkinnyFn axpy;
+            SkinnyFn dot;
+        };
+
+        SkinnyKernels selectKernels() {
+#ifdef WITH_X86_KERNELS
+            const CpuFeatures& features = CpuFeatures::get();
+            if (features.avx512f) {
+                return {&skinnyAxpyAvx512, &skinnyDotAvx512};
+            }
+            if (features.avx2 && features.fma) {
+                return {&skinnyAxpyAvx2, &skinnyDotAvx2};
+            }
+#endif
+            return {&skinnyAxpyScalar, &skinnyDotScalar};
+        }
+
+        // c(i, j) = alpha * sum over s of partial_s(i, j) + beta * c(i, j) for rows [i0, i0 + rows).
+        void storeRows(Index i0, Index rows, Index n, float alpha, const float* partial, Index ldp,
+                       Index splits, std::size_t splitStride, float beta, float* c, Index rsC, Index csC) {
+            for (Index j = 0; j < n; ++j) {
+                const float* src = partial + i0 + j * ldp;
+                float* dst = c + i0 * rsC + j * csC;
+                for (Index i = 0; i < rows; ++i) {
+                    float sum = src[i];
+                    for (Index s = 1; s < splits; ++s) {
+                        sum += src[i + static_cast<Index>(s * splitStride)];
+                    }
+                    dst[i * rsC] = beta == 0.0f ? alpha * sum : alpha * sum + beta * dst[i * rsC];
+                }
+            }
+        }
+    }
+
+    bool skinnyApplies(Index n, Index rsX, Index csX) {
+        return n <= SkinnyMaxN && (rsX == 1 || csX == 1);
+    }
+
+    void skinnyGemm(Index m, Index n, Index k, float alpha,
+                    const float* x, Index rsX, Index csX, const float* y, Index rsY, Index csY,
+                    float beta, float* c, Index rsC, Index csC, Workspace& workspace, int threads) {
+        if (m == 0 || n == 0) {
+            return;
+        }
+        if (k == 0 || alpha == 0.0f) {
+            for (Index j = 0; j < n; ++j) {
+                for (Index i = 0; i < m; ++i) {
+                    float& out = c[i * rsC + j * csC];
+                    out = beta == 0.0f ? 0.0f : beta * out;
+                }
+            }
+            return;
+        }
+        static const SkinnyKernels kernels = selectKernels();
+
+        // Column-major X streams down its columns; anything else must be row-major.
+        const bool axpy = rsX == 1;
+        const SkinnyFn kernel = axpy ? kernels.axpy : kernels.dot;
+        const Index ldx = axpy ? csX : rsX;
+        const Index rowsPerTask = axpy ? AxpyRows : DotRows;
+
+#ifdef _OPENMP
+        if (threads <= 0) {
+            threads = omp_get_max_threads();
+        }
+#else
+        threads = 1;
+#endif
+        if (m * k * n < MinParallelWork) {
+            threads = 1;
+        }
+
+        const Index chunks = (m + rowsPerTask - 1) / rowsPerTask;
+        // Long reductions over few rows leave threads idle, so k is split into slices (a
+        // multiple of 16 long) whose partial sums are reduced afterwards.
+        Index splits = 1;
+        if (chunks < threads) {
+            splits = std::clamp<Index>(threads / chunks, 1, std::max<Index>(k / MinSplitK, 1));
+        }
+        const Index kSlice = ((k + splits - 1) / splits + 15) / 16 * 16;
+        splits = (k + kSlice - 1) / kSlice;
+
+        // Slot 0 holds Y packed column-major with ldy = k, slot 1 one m x n partial product per
+        // slice of k.
+        const std::size_t splitStride = static_cast<std::size_t>(m * n);
+        float* yPacked = workspace.acquire(0, static_cast<std::size_t>(k * n));
+        float* partial = workspace.acquire(1, splitStride * static_cast<std::size_t>(splits));
+        for (Index j = 0; j < n; ++j) {
+            for (Index p = 0; p < k; ++p) {
+                yPacked[p + j * k] = y[p * rsY + j * csY];
+            }
+        }
+
+        const Index tasks = chunks * splits;
+        #pragma omp parallel for num_threads(static_cast<int>(std::min<Index>(threads, tasks))) schedule(dynamic)
+        for (Index task = 0; task < tasks; ++task) {
+            const Index i0 = task % chunks * rowsPerTask;
+            const Index rows = std::min(rowsPerTask, m - i0);
+            const Index s = task / chunks;
+            const Index p0 = s * kSlice;
+            float* acc = partial + s * splitStride + i0;
+            for (Index j = 0; j < n; ++j) {
+                std::fill(acc + j * m, acc + j * m + rows, 0.0f);
+            }
+            const float* xBlock = axpy ? x + i0 + p0 * ldx : x + i0 * ldx + p0;
+            kernel(rows, std::min(kSlice, k - p0), n, xBlock, ldx, yPacked + p0, k, acc, m);
+            if (splits == 1) {
+                storeRows(i0, rows, n, alpha, partial, m, 1, splitStride, beta, c, rsC, csC);
+            }
+        }
+
+        if (splits > 1) {
+            #pragma omp parallel for num_threads(static_cast<int>(std::min<Index>(threads, chunks))) schedule(static)
+            for (Index chunk = 0; chunk < chunks; ++chunk) {
+                const Index i0 = chunk * rowsPerTask;
+                storeRows(i0, std::min(rowsPerTask, m - i0), n, alpha, partial, m, splits, splitStride, beta, c, rsC, csC);
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // acc[i + j * ldacc] += sum over p < k of x(i, p) * y[p + j * ldy] for i < rows, j < n.
+    // The axpy form reads a column-major x (x(i, p) = x[i + p * ldx]) one column at a time;
+    // the dot form reads a row-major x (x(i, p) = x[i * ldx + p]) one row at a time.
+    using SkinnyFn = void (*)(Index rows, Index k, Index n, const float* x, Index ldx,
+                              const float* y, Index ldy, float* acc, Index ldacc);
+
+    // Per-ISA kernels, each defined in skinny_gemm_<isa>.cpp from skinny_gemm_impl.hpp.
+    void skinnyAxpyScalar(Index rows, Index k, Index n, const float* x, Index ldx,
+                          const float* y, Index ldy, float* acc, Index ldacc);
+    void skinnyDotScalar(Index rows, Index k, Index n, const float* x, Index ldx,
+                         const float* y, Index ldy, float* acc, Index ldacc);
+#ifdef WITH_X86_KERNELS
+    void skinnyAxpyAvx2(Index rows, Index k, Index n, const float* x, Index ldx,
+                        const float* y, Index ldy, float* acc, Index ldacc);
+    void skinnyDotAvx2(Index rows, Index k, Index n, const float* x, Index ldx,
+                       const float* y, Index ldy, float* acc, Index ldacc);
+    void skinnyAxpyAvx512(Index rows, Index k, Index n, const float* x, Index ldx,
+                          const float* y, Index ldy, float* acc, Index ldacc);
+    void skinnyDotAvx512(Index rows, Index k, Index n, const float* x, Index ldx,
+                         const float* y, Index ldy, float* acc, Index ldacc);
+#endif
+
+    // Widest right-hand side skinnyGemm handles; wider products amortize packing in blockedGemm.
+    constexpr Index SkinnyMaxN = 16;
+
+    // True when skinnyGemm can run C = X * Y with this X: n <= SkinnyMaxN and X contiguous
+    // along its rows or its columns.
+    bool skinnyApplies(Index n, Index rsX, Index csX);
+
+    // GEMV and tall-skinny GEMM: C = alpha * X * Y + beta * C for an m x k X streamed from
+    // memory exactly once and a k x n Y with few columns, packed into the workspace. Rows of C
+    // are split across the team; when there are too few of them to occupy it, the reduction
+    // over k is split as well and the partial sums are added at the end. C is addressed
+    // through strides, so short-wide products run as C^T = B^T * A^T. C is not read when
+    // beta == 0. threads == 0 uses the OpenMP default team size.
+    void skinnyGemm(Index m, Index n, Index k, float alpha,
+                    const float* x, Index rsX, Index csX, const float* y, Index rsY, Index csY,
+                    float beta, float* c, Index rsC, Index csC, Workspace& workspace, int threads = 0);
+
+} // namespace Kernels
+} // namespace MatrixTransform
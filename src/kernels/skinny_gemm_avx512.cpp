@@ -0,0 +1,17 @@
+#include "skinny_gemm_impl.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    void skinnyAxpyAvx512(Index rows, Index k, Index n, const float* x, Index ldx,
+                          const float* y, Index ldy, float* acc, Index ldacc) {
+        skinnyAxpy(rows, k, n, x, ldx, y, ldy, acc, ldacc);
+    }
+
+    void skinnyDotAvx512(Index rows, Index k, Index n, const float* x, Index ldx,
+                         const float* y, Index ldy, float* acc, Index ldacc) {
+        skinnyDot(rows, k, n, x, ldx, y, ldy, acc, ldacc);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,178 @@
+#pragma once
+
+// Included once by each per-ISA skinny_gemm_<isa>.cpp. Vector extensions and loops written for
+// the auto-vectorizer give each translation unit code for its own instruction set.
+
+#include "skinny_gemm.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+#if defined(__AVX512F__)
+        constexpr Index VectorFloats = 16;
+#elif defined(__AVX2__)
+        constexpr Index VectorFloats = 8;
+#else
+        constexpr Index VectorFloats = 4;
+#endif
+        constexpr Index StripRows = 2 * VectorFloats;
+
+        // GCC/Clang vector extensions, as in small_gemm_impl.hpp.
+        typedef float Vector __attribute__((vector_size(VectorFloats * sizeof(float))));
+
+        inline Vector loadVector(const float* source) {
+            Vector v;
+            std::memcpy(&v, source, sizeof(v));
+            return v;
+        }
+
+        inline void storeVector(float* destination, const Vector& v) {
+            std::memcpy(destination, &v, sizeof(v));
+        }
+
+        // A strip of two row vectors of acc by NB columns of y, accumulated in registers over k.
+        template <int NB>
+        inline void axpyStrip(Index k, const float* x, Index ldx, const float* y, Index ldy,
+                              float* acc, Index ldacc) {
+            Vector sum[NB][2] = {};
+            for (Index p = 0; p < k; ++p) {
+                const Vector x0 = loadVector(x + p * ldx);
+                const Vector x1 = loadVector(x + p * ldx + VectorFloats);
+                for (int j = 0; j < NB; ++j) {
+                    const float yp = y[p + j * ldy];
+                    sum[j][0] += x0 * yp;
+                    sum[j][1] += x1 * yp;
+                }
+            }
+            for (int j = 0; j < NB; ++j) {
+                float* out = acc + j * ldacc;
+                storeVector(out, loadVector(out) + sum[j][0]);
+                storeVector(out + VectorFloats, loadVector(out + VectorFloats) + sum[j][1]);
+            }
+        }
+
+        // Rows past the last full strip, one column of x at a time.
+        inline void axpyTail(Index rows, Index k, Index n, const float* x, Index ldx,
+                             const float* y, Index ldy, float* acc, Index ldacc) {
+            for (Index p = 0; p < k; ++p) {
+                const float* __restrict xp = x + p * ldx;
+                for (Index j = 0; j < n; ++j) {
+                    const float yp = y[p + j * ldy];
+                    float* __restrict out = acc + j * ldacc;
+                    for (Index i = 0; i < rows; ++i) {
+                        out[i] += xp[i] * yp;
+                    }
+                }
+            }
+        }
+
+        // Column-major x in slices of KBlock columns: each slice is read as long contiguous
+        // column segments and stays in L1 while its strips are swept by y four columns at a time.
+        inline void skinnyAxpy(Index rows, Index k, Index n, const float* x, Index ldx,
+                               const float* y, Index ldy, float* acc, Index ldacc) {
+            constexpr Index KBlock = 16;
+            const Index strips = rows / StripRows * StripRows;
+            for (Index p0 = 0; p0 < k; p0 += KBlock) {
+                const Index kb = std::min(KBlock, k - p0);
+                const float* xBlock = x + p0 * ldx;
+                const float* yBlock = y + p0;
+                for (Index i = 0; i < strips; i += StripRows) {
+                    Index j = 0;
+                    for (; j + 4 <= n; j += 4) {
+                        axpyStrip<4>(kb, xBlock + i, ldx, yBlock + j * ldy, ldy, acc + i + j * ldacc, ldacc);
+                    }
+                    if (n - j >= 2) {
+                        axpyStrip<2>(kb, xBlock + i, ldx, yBlock + j * ldy, ldy, acc + i + j * ldacc, ldacc);
+                        j += 2;
+                    }
+                    if (n - j == 1) {
+                        axpyStrip<1>(kb, xBlock + i, ldx, yBlock + j * ldy, ldy, acc + i + j * ldacc, ldacc);
+                    }
+                }
+                if (strips < rows) {
+                    axpyTail(rows - strips, kb, n, xBlock + strips, ldx, yBlock, ldy, acc + strips, ldacc);
+                }
+            }
+        }
+
+        // Dot products of four rows of x at a time with each column of y, in Lanes independent
+        // partial sums per row so the reduction vectorizes without reassociation flags.
+        inline void skinnyDotBlock(Index rows, Index k, Index n, const float* x, Index ldx,
+                                   const float* y, Index ldy, float* acc, Index ldacc) {
+            constexpr Index Lanes = 16;
+            const Index kv = k / Lanes * Lanes;
+            Index i = 0;
+            for (; i + 4 <= rows; i += 4) {
+                const float* __restrict x0 = x + i * ldx;
+                const float* __restrict x1 = x0 + ldx;
+                const float* __restrict x2 = x1 + ldx;
+                const float* __restrict x3 = x2 + ldx;
+                for (Index j = 0; j < n; ++j) {
+                    const float* __restrict yj = y + j * ldy;
+                    float s0[Lanes] = {}, s1[Lanes] = {}, s2[Lanes] = {}, s3[Lanes] = {};
+                    for (Index p = 0; p < kv; p += Lanes) {
+                        for (Index l = 0; l < Lanes; ++l) {
+                            const float yp = yj[p + l];
+                            s0[l] += x0[p + l] * yp;
+                            s1[l] += x1[p + l] * yp;
+                            s2[l] += x2[p + l] * yp;
+                            s3[l] += x3[p + l] * yp;
+                        }
+                    }
+                    float t0 = 0.0f, t1 = 0.0f, t2 = 0.0f, t3 = 0.0f;
+                    for (Index l = 0; l < Lanes; ++l) {
+                        t0 += s0[l];
+                        t1 += s1[l];
+                        t2 += s2[l];
+                        t3 += s3[l];
+                    }
+                    for (Index p = kv; p < k; ++p) {
+                        t0 += x0[p] * yj[p];
+                        t1 += x1[p] * yj[p];
+                        t2 += x2[p] * yj[p];
+                        t3 += x3[p] * yj[p];
+                    }
+                    float* out = acc + i + j * ldacc;
+                    out[0] += t0;
+                    out[1] += t1;
+                    out[2] += t2;
+                    out[3] += t3;
+                }
+            }
+            for (; i < rows; ++i) {
+                const float* __restrict xi = x + i * ldx;
+                for (Index j = 0; j < n; ++j) {
+                    const float* __restrict yj = y + j * ldy;
+                    float s[Lanes] = {};
+                    for (Index p = 0; p < kv; p += Lanes) {
+                        for (Index l = 0; l < Lanes; ++l) {
+                            s[l] += xi[p + l] * yj[p + l];
+                        }
+                    }
+                    float t = 0.0f;
+                    for (Index l = 0; l < Lanes; ++l) {
+                        t += s[l];
+                    }
+                    for (Index p = kv; p < k; ++p) {
+                        t += xi[p] * yj[p];
+                    }
+                    acc[i + j * ldacc] += t;
+                }
+            }
+        }
+
+        // Slices of k short enough that four rows of x stay in L1 across every column of y.
+        inline void skinnyDot(Index rows, Index k, Index n, const float* x, Index ldx,
+                              const float* y, Index ldy, float* acc, Index ldacc) {
+            constexpr Index KBlock = 512;
+            for (Index p = 0; p < k; p += KBlock) {
+                skinnyDotBlock(rows, std::min(KBlock, k - p), n, x + p, ldx, y + p, ldy, acc, ldacc);
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,49 @@
+#include "small_gemm.hpp"
+#include "cpu_features.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        int sizeIndex(Index size) {
+            switch (size) {
+                case 4:  return 0;
+                case 8:  return 1;
+                case 16: return 2;
+                case 32: return 3;
+                case 64: return 4;
+                default: return -1;
+            }
+        }
+
+        struct SmallGemmDispatch {
+            SmallGemmTable table{};
+
+            SmallGemmDispatch() {
+#ifdef WITH_X86_KERNELS
+                const CpuFeatures& features = CpuFeatures::get();
+                if (features.avx512f) {
+                    fillSmallGemmTableAvx512(table);
+                    return;
+                }
+                if (features.avx2 && features.fma) {
+                    fillSmallGemmTableAvx2(table);
+                    return;
+                }
+#endif
+                fillSmallGemmTableScalar(table);
+            }
+        };
+    }
+
+    SmallGemmFn smallGemmKernel(Index m, Index n, Index k) {
+        static const SmallGemmDispatch dispatch;
+        const int mi = sizeIndex(m), ni = sizeIndex(n), ki = sizeIndex(k);
+        if (mi < 0 || ni < 0 || ki < 0) {
+            return nullptr;
+        }
+        return dispatch.table[mi][ni][ki];
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // C = A * B for one small column-major product whose dimensions are fixed at compile time.
+    using SmallGemmFn = void (*)(const float* a, Index lda, const float* b, Index ldb, float* c, Index ldc);
+
+    // Returns the unrolled kernel for an (m x k) * (k x n) product when m, n and k are each one
+    // of 4, 8, 16, 32 or 64, built for the widest ISA the host supports; nullptr otherwise.
+    SmallGemmFn smallGemmKernel(Index m, Index n, Index k);
+
+    // Per-ISA kernel tables indexed [m][n][k] by size class, filled by small_gemm_<isa>.cpp.
+    constexpr int SmallGemmSizeCount = 5;
+    using SmallGemmTable = SmallGemmFn[SmallGemmSizeCount][SmallGemmSizeCount][SmallGemmSizeCount];
+
+    void fillSmallGemmTableScalar(SmallGemmTable& table);
+#ifdef WITH_X86_KERNELS
+    void fillSmallGemmTableAvx2(SmallGemmTable& table);
+    void fillSmallGemmTableAvx512(SmallGemmTable& table);
+#endif
+
+} // namespace Kernels
+} // namespace MatrixTransform
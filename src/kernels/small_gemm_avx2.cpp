@@ -0,0 +1,11 @@
+#include "small_gemm_impl.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    void fillSmallGemmTableAvx2(SmallGemmTable& table) {
+        fillSmallGemmTable(table);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
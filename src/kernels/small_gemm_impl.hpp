@@ -0,0 +1,95 @@
+#pragma once
+
+// Included once by each per-ISA small_gemm_<isa>.cpp. Everything here has internal linkage,
+// so every translation unit gets its own copy compiled for its own instruction set.
+
+#include "small_gemm.hpp"
+#include <cstring>
+#include <utility>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index SmallGemmSizes[SmallGemmSizeCount] = {4, 8, 16, 32, 64};
+
+#if defined(__AVX512F__)
+        constexpr Index VectorFloats = 16;
+#elif defined(__AVX2__)
+        constexpr Index VectorFloats = 8;
+#else
+        constexpr Index VectorFloats = 4;
+#endif
+
+        // GCC/Clang vector extensions: the same source becomes SSE, AVX2 or AVX-512 code
+        // depending on the flags of the including translation unit.
+        template <Index W>
+        struct VectorOf {
+            typedef float type __attribute__((vector_size(W * sizeof(float))));
+        };
+
+        template <Index W>
+        using Vector = typename VectorOf<W>::type;
+
+        template <Index W>
+        Vector<W> loadVector(const float* source) {
+            Vector<W> v;
+            std::memcpy(&v, source, sizeof(v));
+            return v;
+        }
+
+        template <Index W>
+        void storeVector(float* destination, const Vector<W>& v) {
+            std::memcpy(destination, &v, sizeof(v));
+        }
+
+        constexpr Index minIndex(Index x, Index y) { return x < y ? x : y; }
+
+        // The compile-time trip counts let the compiler keep a block of up to two row vectors
+        // by four columns of C in registers and unroll the rank-1 updates completely.
+        template <Index M, Index N, Index K>
+        void smallGemm(const float* a, Index lda, const float* b, Index ldb, float* c, Index ldc) {
+            constexpr Index W = minIndex(M, VectorFloats);
+            constexpr Index MV = minIndex(M / W, 2);
+            constexpr Index MB = MV * W;
+            constexpr Index NB = minIndex(N, 4);
+
+            for (Index j0 = 0; j0 < N; j0 += NB) {
+                for (Index i0 = 0; i0 < M; i0 += MB) {
+                    Vector<W> acc[NB][MV] = {};
+                    for (Index p = 0; p < K; ++p) {
+                        const float* ap = a + i0 + p * lda;
+                        Vector<W> av[MV];
+                        for (Index v = 0; v < MV; ++v) {
+                            av[v] = loadVector<W>(ap + v * W);
+                        }
+                        for (Index j = 0; j < NB; ++j) {
+                            const float bpj = b[p + (j0 + j) * ldb];
+                            for (Index v = 0; v < MV; ++v) {
+                                acc[j][v] += av[v] * bpj;
+                            }
+                        }
+                    }
+                    for (Index j = 0; j < NB; ++j) {
+                        for (Index v = 0; v < MV; ++v) {
+                            storeVector<W>(c + i0 + v * W + (j0 + j) * ldc, acc[j][v]);
+                        }
+                    }
+                }
+            }
+        }
+
+        template <std::size_t... Ids>
+        void fillSmallGemmTable(SmallGemmTable& table, std::index_sequence<Ids...>) {
+            constexpr int S = SmallGemmSizeCount;
+            ((table[Ids / (S * S)][(Ids / S) % S][Ids % S] =
+                  &smallGemm<SmallGemmSizes[Ids / (S * S)], SmallGemmSizes[(Ids / S) % S], SmallGemmSizes[Ids % S]>), ...);
+        }
+
+        inline void fillSmallGemmTable(SmallGemmTable& table) {
+            fillSmallGemmTable(table, std::make_index_sequence<SmallGemmSizeCount * SmallGemmSizeCount * SmallGemmSizeCount>{});
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,11 @@
+#include "small_gemm_impl.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    void fillSmallGemmTableScalar(SmallGemmTable& table) {
+        fillSmallGemmTable(table);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
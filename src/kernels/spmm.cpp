@@ -0,0 +1,129 @@
+#include "spmm.hpp"
+#include "workspace.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        constexpr Index RowChunk = 64;
+        constexpr Index TransposeTile = 16;
+        // Transposed B block kept L2 resident, since nonzeros address its rows at random.
+        constexpr Index BlockBytes = 512 * 1024;
+
+        SpmmRowFn selectRowKernel() {
+#ifdef WITH_X86_KERNELS
+            const CpuFeatures& features = CpuFeatures::get();
+            if (features.avx512f) {
+                return &spmmRowAvx512;
+            }
+            if (features.avx2 && features.fma) {
+                return &spmmRowAvx2;
+            }
+#endif
+            return &spmmRowScalar;
+        }
+    }
+
+    void spmm(Index m, Index n, Index k, const int* outer, const int* inner, const float* values,
+              float alpha, const float* b, Index ldb, float beta, float* c, Index ldc,
+              Workspace& workspace, const ThreadPlacement& placement, int threads) {
+        if (m == 0 || n == 0) {
+            return;
+        }
+        static const SpmmRowFn rowKernel = selectRowKernel();
+
+#ifdef _OPENMP
+        if (threads <= 0) {
+            threads = omp_get_max_threads();
+        }
+#else
+        threads = 1;
+#endif
+        // Columns of B per block: a multiple of 16 floats, between 16 and 512.
+        Index nb = BlockBytes / static_cast<Index>(sizeof(float) * std::max<Index>(k, 1)) / 16 * 16;
+        nb = std::min(std::clamp<Index>(nb, 16, 512), (n + 15) / 16 * 16);
+
+        const TeamLayout* layout = teamLayout(placement, threads);
+        const int replicas = layout != nullptr && placement.numa == NumaMode::Replicate
+                                 ? static_cast<int>(layout->replicaSize.size()) : 1;
+
+        // Slots 0..replicas-1 hold the transposed B block (one per NUMA node when
+        // replicating), the next `threads` slots a row-major chunk of C per thread, which is
+        // written back column by column to keep the stores contiguous.
+        for (int r = 0; r < replicas; ++r) {
+            workspace.acquire(r, static_cast<std::size_t>(k * nb));
+        }
+        for (int t = 0; t < threads; ++t) {
+            workspace.acquire(replicas + t, static_cast<std::size_t>(RowChunk * nb));
+        }
+
+        #pragma omp parallel num_threads(threads)
+        {
+            int tid = 0;
+            int team = 1;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+            team = omp_get_num_threads();
+#endif
+            // A smaller team than requested does not match the layout; share replica 0 instead.
+            const TeamLayout* teamPlacement = team == threads ? layout : nullptr;
+            const bool replicate = replicas > 1 && teamPlacement != nullptr;
+            if (teamPlacement != nullptr) {
+                pinCurrentThread(teamPlacement->cpu[tid]);
+            }
+            const int replica = replicate ? teamPlacement->replica[tid] : 0;
+            float* bBlock = workspace.data(replica);
+            float* rows = workspace.data(replicas + tid);
+
+            for (Index j0 = 0; j0 < n; j0 += nb) {
+                const Index cols = std::min(nb, n - j0);
+                auto transpose = [&](Index p0) {
+                    const Index pEnd = std::min(k, p0 + TransposeTile);
+                    for (Index j = 0; j < cols; ++j) {
+                        const float* src = b + (j0 + j) * ldb;
+                        for (Index p = p0; p < pEnd; ++p) {
+                            bBlock[p * nb + j] = src[p];
+                        }
+                    }
+                };
+
+                if (replicate) {
+                    const Index stride = TransposeTile * teamPlacement->replicaSize[replica];
+                    for (Index p0 = TransposeTile * teamPlacement->replicaRank[tid]; p0 < k; p0 += stride) {
+                        transpose(p0);
+                    }
+                    #pragma omp barrier
+                } else {
+                    #pragma omp for schedule(static)
+                    for (Index p0 = 0; p0 < k; p0 += TransposeTile) {
+                        transpose(p0);
+                    }
+                }
+
+                #pragma omp for schedule(dynamic)
+                for (Index i0 = 0; i0 < m; i0 += RowChunk) {
+                    const Index iEnd = std::min(m, i0 + RowChunk);
+                    for (Index i = i0; i < iEnd; ++i) {
+                        rowKernel(outer[i + 1] - outer[i], inner + outer[i], values + outer[i], bBlock, nb, cols,
+                                  rows + (i - i0) * nb);
+                    }
+                    for (Index j = 0; j < cols; ++j) {
+                        float* cCol = c + (j0 + j) * ldc;
+                        for (Index i = i0; i < iEnd; ++i) {
+                            const float value = alpha * rows[(i - i0) * nb + j];
+                            cCol[i] = beta == 0.0f ? value : value + beta * cCol[i];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // out[0, n) = sum over t < nnz of values[t] * b[cols[t] * ldb + (0, n)], i.e. one row of a
+    // CSR matrix times a row-major dense block.
+    using SpmmRowFn = void (*)(Index nnz, const int* cols, const float* values,
+                               const float* b, Index ldb, Index n, float* out);
+
+    // Per-ISA row kernels, each defined in spmm_<isa>.cpp from spmm_impl.hpp.
+    void spmmRowScalar(Index nnz, const int* cols, const float* values,
+                       const float* b, Index ldb, Index n, float* out);
+#ifdef WITH_X86_KERNELS
+    void spmmRowAvx2(Index nnz, const int* cols, const float* values,
+                     const float* b, Index ldb, Index n, float* out);
+    void spmmRowAvx512(Index nnz, const int* cols, const float* values,
+                       const float* b, Index ldb, Index n, float* out);
+#endif
+
+    // C = alpha * A * B + beta * C for a CSR A (m x k, given by outer/inner/values as in
+    // Eigen's compressed row-major storage) and column-major dense B (k x n) and C (m x n).
+    // B is transposed one column block at a time into the workspace so every nonzero of A
+    // becomes a contiguous, vectorized axpy; rows of C are split across the OpenMP team.
+    // C is not read when beta == 0. placement pins the team and, in replicate mode, gives
+    // each NUMA node its own transposed block as in blockedGemm. threads == 0 uses the OpenMP
+    // default team size. outer may point into a larger matrix to multiply a range of its rows.
+    void spmm(Index m, Index n, Index k, const int* outer, const int* inner, const float* values,
+              float alpha, const float* b, Index ldb, float beta, float* c, Index ldc,
+              Workspace& workspace, const ThreadPlacement& placement = ThreadPlacement(), int threads = 0);
+
+} // namespace Kernels
+} // namespace MatrixTransform
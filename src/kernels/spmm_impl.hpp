@@ -0,0 +1,41 @@
+#pragma once
+
+// Included once by each per-ISA spmm_<isa>.cpp; the loops are written for the compiler's
+// auto-vectorizer, so each translation unit gets code for its own instruction set.
+
+#include "spmm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // Four nonzeros per pass over the output row, so each out[j] is loaded and stored once
+        // per four B rows instead of once per row.
+        inline void spmmRow(Index nnz, const int* cols, const float* values,
+                            const float* b, Index ldb, Index n, float* __restrict out) {
+            for (Index j = 0; j < n; ++j) {
+                out[j] = 0.0f;
+            }
+            Index t = 0;
+            for (; t + 4 <= nnz; t += 4) {
+                const float v0 = values[t], v1 = values[t + 1], v2 = values[t + 2], v3 = values[t + 3];
+                const float* __restrict b0 = b + cols[t] * ldb;
+                const float* __restrict b1 = b + cols[t + 1] * ldb;
+                const float* __restrict b2 = b + cols[t + 2] * ldb;
+                const float* __restrict b3 = b + cols[t + 3] * ldb;
+                for (Index j = 0; j < n; ++j) {
+                    out[j] += v0 * b0[j] + v1 * b1[j] + v2 * b2[j] + v3 * b3[j];
+                }
+            }
+            for (; t < nnz; ++t) {
+                const float v = values[t];
+                const float* __restrict row = b + cols[t] * ldb;
+                for (Index j = 0; j < n; ++j) {
+                    out[j] += v * row[j];
+                }
+            }
+        }
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
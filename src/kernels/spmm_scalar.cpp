@@ -0,0 +1,12 @@
+#include "spmm_impl.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    void spmmRowScalar(Index nnz, const int* cols, const float* values,
+                       const float* b, Index ldb, Index n, float* out) {
+        spmmRow(nnz, cols, values, b, ldb, n, out);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
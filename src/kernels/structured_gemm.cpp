@@ -0,0 +1,165 @@
+#include "structured_gemm.hpp"
+#include "aligned_buffer.hpp"
+#include "workspace.hpp"
+#include <algorithm>
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    namespace {
+        // Diagonal blocks up to this size are computed as dense products; the redundant half
+        // of those blocks is about DiagonalBlock / n of the total work.
+        constexpr Index DiagonalBlock = 128;
+
+        // Scratch for the diagonal blocks; the workspace slots belong to blockedGemm.
+        float* scratch(std::size_t count) {
+            thread_local AlignedBuffer<float> buffer;
+            buffer.reserve(count);
+            return buffer.data();
+        }
+
+        // Splits a diagonal range in two at a multiple of the register tile.
+        Index half(const MicroKernel& kernel, Index size) {
+            return std::max(kernel.mr, size / 2 / kernel.mr * kernel.mr);
+        }
+
+        struct SyrkProblem {
+            const MicroKernel& kernel;
+            Index k;
+            float alpha;
+            const float* a;
+            Index rsA, csA;
+            float beta;
+            float* c;
+            Index ldc;
+            bool lower;
+            Workspace& workspace;
+            int threads;
+            const ThreadPlacement& placement;
+        };
+
+        // Updates the triangle of the diagonal block C[j0:j0+size, j0:j0+size]. The block is
+        // halved until it is small, so the off-diagonal quarters are large products and the
+        // redundant work stays on the small diagonal blocks, whose opposite half is saved and
+        // put back around a dense product.
+        void syrkBlock(const SyrkProblem& p, Index j0, Index size) {
+            float* diagonal = p.c + j0 + j0 * p.ldc;
+            const float* rows = p.a + j0 * p.rsA;
+            if (size <= DiagonalBlock) {
+                float* saved = scratch(static_cast<std::size_t>(size * size));
+                for (Index j = 0; j < size; ++j) {
+                    for (Index i = 0; i < size; ++i) {
+                        if (p.lower ? i < j : i > j) {
+                            saved[i + j * size] = diagonal[i + j * p.ldc];
+                        }
+                    }
+                }
+                blockedGemm(p.kernel, size, size, p.k, p.alpha, rows, p.rsA, p.csA, rows, p.csA, p.rsA,
+                            p.beta, diagonal, p.ldc, p.workspace, p.threads, p.placement);
+                for (Index j = 0; j < size; ++j) {
+                    for (Index i = 0; i < size; ++i) {
+                        if (p.lower ? i < j : i > j) {
+                            diagonal[i + j * p.ldc] = saved[i + j * size];
+                        }
+                    }
+                }
+                return;
+            }
+
+            // A^T is read through swapped strides of the same rows of A.
+            const Index h = half(p.kernel, size);
+            const float* second = rows + h * p.rsA;
+            if (p.lower) {
+                blockedGemm(p.kernel, size - h, h, p.k, p.alpha, second, p.rsA, p.csA, rows, p.csA, p.rsA,
+                            p.beta, diagonal + h, p.ldc, p.workspace, p.threads, p.placement);
+            } else {
+                blockedGemm(p.kernel, h, size - h, p.k, p.alpha, rows, p.rsA, p.csA, second, p.csA, p.rsA,
+                            p.beta, diagonal + h * p.ldc, p.ldc, p.workspace, p.threads, p.placement);
+            }
+            syrkBlock(p, j0, h);
+            syrkBlock(p, j0 + h, size - h);
+        }
+
+        struct TrmmProblem {
+            const MicroKernel& kernel;
+            Index n;
+            float alpha;
+            const float* a;
+            Index rsA, csA;
+            bool lower;
+            bool unitDiagonal;
+            const float* b;
+            Index rsB, csB;
+            float* c;
+            Index ldc;
+            Workspace& workspace;
+            int threads;
+            const ThreadPlacement& placement;
+        };
+
+        // C[i0:i0+size, :] = alpha * T[i0:i0+size, i0:i0+size] * B[i0:i0+size, :] + beta * C,
+        // halving the diagonal block as in syrkBlock: T11 and T22 recurse and the off-diagonal
+        // block of T is a plain product. Small diagonal blocks are copied with their opposite
+        // half zeroed and multiplied densely.
+        void trmmBlock(const TrmmProblem& p, Index i0, Index size, float beta) {
+            const float* diagonal = p.a + i0 * p.rsA + i0 * p.csA;
+            float* out = p.c + i0;
+            if (size <= DiagonalBlock) {
+                float* factor = scratch(static_cast<std::size_t>(size * size));
+                for (Index j = 0; j < size; ++j) {
+                    for (Index i = 0; i < size; ++i) {
+                        float value = diagonal[i * p.rsA + j * p.csA];
+                        if (i == j && p.unitDiagonal) {
+                            value = 1.0f;
+                        } else if (p.lower ? i < j : i > j) {
+                            value = 0.0f;
+                        }
+                        factor[i + j * size] = value;
+                    }
+                }
+                blockedGemm(p.kernel, size, p.n, size, p.alpha, factor, Index(1), size,
+                            p.b + i0 * p.rsB, p.rsB, p.csB, beta, out, p.ldc, p.workspace, p.threads, p.placement);
+                return;
+            }
+
+            const Index h = half(p.kernel, size);
+            if (p.lower) {
+                // C2 = T21 * B1 + T22 * B2, C1 = T11 * B1.
+                blockedGemm(p.kernel, size - h, p.n, h, p.alpha, diagonal + h * p.rsA, p.rsA, p.csA,
+                            p.b + i0 * p.rsB, p.rsB, p.csB, beta, out + h, p.ldc, p.workspace, p.threads, p.placement);
+                trmmBlock(p, i0 + h, size - h, 1.0f);
+                trmmBlock(p, i0, h, beta);
+            } else {
+                // C1 = T11 * B1 + T12 * B2, C2 = T22 * B2.
+                blockedGemm(p.kernel, h, p.n, size - h, p.alpha, diagonal + h * p.csA, p.rsA, p.csA,
+                            p.b + (i0 + h) * p.rsB, p.rsB, p.csB, beta, out, p.ldc, p.workspace, p.threads, p.placement);
+                trmmBlock(p, i0, h, 1.0f);
+                trmmBlock(p, i0 + h, size - h, beta);
+            }
+        }
+    }
+
+    void blockedSyrk(const MicroKernel& kernel, Index n, Index k,
+                     float alpha, const float* a, Index rsA, Index csA,
+                     float beta, float* c, Index ldc, bool lower, Workspace& workspace, int threads,
+                     const ThreadPlacement& placement) {
+        if (n == 0) {
+            return;
+        }
+        syrkBlock(SyrkProblem{kernel, k, alpha, a, rsA, csA, beta, c, ldc, lower, workspace, threads, placement}, 0, n);
+    }
+
+    void blockedTrmm(const MicroKernel& kernel, Index m, Index n,
+                     float alpha, const float* a, Index rsA, Index csA, bool lower, bool unitDiagonal,
+                     const float* b, Index rsB, Index csB,
+                     float beta, float* c, Index ldc, Workspace& workspace, int threads,
+                     const ThreadPlacement& placement) {
+        if (m == 0 || n == 0) {
+            return;
+        }
+        trmmBlock(TrmmProblem{kernel, n, alpha, a, rsA, csA, lower, unitDiagonal, b, rsB, csB, c, ldc,
+                              workspace, threads, placement}, 0, m, beta);
+    }
+
+} // namespace Kernels
+} // namespace MatrixTransform
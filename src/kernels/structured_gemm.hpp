@@ -0,0 +1,29 @@
+#pragma once
+
+#include "blocked_gemm.hpp"
+
+namespace MatrixTransform {
+namespace Kernels {
+
+    // Products whose result or left operand is triangular, built on blockedGemm so they share
+    // its packing, register kernels and threading but skip the blocks the structure makes
+    // redundant: about half the flops of the equivalent general product.
+
+    // SYRK: C = alpha * A * A^T + beta * C on the lower (or upper) triangle of the n x n
+    // column-major C, for a strided n x k A. The other triangle of C is left untouched.
+    void blockedSyrk(const MicroKernel& kernel, Index n, Index k,
+                     float alpha, const float* a, Index rsA, Index csA,
+                     float beta, float* c, Index ldc, bool lower, Workspace& workspace, int threads = 0,
+                     const ThreadPlacement& placement = ThreadPlacement());
+
+    // TRMM: C = alpha * T * B + beta * C, where T is the lower (or upper) triangle of the
+    // strided m x m A, with ones in place of its diagonal when unitDiagonal; the rest of A is
+    // never read. B is m x n and C is m x n column-major, not read when beta == 0.
+    void blockedTrmm(const MicroKernel& kernel, Index m, Index n,
+                     float alpha, const float* a, Index rsA, Index csA, bool lower, bool unitDiagonal,
+                     const float* b, Index rsB, Index csB,
+                     float beta, float* c, Index ldc, Workspace& workspace, int threads = 0,
+                     const ThreadPlacement& placement = ThreadPlacement());
+
+} // namespace Kernels
+} // namespace MatrixTransform
@@ -1,12 +1,81 @@
 #include <memory>
 #include <iostream>
+#include <fstream>
 #include <string>
+#include "nlohmann/json.hpp"
 #include "matrix_transform/matrix_types.hpp"
 #include "matrix_transform/interfaces.hpp"
 #include "matrix_transform/factory.hpp"
+#include "matrix_transform/metrics.hpp"
+#ifdef __unix__
+#include <csignal>
+#include "matrix_transform/out_of_core.hpp"
+#include "matrix_transform/batch_server.hpp"
+#endif
 
 using MatrixTransform::Factory;
 
+// Writes the metrics registry to the file named by "metrics": {"output": ...}, if any.
+static void writeMetrics(const nlohmann::json& config) {
+    if (!config.is_object() || !config.contains("metrics") || !config["metrics"].contains("output")) {
+        return;
+    }
+    try {
+        MatrixTransform::MetricsRegistry::getInstance().writeFile(config["metrics"]["output"].get<std::string>());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+#ifdef __unix__
+// Multiplies the tiled files named in the "out_of_core" config section: {"a", "b", "c",
+// "memory_budget_mb"}. C is created to fit A * B.
+static int runOutOfCore(MatrixTransform::IMultiplier& multiplier, const nlohmann::json& options) {
+    using MatrixTransform::TiledMatrixFile;
+    try {
+        TiledMatrixFile a = TiledMatrixFile::open(options.at("a").get<std::string>());
+        TiledMatrixFile b = TiledMatrixFile::open(options.at("b").get<std::string>());
+        TiledMatrixFile c = TiledMatrixFile::create(options.at("c").get<std::string>(), a.rows(), b.cols(), a.tileSize());
+        const std::size_t budget = options.value("memory_budget_mb", std::size_t(1024)) << 20;
+        MatrixTransform::OutOfCoreMultiplier(multiplier, budget).multiply(a, b, c);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static MatrixTransform::BatchServer* activeServer = nullptr;
+
+static void stopServer(int) {
+    if (activeServer != nullptr) {
+        activeServer->stop();
+    }
+}
+
+// Serves batched requests from local clients until SIGINT or SIGTERM. The "server" config
+// section: {"socket", "max_batch", "batch_window_us"}.
+static int runServer(MatrixTransform::IMultiplier& multiplier, const nlohmann::json& options) {
+    MatrixTransform::BatchServer::Options serverOptions;
+    serverOptions.socketPath = options.value("socket", serverOptions.socketPath);
+    serverOptions.maxBatch = options.value("max_batch", serverOptions.maxBatch);
+    serverOptions.batchWindow = std::chrono::microseconds(options.value("batch_window_us", serverOptions.batchWindow.count()));
+    try {
+        MatrixTransform::BatchServer server(multiplier, serverOptions);
+        activeServer = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        server.run();
+        activeServer = nullptr;
+    } catch (const std::exception& e) {
+        activeServer = nullptr;
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 int main(int argc, char const *argv[])
 {
     std::string configFilePath;
@@ -23,6 +92,21 @@ int main(int argc, char const *argv[])
     std::unique_ptr<MatrixTransform::IMultiplier> multiplier;
     multiplier = Factory::createMultiplier(configFilePath);
 
+    std::ifstream configFile(configFilePath);
+    const nlohmann::json config = nlohmann::json::parse(configFile, nullptr, false);
+#ifdef __unix__
+    if (config.is_object() && config.contains("out_of_core")) {
+        const int status = runOutOfCore(*multiplier, config["out_of_core"]);
+        writeMetrics(config);
+        return status;
+    }
+    if (config.is_object() && config.contains("server")) {
+        const int status = runServer(*multiplier, config["server"]);
+        writeMetrics(config);
+        return status;
+    }
+#endif
+
     Matrix a(1000, 1000);
     Matrix b(1000, 1000);
 
@@ -34,6 +118,7 @@ int main(int argc, char const *argv[])
     } catch (const std::invalid_argument& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }
-    
+
+    writeMetrics(config);
     return 0;
 }
\ No newline at end of file
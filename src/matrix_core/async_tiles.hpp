@@ -0,0 +1,22 @@
+#pragma once
+#include "matrix_transform/matrix_types.hpp"
+#include <functional>
+#include <future>
+
+namespace MatrixTransform {
+
+    // Writes rows [row, row + rows) x columns [col, col + cols) of c in place. Called on pool
+    // workers, concurrently with the other tiles of the same product, so it must only touch its
+    // own tile and state it owns by capture.
+    using AsyncTileFn = std::function<void(Eigen::Index row, Eigen::Index col, Eigen::Index rows, Eigen::Index cols, Matrix& c)>;
+
+    // The tiling behind IMultiplier::multiplyAsync: splits an m x n product into output tiles
+    // on the shared ThreadPool and resolves the future with C once every tile has run, or
+    // with the first exception a tile threw. Backends with their own arithmetic pass a tile
+    // function that runs it single-threaded.
+    std::future<Matrix> multiplyTilesAsync(Eigen::Index m, Eigen::Index n, AsyncTileFn runTile);
+
+    // Runs a whole product as one pool task, for backends that cannot split it into CPU tiles.
+    std::future<Matrix> multiplyTaskAsync(std::function<Matrix()> task);
+
+} // namespace MatrixTransform
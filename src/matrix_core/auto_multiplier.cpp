@@ -0,0 +1,15 @@
+#include "logger.hpp"
+#include "auto_multiplier.hpp"
+#include "backend_plugin.hpp"
+#include "cpu_features.hpp"
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("AUTO", AutoMultiplier)
+
+    AutoMultiplier::AutoMultiplier() : BlockedMultiplier(Kernels::selectMicroKernel(), "AUTO") {
+        Logger::getInstance().log(LogLevel::Info, "AUTO backend detected CPU features [{}], using kernel {}.",
+                                  CpuFeatures::get().toString(), kernel_.name);
+    }
+    
+} // namespace MatrixTransform
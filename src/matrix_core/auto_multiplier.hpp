@@ -0,0 +1,13 @@
+#pragma once
+#include "blocked_multiplier.hpp"
+
+namespace MatrixTransform {
+
+    // Blocked GEMM whose register kernel is chosen from the host's cpuid at construction,
+    // so a single build runs AVX-512, AVX2+FMA or scalar code without risking SIGILL.
+    class AutoMultiplier : public BlockedMultiplier {
+    public:
+        AutoMultiplier();
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,349 @@
+#include "logger.hpp"
+#include "serve_protocol.hpp"
+#include "matrix_transform/batch_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace MatrixTransform {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Shape = std::tuple<std::int64_t, std::int64_t, std::int64_t>;
+
+        // A client's shared buffer. Queued requests hold on to it, so a client may attach a new
+        // buffer or disconnect while its requests are still running.
+        struct Mapping {
+            char* base = nullptr;
+            std::size_t bytes = 0;
+
+            ~Mapping() {
+                if (base != nullptr) {
+                    munmap(base, bytes);
+                }
+            }
+
+            // True if a densely packed rows x cols float matrix at offset lies inside the buffer.
+            bool contains(std::uint64_t offset, std::int64_t rows, std::int64_t cols) const {
+                if (rows <= 0 || cols <= 0 || offset % sizeof(float) != 0) {
+                    return false;
+                }
+                const std::uint64_t extent = sizeof(float) * static_cast<std::uint64_t>(rows) * static_cast<std::uint64_t>(cols);
+                return offset <= bytes && extent <= bytes - offset;
+            }
+        };
+
+        struct Client {
+            explicit Client(int socket) : socket(socket) {}
+            ~Client() { close(socket); }
+
+            // The poll loop and the scheduler both reply on the socket.
+            void reply(const ServeProtocol::Reply& reply) {
+                std::lock_guard<std::mutex> lock(sendMutex);
+                ServeProtocol::send(socket, reply);
+            }
+
+            const int socket;
+            std::shared_ptr<const Mapping> buffer;
+            std::mutex sendMutex;
+        };
+
+        struct Job {
+            std::shared_ptr<Client> client;
+            std::shared_ptr<const Mapping> buffer;
+            ServeProtocol::Request request;
+            Clock::time_point arrival;
+        };
+
+        ServeProtocol::Reply failure(std::uint64_t id, const std::string& message) {
+            ServeProtocol::Reply reply{};
+            reply.id = id;
+            reply.status = 1;
+            std::strncpy(reply.message, message.c_str(), sizeof(reply.message) - 1);
+            return reply;
+        }
+    }
+
+    struct BatchServer::State {
+        IMultiplier& backend;
+        Options options;
+        int wakeup[2] = {-1, -1};
+        std::atomic<bool> stopping{false};
+
+        std::mutex mutex;
+        std::condition_variable pendingChanged;
+        std::map<Shape, std::vector<Job>> pending;
+        bool draining = false;
+
+        State(IMultiplier& backend, Options options) : backend(backend), options(std::move(options)) {}
+
+        void schedule();
+        void execute(std::vector<Job>& batch);
+        void attach(Client& client, const ServeProtocol::Request& request, int fd);
+        void enqueue(const std::shared_ptr<Client>& client, const ServeProtocol::Request& request);
+    };
+
+    BatchServer::BatchServer(IMultiplier& backend, Options options)
+        : state_(std::make_unique<State>(backend, std::move(options))) {
+        state_->options.maxBatch = std::max<std::size_t>(1, state_->options.maxBatch);
+        if (pipe2(state_->wakeup, O_CLOEXEC | O_NONBLOCK) != 0) {
+            throw std::runtime_error(std::string("BatchServer: pipe: ") + std::strerror(errno));
+        }
+    }
+
+    BatchServer::~BatchServer() {
+        close(state_->wakeup[0]);
+        close(state_->wakeup[1]);
+    }
+
+    void BatchServer::stop() {
+        state_->stopping.store(true);
+        const char byte = 0;
+        [[maybe_unused]] const ssize_t written = write(state_->wakeup[1], &byte, 1);
+    }
+
+    void BatchServer::run() {
+        State& state = *state_;
+        const std::string& path = state.options.socketPath;
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("BatchServer: socket path is too long: " + path);
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        const int listener = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        unlink(path.c_str());
+        if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener, SOMAXCONN) != 0) {
+            const std::string error = std::strerror(errno);
+            if (listener >= 0) {
+                close(listener);
+            }
+            Logger::getInstance().log(LogLevel::Error, "BatchServer: cannot listen on {}: {}", path, error);
+            throw std::runtime_error("BatchServer: cannot listen on " + path + ": " + error);
+        }
+        Logger::getInstance().log(LogLevel::Info, "Serving on {} (max batch {}, window {} us).",
+                                  path, state.options.maxBatch, state.options.batchWindow.count());
+
+        state.draining = false;
+        std::thread scheduler([&state]() { state.schedule(); });
+
+        std::vector<std::shared_ptr<Client>> clients;
+        std::vector<pollfd> descriptors;
+        while (!state.stopping.load()) {
+            descriptors.assign({{state.wakeup[0], POLLIN, 0}, {listener, POLLIN, 0}});
+            for (const std::shared_ptr<Client>& client : clients) {
+                descriptors.push_back({client->socket, POLLIN, 0});
+            }
+            if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                Logger::getInstance().log(LogLevel::Error, "BatchServer: poll: {}", std::strerror(errno));
+                break;
+            }
+            if (descriptors[1].revents & POLLIN) {
+                const int socket = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (socket >= 0) {
+                    clients.push_back(std::make_shared<Client>(socket));
+                    Logger::getInstance().log(LogLevel::Debug, "BatchServer: client connected ({} open).", clients.size());
+                }
+            }
+
+            // Clients accepted above are polled from the next round on.
+            std::vector<std::shared_ptr<Client>> open;
+            for (std::size_t i = 2; i < descriptors.size(); ++i) {
+                const std::shared_ptr<Client>& client = clients[i - 2];
+                if (descriptors[i].revents == 0) {
+                    open.push_back(client);
+                    continue;
+                }
+                ServeProtocol::Request request{};
+                int fd = -1;
+                if (!(descriptors[i].revents & POLLIN) || !ServeProtocol::receiveWithDescriptor(client->socket, request, fd)) {
+                    if (fd >= 0) {
+                        close(fd);
+                    }
+                    continue;
+                }
+                open.push_back(client);
+                if (request.version != ServeProtocol::Version) {
+                    client->reply(failure(request.id, "protocol version mismatch"));
+                } else if (request.op == ServeProtocol::Op::Attach) {
+                    state.attach(*client, request, fd);
+                    fd = -1;
+                } else if (request.op == ServeProtocol::Op::Multiply) {
+                    state.enqueue(client, request);
+                } else {
+                    client->reply(failure(request.id, "unknown request"));
+                }
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+            for (std::size_t i = descriptors.size() - 2; i < clients.size(); ++i) {
+                open.push_back(clients[i]);
+            }
+            clients.swap(open);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.draining = true;
+        }
+        state.pendingChanged.notify_all();
+        scheduler.join();
+        close(listener);
+        unlink(path.c_str());
+        Logger::getInstance().log(LogLevel::Info, "Stopped serving on {}.", path);
+    }
+
+    void BatchServer::State::attach(Client& client, const ServeProtocol::Request& request, int fd) {
+        if (fd < 0) {
+            client.reply(failure(request.id, "attach carries no file descriptor"));
+            return;
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || request.bufferBytes == 0 || static_cast<std::uint64_t>(info.st_size) < request.bufferBytes) {
+            close(fd);
+            client.reply(failure(request.id, "buffer is smaller than the requested size"));
+            return;
+        }
+        void* base = mmap(nullptr, request.bufferBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            client.reply(failure(request.id, std::string("mmap: ") + std::strerror(errno)));
+            return;
+        }
+        auto mapping = std::make_shared<Mapping>();
+        mapping->base = static_cast<char*>(base);
+        mapping->bytes = request.bufferBytes;
+        client.buffer = std::move(mapping);
+
+        ServeProtocol::Reply reply{};
+        reply.id = request.id;
+        client.reply(reply);
+    }
+
+    void BatchServer::State::enqueue(const std::shared_ptr<Client>& client, const ServeProtocol::Request& request) {
+        const std::shared_ptr<const Mapping>& buffer = client->buffer;
+        if (!buffer) {
+            client->reply(failure(request.id, "no buffer attached"));
+            return;
+        }
+        if (!buffer->contains(request.aOffset, request.m, request.k) ||
+            !buffer->contains(request.bOffset, request.k, request.n) ||
+            !buffer->contains(request.cOffset, request.m, request.n)) {
+            client->reply(failure(request.id, "request addresses memory outside the buffer"));
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending[Shape(request.m, request.n, request.k)].push_back({client, buffer, request, Clock::now()});
+        }
+        pendingChanged.notify_one();
+    }
+
+    void BatchServer::State::schedule() {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<Job> batch;
+        for (;;) {
+            if (draining) {
+                break;
+            }
+            // Among the groups that are full or out of window, run the one waiting longest.
+            const Clock::time_point now = Clock::now();
+            Clock::time_point deadline = Clock::time_point::max();
+            auto ready = pending.end();
+            for (auto it = pending.begin(); it != pending.end(); ++it) {
+                const Clock::time_point due = it->second.front().arrival + options.batchWindow;
+                if (it->second.size() >= options.maxBatch || due <= now) {
+                    if (ready == pending.end() || it->second.front().arrival < ready->second.front().arrival) {
+                        ready = it;
+                    }
+                } else {
+                    deadline = std::min(deadline, due);
+                }
+            }
+            if (ready == pending.end()) {
+                if (deadline == Clock::time_point::max()) {
+                    pendingChanged.wait(lock);
+                } else {
+                    pendingChanged.wait_until(lock, deadline);
+                }
+                continue;
+            }
+
+            std::vector<Job>& group = ready->second;
+            const std::size_t count = std::min(group.size(), options.maxBatch);
+            batch.assign(std::make_move_iterator(group.begin()), std::make_move_iterator(group.begin() + count));
+            group.erase(group.begin(), group.begin() + count);
+            if (group.empty()) {
+                pending.erase(ready);
+            }
+
+            lock.unlock();
+            execute(batch);
+            batch.clear();
+            lock.lock();
+        }
+
+        for (auto& entry : pending) {
+            for (Job& job : entry.second) {
+                job.client->reply(failure(job.request.id, "server is shutting down"));
+            }
+        }
+        pending.clear();
+    }
+
+    void BatchServer::State::execute(std::vector<Job>& batch) {
+        std::vector<ConstMatrixView> a, b;
+        std::vector<MatrixView> c;
+        for (const Job& job : batch) {
+            const ServeProtocol::Request& r = job.request;
+            char* base = job.buffer->base;
+            a.emplace_back(reinterpret_cast<const float*>(base + r.aOffset), r.m, r.k, r.m);
+            b.emplace_back(reinterpret_cast<const float*>(base + r.bOffset), r.k, r.n, r.k);
+            c.emplace_back(reinterpret_cast<float*>(base + r.cOffset), r.m, r.n, r.m);
+        }
+
+        const ServeProtocol::Request& shape = batch.front().request;
+        Logger::getInstance().log(LogLevel::Debug, "Serving a batch of {} {}x{}x{} products.", batch.size(), shape.m, shape.n, shape.k);
+
+        const Clock::time_point start = Clock::now();
+        std::string error;
+        try {
+            backend.multiplyBatch(a.data(), b.data(), c.data(), batch.size());
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        const Clock::time_point end = Clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+
+        for (const Job& job : batch) {
+            ServeProtocol::Reply reply = error.empty() ? ServeProtocol::Reply{} : failure(job.request.id, error);
+            reply.id = job.request.id;
+            reply.batchSize = static_cast<std::uint32_t>(batch.size());
+            reply.queueSeconds = std::chrono::duration<double>(start - job.arrival).count();
+            reply.computeSeconds = seconds;
+            job.client->reply(reply);
+        }
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,160 @@
+#include <Eigen/Dense>
+#include "logger.hpp"
+#include "best_multiplier.hpp"
+#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
+#include "configurable.hpp"
+#include "tuning_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("BEST", BestMultiplier)
+
+    namespace {
+        constexpr int TimedRuns = 3;
+        // A candidate whose first run is this much slower than the current best is not re-run.
+        constexpr double PruneFactor = 1.5;
+
+        // Only in-process dense fp32 backends are timed. Never timed: meta-backends that
+        // dispatch to other backends, the unvectorized reference, sparse backends and the
+        // multi-process SHARDED backend. Backends without Precision::Float32 are skipped too.
+        bool excludedFromTuning(const std::string& backend) {
+            return backend == "BEST" || backend == "SPARSE_AUTO" || backend == "CPU" || backend == "SPARSE" ||
+                   backend == "SHARDED";
+        }
+    }
+
+    Matrix BestMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void BestMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        select(a, b).gemm(alpha, a, b, beta, c);
+    }
+
+    void BestMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        select(a, b).gemm(alpha, a, b, beta, c);
+    }
+
+    IMultiplier& BestMultiplier::select(ConstMatrixView a, ConstMatrixView b) {
+        const std::string bucket = TuningCache::bucketKey(a.rows(), b.cols(), a.cols());
+
+        std::optional<nlohmann::json> cached = TuningCache::getInstance().lookup(bucket);
+        if (cached) {
+            try {
+                const std::string backend = cached->at("backend");
+                IMultiplier& multiplier = instance(backend);
+                apply(multiplier, backend, cached->value("params", nlohmann::json::object()));
+                return multiplier;
+            } catch (const std::exception& e) {
+                Logger::getInstance().log(LogLevel::Warning, "Cached choice for {} is unusable ({}); re-tuning.", bucket, e.what());
+            }
+        }
+
+        nlohmann::json winner = tune(a, b);
+        TuningCache::getInstance().store(bucket, winner);
+        TuningCache::getInstance().save();
+
+        const std::string backend = winner.at("backend");
+        IMultiplier& multiplier = instance(backend);
+        apply(multiplier, backend, winner.at("params"));
+        return multiplier;
+    }
+
+    nlohmann::json BestMultiplier::tune(ConstMatrixView a, ConstMatrixView b) {
+        const std::string bucket = TuningCache::bucketKey(a.rows(), b.cols(), a.cols());
+        Logger::getInstance().log(LogLevel::Info, "BEST: tuning shape bucket {}.", bucket);
+
+        Matrix scratch(a.rows(), b.cols());
+        nlohmann::json winner;
+        double bestSeconds = std::numeric_limits<double>::infinity();
+
+        for (const std::string& backend : MultiplierRegistry::getInstance().registeredKeys()) {
+            if (excludedFromTuning(backend)) {
+                continue;
+            }
+
+            IMultiplier* multiplier = nullptr;
+            try {
+                multiplier = &instance(backend);
+            } catch (const std::exception& e) {
+                Logger::getInstance().log(LogLevel::Debug, "BEST: skipping backend {}: {}", backend, e.what());
+                continue;
+            }
+            if (multiplier->precision() != Precision::Float32) {
+                continue;
+            }
+
+            std::vector<nlohmann::json> candidates;
+            if (auto* configurable = dynamic_cast<IConfigurable*>(multiplier)) {
+                candidates = configurable->tuningCandidates(a.rows(), b.cols(), a.cols());
+            }
+            if (candidates.empty()) {
+                candidates.push_back(nlohmann::json::object());
+            }
+
+            for (const nlohmann::json& params : candidates) {
+                try {
+                    apply(*multiplier, backend, params);
+                    double seconds = std::numeric_limits<double>::infinity();
+                    for (int run = 0; run < TimedRuns; ++run) {
+                        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                        multiplier->gemm(1.0f, a, b, 0.0f, MatrixView(scratch));
+                        seconds = std::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                        if (seconds > PruneFactor * bestSeconds) {
+                            break;
+                        }
+                    }
+                    if (seconds < bestSeconds) {
+                        bestSeconds = seconds;
+                        winner = {{"backend", backend}, {"params", params}, {"seconds", seconds},
+                                  {"gflops", 2.0 * a.rows() * b.cols() * a.cols() / seconds / 1e9}};
+                    }
+                } catch (const std::exception& e) {
+                    Logger::getInstance().log(LogLevel::Debug, "BEST: candidate {} {} failed: {}", backend, params.dump(), e.what());
+                }
+            }
+        }
+
+        if (winner.is_null()) {
+            throw std::runtime_error("BEST: no registered backend could run a " + bucket + " product.");
+        }
+        Logger::getInstance().log(LogLevel::Info, "BEST: {} -> {} {}", bucket, winner["backend"].get<std::string>(), winner["params"].dump());
+        return winner;
+    }
+
+    IMultiplier& BestMultiplier::instance(const std::string& backend) {
+        auto it = instances_.find(backend);
+        if (it == instances_.end()) {
+            it = instances_.emplace(backend, MultiplierRegistry::getInstance().createMultiplier(backend)).first;
+        }
+        return *it->second;
+    }
+
+    void BestMultiplier::apply(IMultiplier& multiplier, const std::string& backend, const nlohmann::json& params) {
+        auto* configurable = dynamic_cast<IConfigurable*>(&multiplier);
+        if (configurable == nullptr) {
+            return;
+        }
+        auto it = appliedParams_.find(backend);
+        if (it != appliedParams_.end() && it->second == params) {
+            return;
+        }
+        configurable->configure(params);
+        appliedParams_[backend] = params;
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,31 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "matrix_transform/interfaces.hpp" 
+#include "nlohmann/json.hpp"
+
+namespace MatrixTransform {
+
+    // Meta-backend that dispatches each product to the fastest registered backend and tuning
+    // parameters for its shape bucket. Unknown buckets are tuned on first encounter by timing
+    // the in-process dense fp32 backends on the actual operands; winners go to the TuningCache.
+    class BestMultiplier : public IMultiplier {
+    public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+    private:
+        IMultiplier& select(ConstMatrixView a, ConstMatrixView b);
+        nlohmann::json tune(ConstMatrixView a, ConstMatrixView b);
+        IMultiplier& instance(const std::string& backend);
+        void apply(IMultiplier& multiplier, const std::string& backend, const nlohmann::json& params);
+
+        std::map<std::string, std::unique_ptr<IMultiplier>> instances_;
+        std::map<std::string, nlohmann::json> appliedParams_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,299 @@
+#include <Eigen/Dense>
+#include "logger.hpp"
+#include "blocked_multiplier.hpp"
+#include "aligned_buffer.hpp"
+#include "matrix_views.hpp"
+#include "epilogue_tile.hpp"
+#include <algorithm>
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+
+    namespace {
+        // B packed for one kernel and blocking; products against it run on that kernel.
+        class BlockedOperand : public PackedOperand {
+        public:
+            BlockedOperand(const Kernels::MicroKernel& kernel, ConstMatrixView b)
+                : PackedOperand(b.rows(), b.cols()), kernel(kernel),
+                  panels(Kernels::packedBSize(kernel, b.rows(), b.cols())) {
+                Kernels::packB(kernel, b.rows(), b.cols(), b.data(), b.rowStride(), b.colStride(), panels.data());
+            }
+
+            Matrix unpack() const override {
+                Matrix b(rows(), cols());
+                Kernels::unpackB(kernel, rows(), cols(), panels.data(), b.data(), b.outerStride());
+                return b;
+            }
+
+            const Kernels::MicroKernel kernel;
+            AlignedBuffer<float> panels;
+        };
+
+        Kernels::Index roundToMultiple(Kernels::Index value, Kernels::Index multiple) {
+            return std::max(multiple, (value + multiple / 2) / multiple * multiple);
+        }
+    }
+
+    BlockedMultiplier::BlockedMultiplier(const Kernels::MicroKernel& kernel, std::string label)
+        : defaultKernel_(kernel), kernel_(kernel), placement_(ThreadPlacement::global()), label_(std::move(label)) {}
+
+    Matrix BlockedMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void BlockedMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void BlockedMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} multiplication.", label_);
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        // GEMV and tall-skinny products stream A once instead of packing it; short-wide ones
+        // run the same kernels as C^T = B^T * A^T.
+        if (Kernels::skinnyApplies(b.cols(), a.rowStride(), a.colStride())) {
+            Kernels::skinnyGemm(a.rows(), b.cols(), a.cols(), alpha,
+                                a.data(), a.rowStride(), a.colStride(), b.data(), b.rowStride(), b.colStride(),
+                                beta, c.data(), c.rowStride(), c.colStride(), workspace_, threads_);
+        } else if (Kernels::skinnyApplies(a.rows(), b.colStride(), b.rowStride())) {
+            Kernels::skinnyGemm(b.cols(), a.rows(), a.cols(), alpha,
+                                b.data(), b.colStride(), b.rowStride(), a.data(), a.colStride(), a.rowStride(),
+                                beta, c.data(), c.colStride(), c.rowStride(), workspace_, threads_);
+        } else {
+            // Packing reads A and B through their strides, so any layout is consumed in place.
+            withColumnMajorOutput(a, b, beta, c, [&](ConstMatrixView lhs, ConstMatrixView rhs, float* out, Eigen::Index ldc) {
+                Kernels::blockedGemm(kernel_, lhs.rows(), rhs.cols(), lhs.cols(),
+                                     alpha, lhs.data(), lhs.rowStride(), lhs.colStride(),
+                                     rhs.data(), rhs.rowStride(), rhs.colStride(),
+                                     beta, out, ldc, workspace_, threads_, placement_);
+            });
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} multiplication complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    std::shared_ptr<const PackedOperand> BlockedMultiplier::prepare(ConstMatrixView b) {
+        return std::make_shared<BlockedOperand>(kernel_, b);
+    }
+
+    void BlockedMultiplier::gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) {
+        const auto* packed = dynamic_cast<const BlockedOperand*>(&b);
+        if (packed == nullptr) {
+            IMultiplier::gemm(alpha, a, b, beta, c);
+            return;
+        }
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} multiplication with a packed operand.", label_);
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        // MC only blocks A, so the current setting applies when the register kernel matches.
+        Kernels::MicroKernel kernel = packed->kernel;
+        if (kernel.compute == kernel_.compute) {
+            kernel.mc = kernel_.mc;
+        }
+        // The packed panels fix B on the right, so outputs that are not column-major are staged.
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::blockedGemmPacked(kernel, a.rows(), b.cols(), a.cols(),
+                                       alpha, a.data(), a.rowStride(), a.colStride(), packed->panels.data(),
+                                       beta, out, ldc, workspace_, threads_, placement_);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} multiplication complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    void BlockedMultiplier::gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} multiplication with an epilogue.", label_);
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols() ||
+            !Kernels::epilogueFits(epilogue, c.rows(), c.cols())) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        // A row-major C runs as the transposed product, so the epilogue is transposed with it.
+        if (!c.isColumnMajor() && c.colStride() == 1) {
+            const Epilogue transposed = Kernels::transposeEpilogue(epilogue);
+            Kernels::blockedGemm(kernel_, b.cols(), a.rows(), a.cols(),
+                                 epilogue.scale, b.data(), b.colStride(), b.rowStride(),
+                                 a.data(), a.colStride(), a.rowStride(),
+                                 0.0f, c.data(), c.rowStride(), workspace_, threads_, placement_, &transposed);
+        } else {
+            withColumnMajorStorage(0.0f, c, [&](float* out, Eigen::Index ldc) {
+                Kernels::blockedGemm(kernel_, a.rows(), b.cols(), a.cols(),
+                                     epilogue.scale, a.data(), a.rowStride(), a.colStride(),
+                                     b.data(), b.rowStride(), b.colStride(),
+                                     0.0f, out, ldc, workspace_, threads_, placement_, &epilogue);
+            });
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} multiplication complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    void BlockedMultiplier::gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue) {
+        const auto* packed = dynamic_cast<const BlockedOperand*>(&b);
+        if (packed == nullptr) {
+            IMultiplier::gemm(a, b, c, epilogue);
+            return;
+        }
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} multiplication with a packed operand and an epilogue.", label_);
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols() ||
+            !Kernels::epilogueFits(epilogue, c.rows(), c.cols())) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        Kernels::MicroKernel kernel = packed->kernel;
+        if (kernel.compute == kernel_.compute) {
+            kernel.mc = kernel_.mc;
+        }
+        withColumnMajorStorage(0.0f, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::blockedGemmPacked(kernel, a.rows(), b.cols(), a.cols(),
+                                       epilogue.scale, a.data(), a.rowStride(), a.colStride(), packed->panels.data(),
+                                       0.0f, out, ldc, workspace_, threads_, placement_, &epilogue);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} multiplication complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    void BlockedMultiplier::syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} rank-k update.", label_);
+
+        if (c.rows() != a.rows() || c.cols() != a.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        // A * A^T is symmetric, so a row-major C is updated as the opposite triangle of its
+        // column-major transpose. Other outputs are staged, loaded even when beta == 0 so the
+        // untouched triangle survives the copy back.
+        MatrixView out = c;
+        bool lower = triangle == Triangle::Lower;
+        if (!c.isColumnMajor() && c.colStride() == 1) {
+            out = c.transpose();
+            lower = !lower;
+        }
+        withColumnMajorStorage(1.0f, out, [&](float* data, Eigen::Index ldc) {
+            Kernels::blockedSyrk(kernel_, a.rows(), a.cols(), alpha, a.data(), a.rowStride(), a.colStride(),
+                                 beta, data, ldc, lower, workspace_, threads_, placement_);
+        });
+        if (mirror) {
+            mirrorTriangle(c, triangle);
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} rank-k update complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    void BlockedMultiplier::trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                                 Triangle triangle, bool unitDiagonal) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} triangular multiplication.", label_);
+
+        if (a.rows() != a.cols() || a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::blockedTrmm(kernel_, a.rows(), b.cols(), alpha, a.data(), a.rowStride(), a.colStride(),
+                                 triangle == Triangle::Lower, unitDiagonal, b.data(), b.rowStride(), b.colStride(),
+                                 beta, out, ldc, workspace_, threads_, placement_);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} triangular multiplication complete in -> {} milliseconds.", label_, tm_duration);
+    }
+
+    void BlockedMultiplier::configure(const nlohmann::json& options) {
+        // Block sizes must stay multiples of the register tile.
+        kernel_.mc = roundToMultiple(options.value("mc", defaultKernel_.mc), kernel_.mr);
+        kernel_.kc = std::max<Kernels::Index>(1, options.value("kc", defaultKernel_.kc));
+        kernel_.nc = roundToMultiple(options.value("nc", defaultKernel_.nc), kernel_.nr);
+        threads_ = std::max(0, options.value("threads", 0));
+        const ThreadPlacement& defaults = ThreadPlacement::global();
+        placement_.pinning = ThreadPlacement::parsePinning(options.value("pinning", ThreadPlacement::toString(defaults.pinning)));
+        placement_.numa = ThreadPlacement::parseNuma(options.value("numa", ThreadPlacement::toString(defaults.numa)));
+    }
+
+    IMultiplier::SerialProduct BlockedMultiplier::serialProduct() const {
+        return [kernel = kernel_](ConstMatrixView a, ConstMatrixView b, MatrixView c) {
+            thread_local Workspace workspace;
+            withColumnMajorOutput(a, b, 0.0f, c, [&](ConstMatrixView lhs, ConstMatrixView rhs, float* out, Eigen::Index ldc) {
+                Kernels::blockedGemm(kernel, lhs.rows(), rhs.cols(), lhs.cols(),
+                                     1.0f, lhs.data(), lhs.rowStride(), lhs.colStride(),
+                                     rhs.data(), rhs.rowStride(), rhs.colStride(),
+                                     0.0f, out, ldc, workspace, 1);
+            });
+        };
+    }
+
+    std::vector<nlohmann::json> BlockedMultiplier::tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const {
+        (void)n;
+        int maxThreads = 1;
+#ifdef _OPENMP
+        maxThreads = omp_get_max_threads();
+#endif
+        std::vector<int> threadCounts = {maxThreads};
+        if (maxThreads > 1) {
+            threadCounts.push_back(maxThreads / 2);
+        }
+
+        std::vector<nlohmann::json> candidates;
+        for (int threads : threadCounts) {
+            for (Kernels::Index kc : {defaultKernel_.kc / 2, defaultKernel_.kc, defaultKernel_.kc * 2}) {
+                if (kc > k && kc != defaultKernel_.kc) {
+                    continue;
+                }
+                for (Kernels::Index mc : {defaultKernel_.mc, defaultKernel_.mc * 2}) {
+                    if (mc > m && mc != defaultKernel_.mc) {
+                        continue;
+                    }
+                    candidates.push_back({{"mc", mc}, {"kc", kc}, {"nc", defaultKernel_.nc}, {"threads", threads}});
+                }
+            }
+        }
+        return candidates;
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include "matrix_transform/interfaces.hpp" 
+#include "configurable.hpp"
+#include "blocked_gemm.hpp"
+#include "structured_gemm.hpp"
+#include "skinny_gemm.hpp"
+#include "workspace.hpp"
+
+namespace MatrixTransform {
+
+    // Shared implementation of the packed, register-tiled backends. Subclasses only choose the
+    // register kernel; block sizes and the thread count are tunable through IConfigurable
+    // with the keys "mc", "kc", "nc" and "threads". "pinning" and "numa" override the
+    // process-wide ThreadPlacement for this backend.
+    class BlockedMultiplier : public IMultiplier, public IConfigurable {
+    public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        // Packs B into the current kernel's panels and blocking. Products against the handle
+        // pack only A, and keep that kernel and its kc/nc even if configure() changes them later.
+        std::shared_ptr<const PackedOperand> prepare(ConstMatrixView b) override;
+        void gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) override;
+
+        void gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) override;
+        void gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue) override;
+
+        // Triangle-only blocked kernels; symm keeps the default.
+        void syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) override;
+        void trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                  Triangle triangle, bool unitDiagonal) override;
+
+        void configure(const nlohmann::json& options) override;
+        std::vector<nlohmann::json> tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const override;
+
+    protected:
+        BlockedMultiplier(const Kernels::MicroKernel& kernel, std::string label);
+
+        // The current kernel and blocking on one thread.
+        SerialProduct serialProduct() const override;
+
+        const Kernels::MicroKernel& defaultKernel_;
+        Kernels::MicroKernel kernel_;
+        int threads_ = 0;
+        ThreadPlacement placement_;
+        std::string label_;
+        Workspace workspace_;
+    };
+
+} // namespace MatrixTransform
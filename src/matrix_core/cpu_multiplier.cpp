@@ -4,35 +4,163 @@
 #include <Eigen/Dense>
 #include "logger.hpp"
 #include "cpu_multiplier.hpp"
-#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
+#include "matrix_views.hpp"
+#include "epilogue_tile.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace MatrixTransform {
 
-    namespace { 
-        MultiplierRegistrar CPURegistrar( 
-            "CPU",
-            []() -> std::unique_ptr<IMultiplier> { 
-                return std::make_unique<CPUMultiplier>();
+    MATRIX_TRANSFORM_BACKEND("CPU", CPUMultiplier)
+
+    namespace {
+        // Output panel that stays in L2 between the product and its epilogue.
+        constexpr Eigen::Index EpiloguePanelBytes = 256 * 1024;
+        constexpr Eigen::Index MinEpiloguePanel = 32;
+
+        template <unsigned int Side>
+        void rankUpdate(float alpha, ConstMatrixView a, float beta, MatrixView c) {
+            MatrixView::StridedMap out = c.map();
+            if (beta == 0.0f) {
+                out.triangularView<Side>().setZero();
+            } else {
+                out.triangularView<Side>() *= beta;
             }
-        );
+            withDenseOperand(a, [&](const auto& lhs) {
+                out.selfadjointView<Side>().rankUpdate(lhs, alpha);
+            });
+        }
+
+        template <unsigned int Mode>
+        void triangularProduct(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+            MatrixView::StridedMap out = c.map();
+            withDenseOperand(a, [&](const auto& lhs) {
+                withDenseOperand(b, [&](const auto& rhs) {
+                    if (beta == 0.0f) {
+                        out.noalias() = lhs.template triangularView<Mode>() * (alpha * rhs);
+                    } else {
+                        out *= beta;
+                        out.noalias() += lhs.template triangularView<Mode>() * (alpha * rhs);
+                    }
+                });
+            });
+        }
     }
     
     Matrix CPUMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void CPUMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void CPUMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
         Logger::getInstance().log(LogLevel::Debug, "Starting CPU multiplication.");
 
-        if (a.cols() != b.rows()) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
             Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
             throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
         }
         
         std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
-        Matrix c = a * b;
+        MatrixView::StridedMap out = c.map();
+        withDenseOperand(a, [&](const auto& lhs) {
+            withDenseOperand(b, [&](const auto& rhs) {
+                if (beta == 0.0f) {
+                    out.noalias() = alpha * lhs * rhs;
+                } else {
+                    out *= beta;
+                    out.noalias() += alpha * lhs * rhs;
+                }
+            });
+        });
         std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
         auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
-        Logger::getInstance().log(LogLevel::Info, "CPU multiplication complete in -> " + std::to_string(tm_duration) + " milliseconds.");
-        return c;
+        Logger::getInstance().log(LogLevel::Info, "CPU multiplication complete in -> {} milliseconds.", tm_duration);
     }
     
+    void CPUMultiplier::gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting CPU multiplication with an epilogue.");
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols() ||
+            !Kernels::epilogueFits(epilogue, c.rows(), c.cols())) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        const Eigen::Index panel = std::max(MinEpiloguePanel,
+                                            EpiloguePanelBytes / static_cast<Eigen::Index>(sizeof(float) * std::max<Eigen::Index>(1, c.rows())));
+        // A is mapped (or, strided both ways, copied) once for all panels.
+        withColumnMajorStorage(0.0f, c, [&](float* out, Eigen::Index ldc) {
+            withDenseOperand(a, [&](const auto& lhs) {
+                for (Eigen::Index j = 0; j < c.cols(); j += panel) {
+                    const Eigen::Index cols = std::min(panel, c.cols() - j);
+                    Eigen::Map<Matrix, 0, Eigen::OuterStride<>> block(out + j * ldc, c.rows(), cols, Eigen::OuterStride<>(ldc));
+                    withDenseOperand(b.block(0, j, b.rows(), cols), [&](const auto& rhs) {
+                        block.noalias() = epilogue.scale * lhs * rhs;
+                    });
+                    Kernels::applyEpilogue(epilogue, 0, j, c.rows(), cols, out + j * ldc, ldc);
+                }
+            });
+        });
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "CPU multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+
+    void CPUMultiplier::syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting CPU rank-k update.");
+
+        if (c.rows() != a.rows() || c.cols() != a.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        if (triangle == Triangle::Lower) {
+            rankUpdate<Eigen::Lower>(alpha, a, beta, c);
+        } else {
+            rankUpdate<Eigen::Upper>(alpha, a, beta, c);
+        }
+        if (mirror) {
+            mirrorTriangle(c, triangle);
+        }
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "CPU rank-k update complete in -> {} milliseconds.", tm_duration);
+    }
+
+    void CPUMultiplier::trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                             Triangle triangle, bool unitDiagonal) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting CPU triangular multiplication.");
+
+        if (a.rows() != a.cols() || a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        if (triangle == Triangle::Lower && unitDiagonal) {
+            triangularProduct<Eigen::UnitLower>(alpha, a, b, beta, c);
+        } else if (triangle == Triangle::Lower) {
+            triangularProduct<Eigen::Lower>(alpha, a, b, beta, c);
+        } else if (unitDiagonal) {
+            triangularProduct<Eigen::UnitUpper>(alpha, a, b, beta, c);
+        } else {
+            triangularProduct<Eigen::Upper>(alpha, a, b, beta, c);
+        }
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "CPU triangular multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+
 } // namespace MatrixTransform
\ No newline at end of file
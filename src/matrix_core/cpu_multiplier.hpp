@@ -5,7 +5,20 @@ namespace MatrixTransform {
 
     class CPUMultiplier : public IMultiplier {
     public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
         Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        // Eigen products on column panels of C sized for L2, each finished by the epilogue
+        // before the next one is computed.
+        void gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) override;
+
+        // Eigen's selfadjoint rank update and triangular product.
+        void syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) override;
+        void trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                  Triangle triangle, bool unitDiagonal) override;
     };
 
 } // namespace MatrixTransform
\ No newline at end of file
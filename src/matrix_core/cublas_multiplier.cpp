@@ -1,8 +1,9 @@
 #ifdef WITH_CUDA 
 
-#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
 #include "cublas_multiplier.hpp" 
 #include "logger.hpp"
+#include "async_tiles.hpp"
 #include <cuda_runtime.h>
 #include <cublas_v2.h> 
 #include <iostream>
@@ -11,14 +12,7 @@
 
 namespace MatrixTransform {
 
-    namespace { 
-        MultiplierRegistrar CublasRegistrar( 
-            "cuBLAS", 
-            []() -> std::unique_ptr<IMultiplier> { 
-                return std::make_unique<cuBLASMultiplier>();
-            }
-        );
-    }
+    MATRIX_TRANSFORM_BACKEND("cuBLAS", cuBLASMultiplier)
 
     #define gpuErrchk(ans) { gpuAssert((ans), __FILE__, __LINE__); }
     inline void gpuAssert(cudaError_t code, const char *file, int line, bool abort=true){
@@ -65,7 +59,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point copy_to_end = std::chrono::high_resolution_clock::now();
         auto copy_to_duration = std::chrono::duration_cast<std::chrono::milliseconds>(copy_to_end - copy_to_start).count();
-        Logger::getInstance().log(LogLevel::Info, "Initialization complete in -> " + std::to_string(copy_to_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "Initialization complete in -> {} milliseconds.", copy_to_duration);
 
         Logger::getInstance().log(LogLevel::Debug, "Calling cublasSgemm...");
         
@@ -92,7 +86,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point mult_end = std::chrono::high_resolution_clock::now();
         auto mult_duration = std::chrono::duration_cast<std::chrono::milliseconds>(mult_end - mult_start).count();
-        Logger::getInstance().log(LogLevel::Info, "cuBLAS multiplication complete in -> " + std::to_string(mult_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "cuBLAS multiplication complete in -> {} milliseconds.", mult_duration);
         
         std::chrono::high_resolution_clock::time_point copy_back_start = std::chrono::high_resolution_clock::now();
         Matrix c(a.rows(), b.cols());
@@ -101,7 +95,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point copy_back_end = std::chrono::high_resolution_clock::now();
         auto copy_back_duration = std::chrono::duration_cast<std::chrono::milliseconds>(copy_back_end - copy_back_start).count();
-        Logger::getInstance().log(LogLevel::Info, "Copy results back to CPU complete in -> " + std::to_string(copy_back_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "Copy results back to CPU complete in -> {} milliseconds.", copy_back_duration);
 
         Logger::getInstance().log(LogLevel::Debug, "Freeing GPU memory and cuBLAS handle...");
         gpuErrchk(cudaFree(d_A));
@@ -113,6 +107,14 @@ namespace MatrixTransform {
         return c;
     }
 
+    std::future<Matrix> cuBLASMultiplier::multiplyAsync(Matrix a, Matrix b) {
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        return multiplyTaskAsync([a = std::move(a), b = std::move(b)]() { return cuBLASMultiplier().multiply(a, b); });
+    }
+
 } // namespace MatrixTransform
 
 #endif 
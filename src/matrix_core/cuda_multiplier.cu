@@ -5,19 +5,13 @@
 #include <cuda_runtime.h>
 #include "logger.hpp"
 #include "cuda_multiplier.hpp"
-#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
+#include "async_tiles.hpp"
 #include <chrono>
 
 namespace MatrixTransform {
 
-    namespace { 
-        MultiplierRegistrar CUDARegistrar( 
-            "CUDA",
-            []() -> std::unique_ptr<IMultiplier> { 
-                return std::make_unique<CUDAMultiplier>();
-            }
-        );
-    }
+    MATRIX_TRANSFORM_BACKEND("CUDA", CUDAMultiplier)
 
     #define gpuErrchk(ans) { gpuAssert((ans), __FILE__, __LINE__); }
     inline void gpuAssert(cudaError_t code, const char *file, int line, bool abort=true){
@@ -102,7 +96,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point copy_to_end = std::chrono::high_resolution_clock::now();
         auto copy_to_duration = std::chrono::duration_cast<std::chrono::milliseconds>(copy_to_end - copy_to_start).count();
-        Logger::getInstance().log(LogLevel::Info, "Initialization complete in -> " + std::to_string(copy_to_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "Initialization complete in -> {} milliseconds.", copy_to_duration);
 
         constexpr int TILE_WIDTH = 16;
         dim3 threadsPerBlock(TILE_WIDTH, TILE_WIDTH);
@@ -119,7 +113,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point mult_end = std::chrono::high_resolution_clock::now();
         auto mult_duration = std::chrono::duration_cast<std::chrono::milliseconds>(mult_end - mult_start).count();
-        Logger::getInstance().log(LogLevel::Info, "CUDA multiplication complete in -> " + std::to_string(mult_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "CUDA multiplication complete in -> {} milliseconds.", mult_duration);
 
         std::chrono::high_resolution_clock::time_point copy_back_start = std::chrono::high_resolution_clock::now();
 
@@ -130,7 +124,7 @@ namespace MatrixTransform {
 
         std::chrono::high_resolution_clock::time_point copy_back_end = std::chrono::high_resolution_clock::now();
         auto copy_back_duration = std::chrono::duration_cast<std::chrono::milliseconds>(copy_back_end - copy_back_start).count();
-        Logger::getInstance().log(LogLevel::Info, "Copy results back to CPU complete in -> " + std::to_string(copy_back_duration) + " milliseconds.");
+        Logger::getInstance().log(LogLevel::Info, "Copy results back to CPU complete in -> {} milliseconds.", copy_back_duration);
 
         Logger::getInstance().log(LogLevel::Debug, "Freeing GPU memory...");
         gpuErrchk(cudaFree(d_A));
@@ -141,6 +135,14 @@ namespace MatrixTransform {
         return c;
     }
 
+    std::future<Matrix> CUDAMultiplier::multiplyAsync(Matrix a, Matrix b) {
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        return multiplyTaskAsync([a = std::move(a), b = std::move(b)]() { return CUDAMultiplier().multiply(a, b); });
+    }
+
 } // namespace MatrixTransform
 
 #endif
\ No newline at end of file
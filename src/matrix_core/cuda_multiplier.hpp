@@ -5,7 +5,12 @@ namespace MatrixTransform {
 
     class CUDAMultiplier : public IMultiplier {
     public:
+        using IMultiplier::multiply;
         Matrix multiply(const Matrix& a, const Matrix& b) override;
+
+        // The whole product as one pool task on a fresh instance, so it runs on the GPU like
+        // multiply() and does not depend on this instance outliving the future.
+        std::future<Matrix> multiplyAsync(Matrix a, Matrix b) override;
     };
 
 } // namespace MatrixTransform
\ No newline at end of file
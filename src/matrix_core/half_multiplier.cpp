@@ -0,0 +1,52 @@
+#include "logger.hpp"
+#include "half_multiplier.hpp"
+#include "backend_plugin.hpp"
+#include "cpu_features.hpp"
+#include <chrono>
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("HALF_AVX2", HalfAVX2Multiplier)
+
+    HalfAVX2Multiplier::HalfAVX2Multiplier() : BlockedMultiplier(Kernels::selectMicroKernel(), "HALF AVX2") {
+        const CpuFeatures& features = CpuFeatures::get();
+        if (!features.avx2 || !features.fma) {
+            Logger::getInstance().log(LogLevel::Error, "HALF_AVX2 backend requires AVX2 and FMA.");
+            throw std::runtime_error("HALF_AVX2 backend is not supported by this CPU.");
+        }
+    }
+
+    Matrix HalfAVX2Multiplier::multiply(const MatrixBF16& a, const MatrixBF16& b) {
+        return multiplyHalf(a, b, "bf16");
+    }
+
+    Matrix HalfAVX2Multiplier::multiply(const MatrixF16& a, const MatrixF16& b) {
+        return multiplyHalf(a, b, "fp16");
+    }
+
+    template <typename T>
+    Matrix HalfAVX2Multiplier::multiplyHalf(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                                            const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& b, const char* precision) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting {} {} multiplication.", label_, precision);
+
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix c(a.rows(), b.cols());
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        Kernels::blockedGemm(kernel_, a.rows(), b.cols(), a.cols(),
+                             1.0f, a.data(), 1, a.outerStride(),
+                             b.data(), 1, b.outerStride(),
+                             0.0f, c.data(), c.outerStride(), workspace_, threads_, placement_);
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "{} {} multiplication complete in -> {} milliseconds.", label_, precision, tm_duration);
+        return c;
+    }
+    
+} // namespace MatrixTransform
@@ -0,0 +1,23 @@
+#pragma once
+#include "blocked_multiplier.hpp"
+
+namespace MatrixTransform {
+
+    // bf16 / fp16 inputs on the blocked path, using the widest kernel of the host. Operands are
+    // widened to fp32 while being packed, so they are read from memory at half width, never
+    // converted as a whole, and accumulated in fp32.
+    class HalfAVX2Multiplier : public BlockedMultiplier {
+    public:
+        HalfAVX2Multiplier();
+
+        using BlockedMultiplier::multiply;
+        Matrix multiply(const MatrixBF16& a, const MatrixBF16& b) override;
+        Matrix multiply(const MatrixF16& a, const MatrixF16& b) override;
+
+    private:
+        template <typename T>
+        Matrix multiplyHalf(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                            const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& b, const char* precision);
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,385 @@
+#include <Eigen/Dense>
+#include "logger.hpp"
+#include "small_gemm.hpp"
+#include "epilogue_tile.hpp"
+#include "thread_pool.hpp"
+#include "matrix_views.hpp"
+#include "parallel_runtime.hpp"
+#include "async_tiles.hpp"
+#include "matrix_transform/interfaces.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace MatrixTransform {
+
+    namespace {
+        struct AsyncProduct {
+            Matrix c;
+            AsyncTileFn runTile;
+            std::promise<Matrix> promise;
+            std::atomic<std::size_t> remaining{0};
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+
+        // Square output tiles, shrunk until every pool worker has about two tiles to run.
+        Eigen::Index asyncTileSize(Eigen::Index rows, Eigen::Index cols, std::size_t workers) {
+            Eigen::Index tile = 512;
+            while (tile > 64) {
+                const Eigen::Index tiles = ((rows + tile - 1) / tile) * ((cols + tile - 1) / tile);
+                if (static_cast<std::size_t>(tiles) >= 2 * workers) {
+                    break;
+                }
+                tile /= 2;
+            }
+            return tile;
+        }
+
+        // Batched products up to this size leave most of a team idle when run one at a time.
+        constexpr double ParallelBatchFlops = 2.0 * 256 * 256 * 256;
+
+        // Default prepared operand: b as it was given.
+        class RetainedOperand : public PackedOperand {
+        public:
+            explicit RetainedOperand(Matrix matrix) : PackedOperand(matrix.rows(), matrix.cols()), matrix(std::move(matrix)) {}
+            Matrix unpack() const override { return matrix; }
+
+            const Matrix matrix;
+        };
+
+        // Operands of the default fp32 tiles, shared by every tile of one product.
+        struct AsyncOperands {
+            Matrix a;
+            Matrix b;
+        };
+    }
+
+    Precision IMultiplier::precision() const {
+        return Precision::Float32;
+    }
+
+    Matrix IMultiplier::multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b) {
+        return multiply(a.dequantize(), b.dequantize());
+    }
+
+    Matrix IMultiplier::multiply(const MatrixBF16& a, const MatrixBF16& b) {
+        return multiply(Matrix(a.cast<float>()), Matrix(b.cast<float>()));
+    }
+
+    Matrix IMultiplier::multiply(const MatrixF16& a, const MatrixF16& b) {
+        return multiply(Matrix(a.cast<float>()), Matrix(b.cast<float>()));
+    }
+
+    Matrix IMultiplier::multiply(const SparseMatrix& a, const Matrix& b) {
+        return multiply(Matrix(a), b);
+    }
+
+    void IMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix product = multiply(a, b);
+        if (beta == 0.0f) {
+            c = alpha * product;
+        } else {
+            c = alpha * product + beta * c;
+        }
+    }
+
+    void IMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix product(c.rows(), c.cols());
+        gemm(1.0f, Matrix(a.map()), Matrix(b.map()), 0.0f, product);
+        if (beta == 0.0f) {
+            c.map() = alpha * product;
+        } else {
+            c.map() = alpha * product + beta * c.map();
+        }
+    }
+
+    Matrix IMultiplier::multiply(ConstMatrixView a, ConstMatrixView b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, MatrixView(c));
+        return c;
+    }
+
+    std::shared_ptr<const PackedOperand> IMultiplier::prepare(ConstMatrixView b) {
+        return std::make_shared<RetainedOperand>(b.map());
+    }
+
+    Matrix IMultiplier::multiply(ConstMatrixView a, const PackedOperand& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void IMultiplier::gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) {
+        if (const auto* retained = dynamic_cast<const RetainedOperand*>(&b)) {
+            gemm(alpha, a, ConstMatrixView(retained->matrix), beta, c);
+        } else {
+            const Matrix unpacked = b.unpack();
+            gemm(alpha, a, ConstMatrixView(unpacked), beta, c);
+        }
+    }
+
+    void IMultiplier::gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols() ||
+            !Kernels::epilogueFits(epilogue, c.rows(), c.cols())) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        withColumnMajorStorage(0.0f, c, [&](float* out, Eigen::Index ldc) {
+            gemm(epilogue.scale, a, b, 0.0f, MatrixView(out, c.rows(), c.cols(), ldc));
+            Kernels::applyEpilogue(epilogue, 0, 0, c.rows(), c.cols(), out, ldc);
+        });
+    }
+
+    void IMultiplier::gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols() ||
+            !Kernels::epilogueFits(epilogue, c.rows(), c.cols())) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        withColumnMajorStorage(0.0f, c, [&](float* out, Eigen::Index ldc) {
+            gemm(epilogue.scale, a, b, 0.0f, MatrixView(out, c.rows(), c.cols(), ldc));
+            Kernels::applyEpilogue(epilogue, 0, 0, c.rows(), c.cols(), out, ldc);
+        });
+    }
+
+    Matrix IMultiplier::multiply(ConstMatrixView a, ConstMatrixView b, const Epilogue& epilogue) {
+        Matrix c(a.rows(), b.cols());
+        gemm(a, b, MatrixView(c), epilogue);
+        return c;
+    }
+
+    void IMultiplier::syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) {
+        if (c.rows() != a.rows() || c.cols() != a.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix product(c.rows(), c.cols());
+        gemm(1.0f, a, a.transpose(), 0.0f, MatrixView(product));
+        for (Eigen::Index j = 0; j < c.cols(); ++j) {
+            const Eigen::Index first = triangle == Triangle::Lower ? j : 0;
+            const Eigen::Index last = triangle == Triangle::Lower ? c.rows() : j + 1;
+            for (Eigen::Index i = first; i < last; ++i) {
+                c(i, j) = beta == 0.0f ? alpha * product(i, j) : alpha * product(i, j) + beta * c(i, j);
+            }
+        }
+        if (mirror) {
+            mirrorTriangle(c, triangle);
+        }
+    }
+
+    void IMultiplier::symm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c, Triangle triangle) {
+        if (a.rows() != a.cols() || a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix full = a.map();
+        mirrorTriangle(MatrixView(full), triangle);
+        gemm(alpha, ConstMatrixView(full), b, beta, c);
+    }
+
+    void IMultiplier::trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                           Triangle triangle, bool unitDiagonal) {
+        if (a.rows() != a.cols() || a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        Matrix factor = Matrix::Zero(a.rows(), a.cols());
+        if (triangle == Triangle::Lower) {
+            factor.triangularView<Eigen::Lower>() = a.map();
+        } else {
+            factor.triangularView<Eigen::Upper>() = a.map();
+        }
+        if (unitDiagonal) {
+            factor.diagonal().setOnes();
+        }
+        gemm(alpha, ConstMatrixView(factor), b, beta, c);
+    }
+
+    void IMultiplier::multiplyBatch(const Matrix* const* a, const Matrix* const* b, Matrix* const* c, std::size_t count) {
+        std::vector<ConstMatrixView> aViews, bViews;
+        std::vector<MatrixView> cViews;
+        aViews.reserve(count);
+        bViews.reserve(count);
+        cViews.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (a[i]->cols() != b[i]->rows()) {
+                Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch in batch entry {}.", i);
+                throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+            }
+            c[i]->resize(a[i]->rows(), b[i]->cols());
+            aViews.emplace_back(*a[i]);
+            bViews.emplace_back(*b[i]);
+            cViews.emplace_back(*c[i]);
+        }
+        multiplyBatch(aViews.data(), bViews.data(), cViews.data(), count);
+    }
+
+    void IMultiplier::multiplyBatch(const ConstMatrixView* a, const ConstMatrixView* b, const MatrixView* c, std::size_t count) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting batched multiplication of {} products.", count);
+
+        std::vector<Kernels::SmallGemmFn> kernels(count);
+        std::vector<std::ptrdiff_t> parallel;
+        std::vector<std::size_t> sequential;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (a[i].cols() != b[i].rows() || c[i].rows() != a[i].rows() || c[i].cols() != b[i].cols()) {
+                Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch in batch entry {}.", i);
+                throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+            }
+            if (a[i].isColumnMajor() && b[i].isColumnMajor() && c[i].isColumnMajor()) {
+                kernels[i] = Kernels::smallGemmKernel(a[i].rows(), b[i].cols(), a[i].cols());
+            }
+            if (kernels[i] == nullptr) {
+                const double flops = 2.0 * a[i].rows() * b[i].cols() * a[i].cols();
+                if (count > 1 && flops <= ParallelBatchFlops) {
+                    parallel.push_back(static_cast<std::ptrdiff_t>(i));
+                } else {
+                    sequential.push_back(i);
+                }
+            }
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        const ParallelRuntime& runtime = ParallelRuntime::getInstance();
+        runtime.parallelFor(static_cast<std::ptrdiff_t>(count), false, [&](std::ptrdiff_t i) {
+            if (kernels[i] != nullptr) {
+                kernels[i](a[i].data(), a[i].colStride(), b[i].data(), b[i].colStride(), c[i].data(), c[i].colStride());
+            }
+        });
+
+        if (!parallel.empty()) {
+            const SerialProduct product = serialProduct();
+            runtime.parallelFor(static_cast<std::ptrdiff_t>(parallel.size()), true, [&](std::ptrdiff_t p) {
+                const std::ptrdiff_t i = parallel[p];
+                product(a[i], b[i], c[i]);
+            });
+        }
+
+        for (std::size_t i : sequential) {
+            gemm(1.0f, a[i], b[i], 0.0f, c[i]);
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "Batched multiplication complete in -> {} microseconds.", tm_duration);
+    }
+
+    std::future<Matrix> multiplyTilesAsync(Eigen::Index m, Eigen::Index n, AsyncTileFn runTile) {
+        auto product = std::make_shared<AsyncProduct>();
+        product->c.resize(m, n);
+        product->runTile = std::move(runTile);
+        std::future<Matrix> result = product->promise.get_future();
+
+        ThreadPool& pool = ThreadPool::getInstance();
+        const Eigen::Index tile = asyncTileSize(m, n, pool.workerCount());
+        std::vector<std::function<void()>> tasks;
+        for (Eigen::Index col = 0; col < n; col += tile) {
+            for (Eigen::Index row = 0; row < m; row += tile) {
+                tasks.push_back([product, row, col, tile]() {
+                    try {
+                        product->runTile(row, col, std::min(tile, product->c.rows() - row),
+                                         std::min(tile, product->c.cols() - col), product->c);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(product->errorMutex);
+                        product->error = std::current_exception();
+                    }
+                    if (product->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        if (product->error) {
+                            product->promise.set_exception(product->error);
+                        } else {
+                            product->promise.set_value(std::move(product->c));
+                        }
+                    }
+                });
+            }
+        }
+
+        if (tasks.empty()) {
+            product->promise.set_value(std::move(product->c));
+            return result;
+        }
+        Logger::getInstance().log(LogLevel::Debug, "Queued async multiplication as {} tiles.", tasks.size());
+        product->remaining.store(tasks.size(), std::memory_order_release);
+        pool.submit(std::move(tasks));
+        return result;
+    }
+
+    std::future<Matrix> multiplyTaskAsync(std::function<Matrix()> task) {
+        auto promise = std::make_shared<std::promise<Matrix>>();
+        std::future<Matrix> result = promise->get_future();
+        ThreadPool::getInstance().submit([promise, task = std::move(task)]() {
+            try {
+                promise->set_value(task());
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return result;
+    }
+
+    std::future<Matrix> IMultiplier::multiplyAsync(Matrix a, Matrix b) {
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        const Eigen::Index m = a.rows();
+        const Eigen::Index n = b.cols();
+        auto operands = std::make_shared<AsyncOperands>(AsyncOperands{std::move(a), std::move(b)});
+        return multiplyTilesAsync(m, n, [operands, product = serialProduct()](Eigen::Index row, Eigen::Index col,
+                                                                              Eigen::Index rows, Eigen::Index cols, Matrix& c) {
+            const ConstMatrixView a(operands->a);
+            const ConstMatrixView b(operands->b);
+            product(a.block(row, 0, rows, a.cols()), b.block(0, col, b.rows(), cols), MatrixView(c).block(row, col, rows, cols));
+        });
+    }
+
+    IMultiplier::SerialProduct IMultiplier::serialProduct() const {
+        return [](ConstMatrixView a, ConstMatrixView b, MatrixView c) {
+            MatrixView::StridedMap out = c.map();
+            withDenseOperand(a, [&](const auto& lhs) {
+                withDenseOperand(b, [&](const auto& rhs) {
+                    out.noalias() = lhs * rhs;
+                });
+            });
+        };
+    }
+
+    std::vector<Matrix> IMultiplier::multiplyBatch(const std::vector<Matrix>& a, const std::vector<Matrix>& b) {
+        if (a.size() != b.size()) {
+            Logger::getInstance().log(LogLevel::Error, "Batch size mismatch.");
+            throw std::invalid_argument("Batches of A and B must have the same number of matrices.");
+        }
+
+        std::vector<Matrix> c(a.size());
+        std::vector<const Matrix*> aPtrs(a.size()), bPtrs(b.size());
+        std::vector<Matrix*> cPtrs(c.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            aPtrs[i] = &a[i];
+            bPtrs[i] = &b[i];
+            cPtrs[i] = &c[i];
+        }
+        multiplyBatch(aPtrs.data(), bPtrs.data(), cPtrs.data(), a.size());
+        return c;
+    }
+
+} // namespace MatrixTransform
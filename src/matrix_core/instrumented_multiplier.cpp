@@ -0,0 +1,213 @@
+#include "instrumented_multiplier.hpp"
+#include "aligned_buffer.hpp"
+#include "perf_counters.hpp"
+#include <chrono>
+
+namespace MatrixTransform {
+
+    namespace {
+        std::uint64_t productFlops(Eigen::Index m, Eigen::Index n, Eigen::Index k) {
+            return 2 * static_cast<std::uint64_t>(m) * static_cast<std::uint64_t>(n) * static_cast<std::uint64_t>(k);
+        }
+
+        std::uint64_t resultBytes(Eigen::Index m, Eigen::Index n) {
+            return static_cast<std::uint64_t>(m) * static_cast<std::uint64_t>(n) * sizeof(float);
+        }
+    }
+
+    std::unique_ptr<IMultiplier> instrumentMultiplier(std::unique_ptr<IMultiplier> backend, const std::string& name) {
+        return std::make_unique<InstrumentedMultiplier>(std::move(backend), name);
+    }
+
+    InstrumentedMultiplier::InstrumentedMultiplier(std::unique_ptr<IMultiplier> backend, const std::string& name)
+        : backend_(std::move(backend)), metrics_(MetricsRegistry::getInstance().backend(name)) {}
+
+    template <typename Call>
+    void InstrumentedMultiplier::measure(MetricOp op, std::uint64_t flops, std::uint64_t outputBytes, Call&& call) {
+        PerfCounters& perf = PerfCounters::getInstance();
+        const bool counting = perf.enabled();
+        std::uint64_t before[HardwareCounterCount];
+        if (counting) {
+            perf.registerThreads();
+            perf.read(before);
+        }
+        const std::uint64_t allocated = alignedBytesAllocated;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            call();
+        } catch (...) {
+            metrics_.recordError(op);
+            throw;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const std::uint64_t nanos = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        const std::uint64_t bytes = outputBytes + (alignedBytesAllocated - allocated);
+        if (counting) {
+            std::uint64_t after[HardwareCounterCount];
+            perf.read(after);
+            for (int c = 0; c < HardwareCounterCount; ++c) {
+                after[c] = after[c] >= before[c] ? after[c] - before[c] : 0;
+            }
+            metrics_.record(op, nanos, flops, bytes, after);
+        } else {
+            metrics_.record(op, nanos, flops, bytes, nullptr);
+        }
+    }
+
+    Precision InstrumentedMultiplier::precision() const {
+        return backend_->precision();
+    }
+
+    Matrix InstrumentedMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix result;
+        measure(MetricOp::Multiply, productFlops(a.rows(), b.cols(), a.cols()), resultBytes(a.rows(), b.cols()),
+                [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    Matrix InstrumentedMultiplier::multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b) {
+        Matrix result;
+        measure(MetricOp::Reduced, productFlops(a.rows(), b.cols(), a.cols()), resultBytes(a.rows(), b.cols()),
+                [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    Matrix InstrumentedMultiplier::multiply(const MatrixBF16& a, const MatrixBF16& b) {
+        Matrix result;
+        measure(MetricOp::Reduced, productFlops(a.rows(), b.cols(), a.cols()), resultBytes(a.rows(), b.cols()),
+                [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    Matrix InstrumentedMultiplier::multiply(const MatrixF16& a, const MatrixF16& b) {
+        Matrix result;
+        measure(MetricOp::Reduced, productFlops(a.rows(), b.cols(), a.cols()), resultBytes(a.rows(), b.cols()),
+                [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    Matrix InstrumentedMultiplier::multiply(const SparseMatrix& a, const Matrix& b) {
+        Matrix result;
+        // Only the stored nonzeros are multiplied.
+        measure(MetricOp::Sparse, 2 * static_cast<std::uint64_t>(a.nonZeros()) * static_cast<std::uint64_t>(b.cols()),
+                resultBytes(a.rows(), b.cols()), [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    void InstrumentedMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->gemm(alpha, a, b, beta, c); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->gemm(alpha, a, b, beta, c); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->gemm(a, b, c, epilogue); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->gemm(a, b, c, epilogue); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), a.rows(), a.cols()) / 2, 0,
+                [&]() { backend_->syrk(alpha, a, beta, c, triangle, mirror); });
+        metrics_.recordShape(a.rows(), a.rows(), a.cols());
+    }
+
+    void InstrumentedMultiplier::symm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c, Triangle triangle) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->symm(alpha, a, b, beta, c, triangle); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                                      Triangle triangle, bool unitDiagonal) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()) / 2, 0,
+                [&]() { backend_->trmm(alpha, a, b, beta, c, triangle, unitDiagonal); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    std::shared_ptr<const PackedOperand> InstrumentedMultiplier::prepare(ConstMatrixView b) {
+        return backend_->prepare(b);
+    }
+
+    Matrix InstrumentedMultiplier::multiply(ConstMatrixView a, const PackedOperand& b) {
+        Matrix result;
+        measure(MetricOp::Multiply, productFlops(a.rows(), b.cols(), a.cols()), resultBytes(a.rows(), b.cols()),
+                [&]() { result = backend_->multiply(a, b); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+        return result;
+    }
+
+    void InstrumentedMultiplier::gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) {
+        measure(MetricOp::Gemm, productFlops(a.rows(), b.cols(), a.cols()), 0,
+                [&]() { backend_->gemm(alpha, a, b, beta, c); });
+        metrics_.recordShape(a.rows(), b.cols(), a.cols());
+    }
+
+    void InstrumentedMultiplier::multiplyBatch(const Matrix* const* a, const Matrix* const* b, Matrix* const* c, std::size_t count) {
+        std::uint64_t flops = 0;
+        std::uint64_t bytes = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            flops += productFlops(a[i]->rows(), b[i]->cols(), a[i]->cols());
+            if (c[i]->rows() != a[i]->rows() || c[i]->cols() != b[i]->cols()) {
+                bytes += resultBytes(a[i]->rows(), b[i]->cols());
+            }
+        }
+        measure(MetricOp::Batch, flops, bytes, [&]() { backend_->multiplyBatch(a, b, c, count); });
+        for (std::size_t i = 0; i < count; ++i) {
+            metrics_.recordShape(a[i]->rows(), b[i]->cols(), a[i]->cols());
+        }
+    }
+
+    void InstrumentedMultiplier::multiplyBatch(const ConstMatrixView* a, const ConstMatrixView* b, const MatrixView* c, std::size_t count) {
+        std::uint64_t flops = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            flops += productFlops(a[i].rows(), b[i].cols(), a[i].cols());
+        }
+        measure(MetricOp::Batch, flops, 0, [&]() { backend_->multiplyBatch(a, b, c, count); });
+        for (std::size_t i = 0; i < count; ++i) {
+            metrics_.recordShape(a[i].rows(), b[i].cols(), a[i].cols());
+        }
+    }
+
+    std::future<Matrix> InstrumentedMultiplier::multiplyAsync(Matrix a, Matrix b) {
+        const Eigen::Index m = a.rows();
+        const Eigen::Index n = b.cols();
+        const Eigen::Index k = a.cols();
+        std::future<Matrix> result;
+        measure(MetricOp::Async, productFlops(m, n, k), resultBytes(m, n),
+                [&]() { result = backend_->multiplyAsync(std::move(a), std::move(b)); });
+        metrics_.recordShape(m, n, k);
+        return result;
+    }
+
+    void InstrumentedMultiplier::configure(const nlohmann::json& options) {
+        if (auto* configurable = dynamic_cast<IConfigurable*>(backend_.get())) {
+            configurable->configure(options);
+        }
+    }
+
+    std::vector<nlohmann::json> InstrumentedMultiplier::tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const {
+        if (auto* configurable = dynamic_cast<const IConfigurable*>(backend_.get())) {
+            return configurable->tuningCandidates(m, n, k);
+        }
+        return {};
+    }
+
+} // namespace MatrixTransform
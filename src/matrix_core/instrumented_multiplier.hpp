@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "matrix_transform/interfaces.hpp"
+#include "matrix_transform/metrics.hpp"
+#include "configurable.hpp"
+
+namespace MatrixTransform {
+
+    // Decorator that times every call of the wrapped backend and records it in the
+    // MetricsRegistry under the given name: latency, requested flops, bytes allocated for
+    // results and workspaces, shapes, and the perf counters when they are enabled. Options are
+    // forwarded to the wrapped backend.
+    class InstrumentedMultiplier : public IMultiplier, public IConfigurable {
+    public:
+        InstrumentedMultiplier(std::unique_ptr<IMultiplier> backend, const std::string& name);
+
+        using IMultiplier::multiply;
+        Precision precision() const override;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        Matrix multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b) override;
+        Matrix multiply(const MatrixBF16& a, const MatrixBF16& b) override;
+        Matrix multiply(const MatrixF16& a, const MatrixF16& b) override;
+        Matrix multiply(const SparseMatrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        std::shared_ptr<const PackedOperand> prepare(ConstMatrixView b) override;
+        Matrix multiply(ConstMatrixView a, const PackedOperand& b) override;
+        void gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) override;
+
+        void gemm(ConstMatrixView a, ConstMatrixView b, MatrixView c, const Epilogue& epilogue) override;
+        void gemm(ConstMatrixView a, const PackedOperand& b, MatrixView c, const Epilogue& epilogue) override;
+
+        // Recorded as gemm calls, counting only the flops the structure requires.
+        void syrk(float alpha, ConstMatrixView a, float beta, MatrixView c, Triangle triangle, bool mirror) override;
+        void symm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c, Triangle triangle) override;
+        void trmm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c,
+                  Triangle triangle, bool unitDiagonal) override;
+
+        using IMultiplier::multiplyBatch;
+        void multiplyBatch(const Matrix* const* a, const Matrix* const* b, Matrix* const* c, std::size_t count) override;
+        void multiplyBatch(const ConstMatrixView* a, const ConstMatrixView* b, const MatrixView* c, std::size_t count) override;
+        std::future<Matrix> multiplyAsync(Matrix a, Matrix b) override;
+
+        void configure(const nlohmann::json& options) override;
+        std::vector<nlohmann::json> tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const override;
+
+    private:
+        template <typename Call>
+        void measure(MetricOp op, std::uint64_t flops, std::uint64_t outputBytes, Call&& call);
+
+        std::unique_ptr<IMultiplier> backend_;
+        BackendMetrics& metrics_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,197 @@
+#include "logger.hpp"
+#include "int8_multiplier.hpp"
+#include "backend_plugin.hpp"
+#include "cpu_features.hpp"
+#include "int8_gemm.hpp"
+#include "aligned_buffer.hpp"
+#include "matrix_views.hpp"
+#include "async_tiles.hpp"
+#include "matrix_transform/quantization.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("INT8_AVX2", Int8AVX2Multiplier)
+
+    namespace {
+        // Scale and zero point for a view, from one vectorized pass over its values.
+        QuantizationParams leftParams(ConstMatrixView a, bool reduceRange) {
+            float lo = 0.0f;
+            float hi = 0.0f;
+            Kernels::floatRangeAvx2(a.data(), a.rows(), a.cols(), a.rowStride(), a.colStride(), lo, hi);
+            return chooseU8Params(lo, hi, reduceRange);
+        }
+
+        QuantizationParams rightParams(ConstMatrixView b) {
+            float lo = 0.0f;
+            float hi = 0.0f;
+            Kernels::floatRangeAvx2(b.data(), b.rows(), b.cols(), b.rowStride(), b.colStride(), lo, hi);
+            return chooseS8Params(std::max(-lo, hi));
+        }
+
+        Kernels::Int8Left leftOperand(ConstMatrixView a, const QuantizationParams& params, bool reduceRange) {
+            return {nullptr, a.data(), a.rowStride(), a.colStride(), params.zeroPoint, 1.0f / params.scale, reduceRange ? 127 : 255};
+        }
+
+        // B quantized to symmetric s8 while it is packed into the host's panel layout.
+        class Int8Operand : public PackedOperand {
+        public:
+            explicit Int8Operand(ConstMatrixView b)
+                : PackedOperand(b.rows(), b.cols()), scale(rightParams(b).scale),
+                  codes(Kernels::int8PackedBSize(b.rows(), b.cols())) {
+                Kernels::int8PackB(b.rows(), b.cols(),
+                                   Kernels::Int8Right{nullptr, b.data(), b.rowStride(), b.colStride(), 0, 1.0f / scale},
+                                   codes.data());
+            }
+
+            Matrix unpack() const override {
+                Eigen::Matrix<std::int8_t, Eigen::Dynamic, Eigen::Dynamic> values(rows(), cols());
+                Kernels::int8UnpackB(rows(), cols(), codes.data(), values.data(), values.outerStride());
+                return values.cast<float>() * scale;
+            }
+
+            float scale;
+            AlignedBuffer<std::uint8_t> codes;
+        };
+
+        struct AsyncOperands {
+            Matrix a;
+            Matrix b;
+            QuantizationParams left;
+            QuantizationParams right;
+        };
+    }
+
+    Int8AVX2Multiplier::Int8AVX2Multiplier() {
+        const CpuFeatures& features = CpuFeatures::get();
+        if (!features.avx2) {
+            Logger::getInstance().log(LogLevel::Error, "INT8_AVX2 backend requires AVX2.");
+            throw std::runtime_error("INT8_AVX2 backend is not supported by this CPU.");
+        }
+        // Without VNNI, 7-bit activations keep the fast maddubs kernel free of int16 saturation.
+        reduceRange_ = !features.avxvnni;
+        Logger::getInstance().log(LogLevel::Info, "INT8_AVX2 backend using {} kernels.", features.avxvnni ? "AVX-VNNI" : "AVX2 maddubs");
+    }
+
+    Precision Int8AVX2Multiplier::precision() const {
+        return Precision::Int8;
+    }
+
+    Matrix Int8AVX2Multiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    Matrix Int8AVX2Multiplier::multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b) {
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        Matrix c(a.rows(), b.cols());
+        run(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void Int8AVX2Multiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void Int8AVX2Multiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        const QuantizationParams left = leftParams(a, reduceRange_);
+        const QuantizationParams right = rightParams(b);
+
+        Logger::getInstance().log(LogLevel::Debug, "Starting INT8 AVX2 multiplication.");
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::int8Gemm(a.rows(), b.cols(), a.cols(), leftOperand(a, left, reduceRange_),
+                              Kernels::Int8Right{nullptr, b.data(), b.rowStride(), b.colStride(), 0, 1.0f / right.scale},
+                              alpha * left.scale * right.scale, beta, out, ldc, workspace_);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "INT8 AVX2 multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+
+    std::shared_ptr<const PackedOperand> Int8AVX2Multiplier::prepare(ConstMatrixView b) {
+        return std::make_shared<Int8Operand>(b);
+    }
+
+    void Int8AVX2Multiplier::gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) {
+        const auto* packed = dynamic_cast<const Int8Operand*>(&b);
+        if (packed == nullptr) {
+            IMultiplier::gemm(alpha, a, b, beta, c);
+            return;
+        }
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        const QuantizationParams left = leftParams(a, reduceRange_);
+
+        Logger::getInstance().log(LogLevel::Debug, "Starting INT8 AVX2 multiplication with a packed operand.");
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::int8GemmPacked(a.rows(), b.cols(), a.cols(), leftOperand(a, left, reduceRange_),
+                                    packed->codes.data(), 0, alpha * left.scale * packed->scale, beta, out, ldc, workspace_);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "INT8 AVX2 multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+
+    std::future<Matrix> Int8AVX2Multiplier::multiplyAsync(Matrix a, Matrix b) {
+        if (a.cols() != b.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        const Eigen::Index m = a.rows();
+        const Eigen::Index n = b.cols();
+        const QuantizationParams left = leftParams(a, reduceRange_);
+        const QuantizationParams right = rightParams(b);
+        auto operands = std::make_shared<AsyncOperands>(AsyncOperands{std::move(a), std::move(b), left, right});
+        const bool reduceRange = reduceRange_;
+        return multiplyTilesAsync(m, n, [operands, reduceRange](Eigen::Index row, Eigen::Index col, Eigen::Index rows, Eigen::Index cols, Matrix& c) {
+            thread_local Workspace workspace;
+            const ConstMatrixView a = ConstMatrixView(operands->a).block(row, 0, rows, operands->a.cols());
+            const ConstMatrixView b = ConstMatrixView(operands->b).block(0, col, operands->b.rows(), cols);
+            Kernels::int8Gemm(rows, cols, a.cols(), leftOperand(a, operands->left, reduceRange),
+                              Kernels::Int8Right{nullptr, b.data(), b.rowStride(), b.colStride(), 0, 1.0f / operands->right.scale},
+                              operands->left.scale * operands->right.scale, 0.0f,
+                              c.data() + row + col * c.outerStride(), c.outerStride(), workspace, 1);
+        });
+    }
+
+    void Int8AVX2Multiplier::run(float alpha, const QuantizedMatrixU8& a, const QuantizedMatrixS8& b, float beta, MatrixView c) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting INT8 AVX2 multiplication.");
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            Kernels::int8Gemm(a.rows(), b.cols(), a.cols(),
+                              Kernels::Int8Left{a.values.data(), nullptr, 1, a.values.outerStride(), a.zeroPoint, 1.0f, 255},
+                              Kernels::Int8Right{b.values.data(), nullptr, 1, b.values.outerStride(), b.zeroPoint, 1.0f},
+                              alpha * a.scale * b.scale, beta, out, ldc, workspace_);
+        });
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "INT8 AVX2 multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+    
+} // namespace MatrixTransform
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include "matrix_transform/interfaces.hpp"
+#include "workspace.hpp"
+
+namespace MatrixTransform {
+
+    // u8 x s8 -> fp32 backend on AVX2 / AVX-VNNI. fp32 operands are quantized per call
+    // (A asymmetric u8, B symmetric s8) as the kernel packs them, so results carry
+    // quantization error; pre-quantized operands go straight to the integer kernel.
+    class Int8AVX2Multiplier : public IMultiplier {
+    public:
+        Int8AVX2Multiplier();
+
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Precision precision() const override;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        Matrix multiply(const QuantizedMatrixU8& a, const QuantizedMatrixS8& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        // Quantizes B to s8 and packs it once; products against the handle quantize only A.
+        std::shared_ptr<const PackedOperand> prepare(ConstMatrixView b) override;
+        void gemm(float alpha, ConstMatrixView a, const PackedOperand& b, float beta, MatrixView c) override;
+
+        // Quantization parameters are chosen once for the whole operands, so every tile runs
+        // the int8 kernel on the same codes as multiply().
+        std::future<Matrix> multiplyAsync(Matrix a, Matrix b) override;
+
+    private:
+        void run(float alpha, const QuantizedMatrixU8& a, const QuantizedMatrixS8& b, float beta, MatrixView c);
+
+        bool reduceRange_ = true;
+        Workspace workspace_;
+    };
+
+} // namespace MatrixTransform
@@ -3,41 +3,68 @@
 #include <Eigen/Dense>
 #include "logger.hpp"
 #include "neon_multiplier.hpp"
-#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
 #include <chrono>
 #include <arm_neon.h>
 
 namespace MatrixTransform {
 
-    namespace { 
-        MultiplierRegistrar NEONRegistrar( 
-            "NEON",
-            []() -> std::unique_ptr<IMultiplier> { 
-                return std::make_unique<NEONMultiplier>();
-            }
-        );
-    }
+    MATRIX_TRANSFORM_BACKEND("NEON", NEONMultiplier)
     
     Matrix NEONMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void NEONMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void NEONMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
         Logger::getInstance().log(LogLevel::Debug, "Starting NEON multiplication.");
 
-        if (a.cols() != b.rows()) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
             Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
             throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
         }
-        Matrix c = Matrix::Zero(a.rows(), b.cols());
-        Matrix b_T = b.transpose();
+
+        const int rows = static_cast<int>(a.rows());
+        const int cols = static_cast<int>(b.cols());
+        const int inner = static_cast<int>(a.cols());
+
+        // The dot products read rows of A and columns of B contiguously. Operands already laid
+        // out that way (row-major A, column-major B) are used in place; the others are copied
+        // into the workspace, which is reused across calls.
+        const float* a_T = a.data();
+        Eigen::Index lda = a.rowStride();
+        if (a.colStride() != 1) {
+            float* staged = workspace_.acquire(0, static_cast<std::size_t>(rows) * inner);
+            Eigen::Map<Matrix>(staged, inner, rows) = a.map().transpose();
+            a_T = staged;
+            lda = inner;
+        }
+        const float* b_data = b.data();
+        Eigen::Index ldb = b.colStride();
+        if (!b.isColumnMajor()) {
+            float* staged = workspace_.acquire(1, static_cast<std::size_t>(inner) * cols);
+            Eigen::Map<Matrix>(staged, inner, cols) = b.map();
+            b_data = staged;
+            ldb = inner;
+        }
         
         std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
 
-        for (int i = 0; i < a.rows(); ++i) {
-            for (int j = 0; j < b_T.rows(); ++j) {
+        for (int i = 0; i < rows; ++i) {
+            const float* a_row = a_T + static_cast<std::size_t>(i) * lda;
+            for (int j = 0; j < cols; ++j) {
+                const float* b_col = b_data + static_cast<std::size_t>(j) * ldb;
                 float32x4_t sum_vec = vdupq_n_f32(0.0f);
 
                 int k = 0;
-                for (; k <= a.cols() - 4; k += 4) {
-                    float32x4_t a_vec = vld1q_f32(&a(i, k));
-                    float32x4_t b_vec = vld1q_f32(&b_T(j, k));
+                for (; k <= inner - 4; k += 4) {
+                    float32x4_t a_vec = vld1q_f32(a_row + k);
+                    float32x4_t b_vec = vld1q_f32(b_col + k);
 
                     // Fused multiply-add operation
                     sum_vec = vmlaq_f32(sum_vec, a_vec, b_vec);
@@ -48,18 +75,17 @@ namespace MatrixTransform {
                 float result = vget_lane_f32(sum_pair, 0) + vget_lane_f32(sum_pair, 1);
                 
                 // Handle any remaining elements
-                for (; k < a.cols(); ++k) {
-                    result += a(i, k) * b_T(j, k);
+                for (; k < inner; ++k) {
+                    result += a_row[k] * b_col[k];
                 }
                 
-                c(i, j) = result;
+                c(i, j) = alpha * result + (beta == 0.0f ? 0.0f : beta * c(i, j));
             }
         }
         std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
         auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
-        Logger::getInstance().log(LogLevel::Info, "NEON multiplication complete in -> " + std::to_string(tm_duration) + " milliseconds.");
-        return c;
+        Logger::getInstance().log(LogLevel::Info, "NEON multiplication complete in -> {} milliseconds.", tm_duration);
     }
     
 } // namespace MatrixTransform
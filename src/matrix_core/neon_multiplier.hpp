@@ -1,11 +1,19 @@
 #pragma once
 #include "matrix_transform/interfaces.hpp" 
+#include "workspace.hpp"
 
 namespace MatrixTransform {
 
     class NEONMultiplier : public IMultiplier {
     public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
         Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+    private:
+        Workspace workspace_;
     };
 
 } // namespace MatrixTransform
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
-#include "matrix_transform/interfaces.hpp" 
+#include "blocked_multiplier.hpp"
 
 namespace MatrixTransform {
 
-    class OMPAVX2Multiplier : public IMultiplier {
+    class OMPAVX2Multiplier : public BlockedMultiplier {
     public:
-        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        OMPAVX2Multiplier();
     };
 
-} // namespace MatrixTransform
\ No newline at end of file
+} // namespace MatrixTransform
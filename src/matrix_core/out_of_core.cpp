@@ -0,0 +1,142 @@
+#include "matrix_transform/out_of_core.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+namespace MatrixTransform {
+
+    namespace {
+        using Index = Eigen::Index;
+
+        // A block-row panel of A (rowTiles x 1 tiles) and a block-column panel of B (1 x colTiles)
+        // for one k-tile, copied out of the mappings into contiguous matrices.
+        struct Panel {
+            Matrix a;
+            Matrix b;
+        };
+
+        void loadPanel(const TiledMatrixFile& a, const TiledMatrixFile& b, Index ti, Index tj,
+                       Index rowTiles, Index colTiles, Index p, Panel& panel) {
+            const Index t = a.tileSize();
+            panel.a.resize(rowTiles * t, t);
+            panel.b.resize(t, colTiles * t);
+            for (Index r = 0; r < rowTiles; ++r) {
+                const float* tile = a.tile(ti + r, p);
+                for (Index j = 0; j < t; ++j) {
+                    std::memcpy(panel.a.data() + r * t + j * panel.a.outerStride(), tile + j * t, t * sizeof(float));
+                }
+            }
+            for (Index s = 0; s < colTiles; ++s) {
+                std::memcpy(panel.b.data() + s * t * t, b.tile(p, tj + s), t * t * sizeof(float));
+            }
+            a.evict(ti, p, rowTiles, 1);
+            b.evict(p, tj, 1, colTiles);
+        }
+
+        void storeBlock(const Matrix& block, TiledMatrixFile& c, Index ti, Index tj, Index rowTiles, Index colTiles) {
+            const Index t = c.tileSize();
+            for (Index s = 0; s < colTiles; ++s) {
+                for (Index r = 0; r < rowTiles; ++r) {
+                    float* tile = c.tile(ti + r, tj + s);
+                    for (Index j = 0; j < t; ++j) {
+                        std::memcpy(tile + j * t, block.data() + r * t + (s * t + j) * block.outerStride(), t * sizeof(float));
+                    }
+                }
+            }
+            c.evict(ti, tj, rowTiles, colTiles);
+        }
+    }
+
+    OutOfCoreMultiplier::OutOfCoreMultiplier(IMultiplier& backend, std::size_t memoryBudgetBytes)
+        : backend_(backend), memoryBudgetBytes_(memoryBudgetBytes) {}
+
+    void OutOfCoreMultiplier::multiply(const TiledMatrixFile& a, const TiledMatrixFile& b, TiledMatrixFile& c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        if (a.tileSize() != b.tileSize() || a.tileSize() != c.tileSize()) {
+            Logger::getInstance().log(LogLevel::Error, "Out-of-core operands use different tile sizes.");
+            throw std::invalid_argument("Out-of-core operands must share one tile size.");
+        }
+
+        const Index t = a.tileSize();
+        const Index tilesM = a.tileRowCount(), tilesN = b.tileColCount(), tilesK = a.tileColCount();
+        const std::size_t tileBytes = static_cast<std::size_t>(t * t) * sizeof(float);
+        const std::size_t budgetTiles = std::max<std::size_t>(memoryBudgetBytes_ / tileBytes, 1);
+
+        // Resident tiles for an R x S block of C: R * S for C, two buffered A and B panels
+        // (2R + 2S) and the panel currently paged in (R + S). Grow R and S together while it fits.
+        auto residentTiles = [](Index r, Index s) { return static_cast<std::size_t>(r * s + 3 * r + 3 * s); };
+        Index rowTiles = 1, colTiles = 1;
+        for (bool grew = true; grew;) {
+            grew = false;
+            if (rowTiles < tilesM && (rowTiles <= colTiles || colTiles == tilesN) && residentTiles(rowTiles + 1, colTiles) <= budgetTiles) {
+                ++rowTiles;
+                grew = true;
+            }
+            if (colTiles < tilesN && (colTiles < rowTiles || rowTiles == tilesM) && residentTiles(rowTiles, colTiles + 1) <= budgetTiles) {
+                ++colTiles;
+                grew = true;
+            }
+        }
+        if (residentTiles(rowTiles, colTiles) > budgetTiles) {
+            Logger::getInstance().log(LogLevel::Warning, "Out-of-core memory budget is below the minimum of {} MiB for tile size {}.",
+                                      residentTiles(1, 1) * tileBytes >> 20, t);
+        }
+        Logger::getInstance().log(LogLevel::Info, "Out-of-core multiply: {}x{}x{} tiles of {}, C blocks of {}x{} tiles, about {} MiB resident.",
+                                  tilesM, tilesN, tilesK, t, rowTiles, colTiles, residentTiles(rowTiles, colTiles) * tileBytes >> 20);
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        double waitSeconds = 0.0;
+
+        Matrix block;
+        Panel panels[2];
+        for (Index tj = 0; tj < tilesN; tj += colTiles) {
+            const Index cols = std::min(colTiles, tilesN - tj);
+            for (Index ti = 0; ti < tilesM; ti += rowTiles) {
+                const Index rows = std::min(rowTiles, tilesM - ti);
+                block.resize(rows * t, cols * t);
+                if (tilesK == 0) {
+                    block.setZero();
+                    storeBlock(block, c, ti, tj, rows, cols);
+                    continue;
+                }
+
+                a.prefetch(ti, 0, rows, 1);
+                b.prefetch(0, tj, 1, cols);
+                std::future<void> next = std::async(std::launch::async, loadPanel, std::cref(a), std::cref(b),
+                                                    ti, tj, rows, cols, Index(0), std::ref(panels[0]));
+                for (Index p = 0; p < tilesK; ++p) {
+                    std::chrono::high_resolution_clock::time_point waitStart = std::chrono::high_resolution_clock::now();
+                    next.get();
+                    waitSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - waitStart).count();
+
+                    // Load p + 1 while computing p, and let the kernel read ahead p + 2.
+                    if (p + 1 < tilesK) {
+                        next = std::async(std::launch::async, loadPanel, std::cref(a), std::cref(b),
+                                          ti, tj, rows, cols, p + 1, std::ref(panels[(p + 1) % 2]));
+                    }
+                    if (p + 2 < tilesK) {
+                        a.prefetch(ti, p + 2, rows, 1);
+                        b.prefetch(p + 2, tj, 1, cols);
+                    }
+
+                    const Panel& panel = panels[p % 2];
+                    backend_.gemm(1.0f, panel.a, panel.b, p == 0 ? 0.0f : 1.0f, block);
+                }
+                storeBlock(block, c, ti, tj, rows, cols);
+            }
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "Out-of-core multiplication complete in -> {} milliseconds ({} ms waiting on I/O).",
+                                  tm_duration, static_cast<long long>(waitSeconds * 1000));
+    }
+
+} // namespace MatrixTransform
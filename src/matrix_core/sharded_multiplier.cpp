@@ -0,0 +1,392 @@
+#include <Eigen/Dense>
+#include "logger.hpp"
+#include "sharded_multiplier.hpp"
+#include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
+#include "shard_protocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("SHARDED", ShardedMultiplier)
+
+    namespace {
+        constexpr int DefaultWorkers = 2;
+        // Below this many flops the round trips cost more than the product; run it in-process.
+        constexpr double MinShardedFlops = 2.0 * 256 * 256 * 256;
+        constexpr std::size_t SegmentAlignment = std::size_t(2) << 20;
+
+        std::size_t alignUp(std::size_t bytes, std::size_t alignment) {
+            return (bytes + alignment - 1) / alignment * alignment;
+        }
+
+        // matrix_worker is built next to libmatrix_core; find the library this code was
+        // loaded from.
+        std::string defaultWorkerPath() {
+            Dl_info info{};
+            if (dladdr(reinterpret_cast<void*>(&defaultWorkerPath), &info) != 0 && info.dli_fname != nullptr) {
+                const std::string library = info.dli_fname;
+                const std::size_t slash = library.rfind('/');
+                if (slash != std::string::npos) {
+                    return library.substr(0, slash) + "/matrix_worker";
+                }
+            }
+            return "matrix_worker";
+        }
+
+        std::string levelName(LogLevel level) {
+            switch (level) {
+                case LogLevel::Debug:   return "debug";
+                case LogLevel::Info:    return "info";
+                case LogLevel::Warning: return "warning";
+                case LogLevel::Error:   return "error";
+                case LogLevel::None:    return "none";
+            }
+            return "warning";
+        }
+    }
+
+    ShardedMultiplier::ShardedMultiplier() : workerCount_(DefaultWorkers) {}
+
+    ShardedMultiplier::~ShardedMultiplier() {
+        stopWorkers();
+        releaseSegment();
+    }
+
+    Matrix ShardedMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void ShardedMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void ShardedMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        const Eigen::Index m = a.rows(), n = b.cols(), k = a.cols();
+        if (2.0 * m * n * k < MinShardedFlops) {
+            if (!local_) {
+                local_ = MultiplierRegistry::getInstance().createMultiplier(workerBackend_);
+            }
+            local_->gemm(alpha, a, b, beta, c);
+            return;
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        if (workers_.empty()) {
+            startWorkers();
+        }
+        const std::size_t aOffset = 0;
+        const std::size_t bOffset = aOffset + alignUp(sizeof(float) * m * k, 4096);
+        const std::size_t cOffset = bOffset + alignUp(sizeof(float) * k * n, 4096);
+        reserveSegment(cOffset + sizeof(float) * m * n);
+
+        // The segment holds packed column-major copies, whatever the callers' layouts.
+        char* base = static_cast<char*>(segment_);
+        Eigen::Map<Matrix>(reinterpret_cast<float*>(base + aOffset), m, k) = a.map();
+        Eigen::Map<Matrix>(reinterpret_cast<float*>(base + bOffset), k, n) = b.map();
+        Eigen::Map<Matrix> product(reinterpret_cast<float*>(base + cOffset), m, n);
+
+        double baseline = 0.0;
+        if (measureBaseline_) {
+            const auto shape = std::make_tuple(m, n, k);
+            auto it = baselineSeconds_.find(shape);
+            if (it == baselineSeconds_.end()) {
+                std::chrono::high_resolution_clock::time_point single = std::chrono::high_resolution_clock::now();
+                run({{0, m, 0, n}}, k, alpha, 0.0f, aOffset, bOffset, cOffset, m);
+                const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - single).count();
+                it = baselineSeconds_.emplace(shape, seconds).first;
+                start = std::chrono::high_resolution_clock::now();
+            }
+            baseline = it->second;
+        }
+        if (beta != 0.0f) {
+            product = c.map();
+        }
+
+        const std::vector<Shard> shards = partition(m, n);
+        const double slowest = run(shards, k, alpha, beta, aOffset, bOffset, cOffset, m);
+        c.map() = product;
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        if (baseline > 0.0) {
+            Logger::getInstance().log(LogLevel::Info, "Sharded multiplication complete in -> {} milliseconds ({} workers, slowest shard {} ms, "
+                                      "scaling efficiency {}% against one worker taking {} ms).", tm_duration, shards.size(),
+                                      static_cast<long>(slowest * 1e3), 100.0 * baseline / (seconds * shards.size()),
+                                      static_cast<long>(baseline * 1e3));
+        } else {
+            Logger::getInstance().log(LogLevel::Info, "Sharded multiplication complete in -> {} milliseconds ({} workers, slowest shard {} ms).",
+                                      tm_duration, shards.size(), static_cast<long>(slowest * 1e3));
+        }
+    }
+
+    void ShardedMultiplier::configure(const nlohmann::json& options) {
+        const int workers = std::max(1, options.value("workers", DefaultWorkers));
+        const int threadsPerWorker = std::max(0, options.value("threads_per_worker", 0));
+        const std::string workerBackend = options.value("worker_backend", std::string("AUTO"));
+        const std::string workerPath = options.value("worker_path", std::string());
+        if (workerBackend == "SHARDED") {
+            throw std::invalid_argument("SHARDED: worker_backend cannot be SHARDED.");
+        }
+
+        if (workers != workerCount_ || threadsPerWorker != threadsPerWorker_ ||
+            workerBackend != workerBackend_ || workerPath != workerPath_) {
+            stopWorkers();
+            baselineSeconds_.clear();
+        }
+        if (workerBackend != workerBackend_) {
+            local_.reset();
+        }
+        workerCount_ = workers;
+        threadsPerWorker_ = threadsPerWorker;
+        workerBackend_ = workerBackend;
+        workerPath_ = workerPath;
+        measureBaseline_ = options.value("measure_baseline", false);
+    }
+
+    void ShardedMultiplier::startWorkers() {
+        const std::string path = workerPath_.empty() ? defaultWorkerPath() : workerPath_;
+        if (access(path.c_str(), X_OK) != 0) {
+            throw std::runtime_error("SHARDED: worker executable " + path + " not found.");
+        }
+
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        const int threads = threadsPerWorker_ > 0 ? threadsPerWorker_ : std::max(1, static_cast<int>(cores) / workerCount_);
+
+        std::vector<std::string> environment;
+        for (char** entry = environ; *entry != nullptr; ++entry) {
+            if (std::strncmp(*entry, "OMP_NUM_THREADS=", 16) != 0) {
+                environment.emplace_back(*entry);
+            }
+        }
+        environment.push_back("OMP_NUM_THREADS=" + std::to_string(threads));
+        std::vector<char*> envp;
+        for (std::string& entry : environment) {
+            envp.push_back(&entry[0]);
+        }
+        envp.push_back(nullptr);
+
+        std::vector<std::string> arguments = {path, "--fd", "3", "--backend", workerBackend_,
+                                              "--log-level", levelName(Logger::getInstance().level())};
+        std::vector<char*> argv;
+        for (std::string& argument : arguments) {
+            argv.push_back(&argument[0]);
+        }
+        argv.push_back(nullptr);
+
+        for (int w = 0; w < workerCount_; ++w) {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0) {
+                stopWorkers();
+                throw std::runtime_error("SHARDED: socketpair failed: " + std::string(std::strerror(errno)));
+            }
+
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_adddup2(&actions, fds[1], 3);
+            pid_t pid = -1;
+            const int error = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv.data(), envp.data());
+            posix_spawn_file_actions_destroy(&actions);
+            close(fds[1]);
+            if (error != 0) {
+                close(fds[0]);
+                stopWorkers();
+                throw std::runtime_error("SHARDED: could not start " + path + ": " + std::strerror(error));
+            }
+            workers_.push_back({pid, fds[0]});
+
+            // Workers report once their backend is constructed.
+            ShardProtocol::Reply hello{};
+            if (!ShardProtocol::receive(fds[0], hello) || hello.status != 0) {
+                const std::string reason = hello.status != 0 ? std::string(hello.message) : "worker exited during startup";
+                stopWorkers();
+                throw std::runtime_error("SHARDED: " + reason);
+            }
+        }
+
+        Logger::getInstance().log(LogLevel::Info, "SHARDED: started {} {} workers with {} threads each.", workerCount_, workerBackend_, threads);
+    }
+
+    void ShardedMultiplier::stopWorkers() {
+        ShardProtocol::Request shutdown{};
+        shutdown.version = ShardProtocol::Version;
+        shutdown.op = ShardProtocol::Op::Shutdown;
+        for (Worker& worker : workers_) {
+            ShardProtocol::send(worker.socket, shutdown);
+            close(worker.socket);
+        }
+        for (Worker& worker : workers_) {
+            while (waitpid(worker.pid, nullptr, 0) < 0 && errno == EINTR) {
+            }
+        }
+        workers_.clear();
+        // New workers have not mapped the current segment.
+        releaseSegment();
+    }
+
+    void ShardedMultiplier::reserveSegment(std::size_t bytes) {
+        if (bytes <= segmentBytes_) {
+            return;
+        }
+        releaseSegment();
+
+        const std::size_t size = alignUp(bytes, SegmentAlignment);
+        const std::string name = "/matrix_sharded." + std::to_string(getpid()) + "." + std::to_string(segmentGeneration_++);
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("SHARDED: shm_open " + name + " failed: " + std::strerror(errno));
+        }
+        void* mapping = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+            mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        const int mapError = errno;
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            throw std::runtime_error("SHARDED: could not map " + std::to_string(size) + " bytes of shared memory: " + std::strerror(mapError));
+        }
+        segment_ = mapping;
+        segmentBytes_ = size;
+
+        ShardProtocol::Request attach{};
+        attach.version = ShardProtocol::Version;
+        attach.op = ShardProtocol::Op::Attach;
+        std::strncpy(attach.segment, name.c_str(), sizeof(attach.segment) - 1);
+        attach.segmentBytes = size;
+        bool attached = true;
+        for (Worker& worker : workers_) {
+            attached = attached && ShardProtocol::send(worker.socket, attach);
+        }
+        std::string failure;
+        for (Worker& worker : workers_) {
+            ShardProtocol::Reply reply{};
+            if (!attached || !ShardProtocol::receive(worker.socket, reply)) {
+                attached = false;
+                break;
+            }
+            if (reply.status != 0) {
+                failure = reply.message;
+            }
+        }
+        // Every worker holds its own mapping now; nothing is left behind in /dev/shm.
+        shm_unlink(name.c_str());
+
+        if (!attached || !failure.empty()) {
+            stopWorkers();
+            throw std::runtime_error("SHARDED: workers could not attach the shared segment" + (failure.empty() ? "." : ": " + failure));
+        }
+        Logger::getInstance().log(LogLevel::Debug, "SHARDED: shared segment {} is {} MiB.", name, size >> 20);
+    }
+
+    void ShardedMultiplier::releaseSegment() {
+        if (segment_ != nullptr) {
+            munmap(segment_, segmentBytes_);
+        }
+        segment_ = nullptr;
+        segmentBytes_ = 0;
+    }
+
+    std::vector<ShardedMultiplier::Shard> ShardedMultiplier::partition(Eigen::Index m, Eigen::Index n) const {
+        // Worker (i, j) reads k * (rows + cols) operand floats; choose the factorization of the
+        // worker count that keeps blocks closest to square.
+        Eigen::Index gridRows = 1;
+        double bestVolume = -1.0;
+        for (Eigen::Index pr = 1; pr <= workerCount_; ++pr) {
+            if (workerCount_ % pr != 0) {
+                continue;
+            }
+            const Eigen::Index pc = workerCount_ / pr;
+            const double volume = double((m + pr - 1) / pr) + double((n + pc - 1) / pc);
+            if (bestVolume < 0.0 || volume < bestVolume) {
+                bestVolume = volume;
+                gridRows = pr;
+            }
+        }
+        const Eigen::Index gridCols = workerCount_ / gridRows;
+
+        std::vector<Shard> shards;
+        for (Eigen::Index j = 0; j < gridCols; ++j) {
+            for (Eigen::Index i = 0; i < gridRows; ++i) {
+                const Eigen::Index row = i * m / gridRows, rowEnd = (i + 1) * m / gridRows;
+                const Eigen::Index col = j * n / gridCols, colEnd = (j + 1) * n / gridCols;
+                if (rowEnd > row && colEnd > col) {
+                    shards.push_back({row, rowEnd - row, col, colEnd - col});
+                }
+            }
+        }
+        return shards;
+    }
+
+    double ShardedMultiplier::run(const std::vector<Shard>& shards, Eigen::Index k, float alpha, float beta,
+                                  std::size_t aOffset, std::size_t bOffset, std::size_t cOffset, Eigen::Index m) {
+        bool delivered = true;
+        for (std::size_t s = 0; s < shards.size(); ++s) {
+            const Shard& shard = shards[s];
+            ShardProtocol::Request request{};
+            request.version = ShardProtocol::Version;
+            request.op = ShardProtocol::Op::Gemm;
+            request.m = shard.rows;
+            request.n = shard.cols;
+            request.k = k;
+            request.aOffset = aOffset + sizeof(float) * shard.row;
+            request.bOffset = bOffset + sizeof(float) * shard.col * k;
+            request.cOffset = cOffset + sizeof(float) * (shard.row + shard.col * m);
+            request.lda = m;
+            request.ldb = k;
+            request.ldc = m;
+            request.alpha = alpha;
+            request.beta = beta;
+            delivered = delivered && ShardProtocol::send(workers_[s].socket, request);
+        }
+
+        double slowest = 0.0;
+        std::string failure;
+        for (std::size_t s = 0; s < shards.size() && delivered; ++s) {
+            ShardProtocol::Reply reply{};
+            if (!ShardProtocol::receive(workers_[s].socket, reply)) {
+                delivered = false;
+                break;
+            }
+            if (reply.status != 0) {
+                failure = reply.message;
+            }
+            slowest = std::max(slowest, reply.seconds);
+        }
+
+        if (!delivered) {
+            stopWorkers();
+            Logger::getInstance().log(LogLevel::Error, "SHARDED: lost contact with a worker; workers will be restarted.");
+            throw std::runtime_error("SHARDED: worker process exited.");
+        }
+        if (!failure.empty()) {
+            Logger::getInstance().log(LogLevel::Error, "SHARDED: worker failed: {}", failure);
+            throw std::runtime_error("SHARDED: " + failure);
+        }
+        return slowest;
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,76 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sys/types.h>
+#include "matrix_transform/interfaces.hpp"
+#include "configurable.hpp"
+
+namespace MatrixTransform {
+
+    // Splits C into a 2D grid of blocks, one per local matrix_worker process. Worker (i, j)
+    // computes block (i, j) from row panel i of A and column panel j of B. Operands are
+    // written once into a POSIX shared memory segment that every worker maps, so the socket
+    // carries only offsets and timings. Workers are started on first use and live as long as
+    // the multiplier.
+    //
+    // Options:
+    // - "workers": process count.
+    // - "worker_backend": registry key each worker runs ("AUTO").
+    // - "threads_per_worker": OpenMP threads per worker (0 splits the cores evenly).
+    // - "worker_path": matrix_worker executable (default: next to libmatrix_core).
+    // - "measure_baseline": time each new shape on a single worker once, so calls can log
+    //   the scaling efficiency against one process.
+    class ShardedMultiplier : public IMultiplier, public IConfigurable {
+    public:
+        ShardedMultiplier();
+        ~ShardedMultiplier() override;
+
+        ShardedMultiplier(const ShardedMultiplier&) = delete;
+        ShardedMultiplier& operator=(const ShardedMultiplier&) = delete;
+
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        void configure(const nlohmann::json& options) override;
+
+    private:
+        struct Worker {
+            pid_t pid = -1;
+            int socket = -1;
+        };
+
+        struct Shard {
+            Eigen::Index row, rows, col, cols;
+        };
+
+        void startWorkers();
+        void stopWorkers();
+        void reserveSegment(std::size_t bytes);
+        void releaseSegment();
+        std::vector<Shard> partition(Eigen::Index m, Eigen::Index n) const;
+        // Sends one Gemm request per shard (shard s to worker s) and returns the slowest
+        // worker's backend time.
+        double run(const std::vector<Shard>& shards, Eigen::Index k, float alpha, float beta,
+                   std::size_t aOffset, std::size_t bOffset, std::size_t cOffset, Eigen::Index m);
+
+        int workerCount_;
+        int threadsPerWorker_ = 0;
+        std::string workerBackend_ = "AUTO";
+        std::string workerPath_;
+        bool measureBaseline_ = false;
+
+        std::vector<Worker> workers_;
+        std::unique_ptr<IMultiplier> local_;
+        void* segment_ = nullptr;
+        std::size_t segmentBytes_ = 0;
+        unsigned segmentGeneration_ = 0;
+        std::map<std::tuple<Eigen::Index, Eigen::Index, Eigen::Index>, double> baselineSeconds_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,34 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "matrix_transform/interfaces.hpp"
+#include "configurable.hpp"
+
+namespace MatrixTransform {
+
+    // Routes each product to SPARSE or to a dense backend by the density of A. Dense operands
+    // are sampled rather than scanned in full. Options: "density_threshold" (fraction of
+    // nonzeros below which SPARSE is used) and "dense_backend" (registry key, "AUTO" default).
+    class SparseAutoMultiplier : public IMultiplier, public IConfigurable {
+    public:
+        SparseAutoMultiplier();
+
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        Matrix multiply(const SparseMatrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        void configure(const nlohmann::json& options) override;
+
+    private:
+        IMultiplier& select(double density);
+
+        double densityThreshold_;
+        std::string denseBackend_;
+        std::unique_ptr<IMultiplier> sparse_;
+        std::unique_ptr<IMultiplier> dense_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,29 @@
+#pragma once
+#include "matrix_transform/interfaces.hpp"
+#include "workspace.hpp"
+
+namespace MatrixTransform {
+
+    // CSR sparse-times-dense backend. Dense left operands are compressed on every call, so
+    // it only pays off when A is mostly zeros; SPARSE_AUTO makes that decision per product.
+    class SparseMultiplier : public IMultiplier {
+    public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        Matrix multiply(const SparseMatrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        // A is compressed once; each tile runs the CSR kernel on its rows of A and columns of B.
+        std::future<Matrix> multiplyAsync(Matrix a, Matrix b) override;
+
+    private:
+        void run(float alpha, const SparseMatrix& a, ConstMatrixView b, float beta, MatrixView c);
+
+        SparseMatrix compressed_;
+        Matrix stagedB_;
+        Workspace workspace_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,294 @@
+#include <Eigen/Dense>
+#include "logger.hpp"
+#include "strassen_multiplier.hpp"
+#include "backend_plugin.hpp"
+#include "blocked_gemm.hpp"
+#include "matrix_views.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MatrixTransform {
+
+    MATRIX_TRANSFORM_BACKEND("STRASSEN", StrassenMultiplier)
+
+    namespace {
+        using Kernels::Index;
+
+        constexpr int ErrorSamples = 32;
+
+        struct Product {
+            const float* a;
+            Index lda;
+            const float* b;
+            Index ldb;
+            float* c;
+            Index ldc;
+        };
+
+        bool inParallel() {
+#ifdef _OPENMP
+            return omp_in_parallel() != 0;
+#else
+            return false;
+#endif
+        }
+
+        // Scratch floats for one level and everything below it: S1..S4, T1..T4 and the three
+        // products that do not fit in a quadrant of C, plus one child arena per concurrently
+        // running sub-product.
+        std::size_t arenaSize(Index m, Index n, Index k, int depth, int taskDepth) {
+            if (depth == 0) {
+                return 0;
+            }
+            const std::size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+            const std::size_t temps = 4 * m2 * k2 + 4 * k2 * n2 + 3 * m2 * n2;
+            return temps + (taskDepth > 0 ? 7 : 1) * arenaSize(m / 2, n / 2, k / 2, depth - 1, taskDepth - 1);
+        }
+
+        // dst = x + sign * y for m x n column-major blocks.
+        void addBlocks(Index m, Index n, const float* x, Index ldx, const float* y, Index ldy, float sign,
+                       float* dst, Index ldd) {
+            #pragma omp parallel for schedule(static) if(!inParallel())
+            for (Index j = 0; j < n; ++j) {
+                for (Index i = 0; i < m; ++i) {
+                    dst[i + j * ldd] = x[i + j * ldx] + sign * y[i + j * ldy];
+                }
+            }
+        }
+
+        void leafProduct(Index m, Index n, Index k, const Product& p) {
+            thread_local Workspace workspace;
+            // Inside a task team every leaf is single-threaded; otherwise it uses all threads.
+            Kernels::blockedGemm(Kernels::selectMicroKernel(), m, n, k,
+                                 1.0f, p.a, 1, p.lda, p.b, 1, p.ldb,
+                                 0.0f, p.c, p.ldc, workspace, inParallel() ? 1 : 0);
+        }
+
+        // C = A * B with Winograd's schedule; m, n and k are divisible by 2^depth.
+        void strassen(Index m, Index n, Index k, const Product& p, float* arena, int depth, int taskDepth) {
+            if (depth == 0) {
+                leafProduct(m, n, k, p);
+                return;
+            }
+
+            const Index m2 = m / 2, n2 = n / 2, k2 = k / 2;
+            const float* a11 = p.a;
+            const float* a21 = p.a + m2;
+            const float* a12 = p.a + k2 * p.lda;
+            const float* a22 = p.a + m2 + k2 * p.lda;
+            const float* b11 = p.b;
+            const float* b21 = p.b + k2;
+            const float* b12 = p.b + n2 * p.ldb;
+            const float* b22 = p.b + k2 + n2 * p.ldb;
+            float* c11 = p.c;
+            float* c21 = p.c + m2;
+            float* c12 = p.c + n2 * p.ldc;
+            float* c22 = p.c + m2 + n2 * p.ldc;
+
+            float* s1 = arena;
+            float* s2 = s1 + m2 * k2;
+            float* s3 = s2 + m2 * k2;
+            float* s4 = s3 + m2 * k2;
+            float* t1 = s4 + m2 * k2;
+            float* t2 = t1 + k2 * n2;
+            float* t3 = t2 + k2 * n2;
+            float* t4 = t3 + k2 * n2;
+            float* p2 = t4 + k2 * n2;
+            float* p6 = p2 + m2 * n2;
+            float* p7 = p6 + m2 * n2;
+            float* child = p7 + m2 * n2;
+
+            addBlocks(m2, k2, a21, p.lda, a22, p.lda, 1.0f, s1, m2);
+            addBlocks(m2, k2, s1, m2, a11, p.lda, -1.0f, s2, m2);
+            addBlocks(m2, k2, a11, p.lda, a21, p.lda, -1.0f, s3, m2);
+            addBlocks(m2, k2, a12, p.lda, s2, m2, -1.0f, s4, m2);
+            addBlocks(k2, n2, b12, p.ldb, b11, p.ldb, -1.0f, t1, k2);
+            addBlocks(k2, n2, b22, p.ldb, t1, k2, -1.0f, t2, k2);
+            addBlocks(k2, n2, b22, p.ldb, b12, p.ldb, -1.0f, t3, k2);
+            addBlocks(k2, n2, t2, k2, b21, p.ldb, -1.0f, t4, k2);
+
+            // P1, P3, P4 and P5 land directly in the quadrants of C that the final pass rewrites.
+            const Product products[7] = {
+                {a11, p.lda, b11, p.ldb, c11, p.ldc},
+                {a12, p.lda, b21, p.ldb, p2, m2},
+                {s4, m2, b22, p.ldb, c12, p.ldc},
+                {a22, p.lda, t4, k2, c21, p.ldc},
+                {s1, m2, t1, k2, c22, p.ldc},
+                {s2, m2, t2, k2, p6, m2},
+                {s3, m2, t3, k2, p7, m2},
+            };
+            const std::size_t childSize = arenaSize(m2, n2, k2, depth - 1, taskDepth - 1);
+            if (taskDepth > 0 && inParallel()) {
+                for (int i = 0; i < 7; ++i) {
+                    #pragma omp task firstprivate(i)
+                    strassen(m2, n2, k2, products[i], child + i * childSize, depth - 1, taskDepth - 1);
+                }
+                #pragma omp taskwait
+            } else {
+                for (int i = 0; i < 7; ++i) {
+                    strassen(m2, n2, k2, products[i], child, depth - 1, taskDepth - 1);
+                }
+            }
+
+            #pragma omp parallel for schedule(static) if(!inParallel())
+            for (Index j = 0; j < n2; ++j) {
+                for (Index i = 0; i < m2; ++i) {
+                    const Index c = i + j * p.ldc, t = i + j * m2;
+                    const float u2 = c11[c] + p6[t];
+                    const float u3 = u2 + p7[t];
+                    const float u4 = u2 + c22[c];
+                    c11[c] += p2[t];
+                    c12[c] += u4;
+                    c21[c] = u3 - c21[c];
+                    c22[c] += u3;
+                }
+            }
+        }
+
+        // Worst |strassen - exact| / sum |a_ip * b_pj| over a fixed-seed sample of entries.
+        double sampledError(ConstMatrixView a, ConstMatrixView b, const float* c, Index ldc) {
+            std::minstd_rand rng(7);
+            std::uniform_int_distribution<Index> row(0, a.rows() - 1), col(0, b.cols() - 1);
+            double worst = 0.0;
+            for (int s = 0; s < ErrorSamples; ++s) {
+                const Index i = row(rng), j = col(rng);
+                double exact = 0.0, magnitude = 0.0;
+                for (Index p = 0; p < a.cols(); ++p) {
+                    const double term = static_cast<double>(a(i, p)) * b(p, j);
+                    exact += term;
+                    magnitude += std::abs(term);
+                }
+                if (magnitude > 0.0) {
+                    worst = std::max(worst, std::abs(c[i + j * ldc] - exact) / magnitude);
+                }
+            }
+            return worst;
+        }
+    }
+
+    Matrix StrassenMultiplier::multiply(const Matrix& a, const Matrix& b) {
+        Matrix c(a.rows(), b.cols());
+        gemm(1.0f, a, b, 0.0f, c);
+        return c;
+    }
+
+    void StrassenMultiplier::gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) {
+        gemm(alpha, ConstMatrixView(a), ConstMatrixView(b), beta, MatrixView(c));
+    }
+
+    void StrassenMultiplier::gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) {
+        Logger::getInstance().log(LogLevel::Debug, "Starting STRASSEN multiplication.");
+
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        const Index m = a.rows(), n = b.cols(), k = a.cols();
+        int depth = 0;
+        for (Index mm = m, nn = n, kk = k; std::min({mm, nn, kk}) > cutoff_; mm = (mm + 1) / 2, nn = (nn + 1) / 2, kk = (kk + 1) / 2) {
+            ++depth;
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        if (depth == 0) {
+            withColumnMajorOutput(a, b, beta, c, [&](ConstMatrixView lhs, ConstMatrixView rhs, float* out, Index ldc) {
+                Kernels::blockedGemm(Kernels::selectMicroKernel(), lhs.rows(), rhs.cols(), lhs.cols(),
+                                     alpha, lhs.data(), lhs.rowStride(), lhs.colStride(),
+                                     rhs.data(), rhs.rowStride(), rhs.colStride(),
+                                     beta, out, ldc, arena_);
+            });
+        } else {
+            const Index unit = Index(1) << depth;
+            const Index mp = (m + unit - 1) / unit * unit;
+            const Index np = (n + unit - 1) / unit * unit;
+            const Index kp = (k + unit - 1) / unit * unit;
+            int threads = 1;
+#ifdef _OPENMP
+            threads = omp_get_max_threads();
+#endif
+            const int taskDepth = threads > 1 ? taskDepth_ : 0;
+
+            // Slots: 0 padded A, 1 padded B, 2 the padded product, 3 the recursion temporaries.
+            // Operands that are not column-major are copied in the same pass as the padding.
+            Product top{a.data(), a.colStride(), b.data(), b.colStride(), nullptr, mp};
+            if (mp != m || kp != k || !a.isColumnMajor()) {
+                Eigen::Map<Matrix> padded(arena_.acquire(0, static_cast<std::size_t>(mp * kp)), mp, kp);
+                padded.setZero();
+                padded.topLeftCorner(m, k) = a.map();
+                top.a = padded.data();
+                top.lda = mp;
+            }
+            if (kp != k || np != n || !b.isColumnMajor()) {
+                Eigen::Map<Matrix> padded(arena_.acquire(1, static_cast<std::size_t>(kp * np)), kp, np);
+                padded.setZero();
+                padded.topLeftCorner(k, n) = b.map();
+                top.b = padded.data();
+                top.ldb = kp;
+            }
+            top.c = arena_.acquire(2, static_cast<std::size_t>(mp * np));
+            float* temporaries = arena_.acquire(3, arenaSize(mp, np, kp, depth, taskDepth));
+
+            if (taskDepth > 0) {
+                #pragma omp parallel num_threads(threads)
+                #pragma omp single
+                strassen(mp, np, kp, top, temporaries, depth, taskDepth);
+            } else {
+                strassen(mp, np, kp, top, temporaries, depth, 0);
+            }
+
+            const double error = sampledError(a, b, top.c, mp);
+            Eigen::Map<const Matrix> product(top.c, mp, np);
+            MatrixView::StridedMap out = c.map();
+            if (beta == 0.0f) {
+                out = alpha * product.topLeftCorner(m, n);
+            } else {
+                out = alpha * product.topLeftCorner(m, n) + beta * out;
+            }
+
+            Logger::getInstance().log(LogLevel::Info, "STRASSEN depth {}, leaf {}x{}x{}, max sampled error vs classical {}.",
+                                      depth, mp >> depth, np >> depth, kp >> depth, error);
+        }
+
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+        auto tm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        Logger::getInstance().log(LogLevel::Info, "STRASSEN multiplication complete in -> {} milliseconds.", tm_duration);
+    }
+
+    void StrassenMultiplier::configure(const nlohmann::json& options) {
+        cutoff_ = std::max<Eigen::Index>(16, options.value("cutoff", Eigen::Index(1024)));
+        taskDepth_ = std::max(0, options.value("task_depth", 1));
+    }
+
+    IMultiplier::SerialProduct StrassenMultiplier::serialProduct() const {
+        return [](ConstMatrixView a, ConstMatrixView b, MatrixView c) {
+            thread_local Workspace workspace;
+            withColumnMajorOutput(a, b, 0.0f, c, [&](ConstMatrixView lhs, ConstMatrixView rhs, float* out, Index ldc) {
+                Kernels::blockedGemm(Kernels::selectMicroKernel(), lhs.rows(), rhs.cols(), lhs.cols(),
+                                     1.0f, lhs.data(), lhs.rowStride(), lhs.colStride(),
+                                     rhs.data(), rhs.rowStride(), rhs.colStride(),
+                                     0.0f, out, ldc, workspace, 1);
+            });
+        };
+    }
+
+    std::vector<nlohmann::json> StrassenMultiplier::tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const {
+        const Eigen::Index smallest = std::min({m, n, k});
+        std::vector<nlohmann::json> candidates;
+        for (Eigen::Index cutoff : {512, 1024, 2048}) {
+            if (cutoff < smallest) {
+                candidates.push_back({{"cutoff", cutoff}, {"task_depth", taskDepth_}});
+            }
+        }
+        return candidates;
+    }
+    
+} // namespace MatrixTransform
@@ -0,0 +1,34 @@
+#pragma once
+#include "matrix_transform/interfaces.hpp"
+#include "configurable.hpp"
+#include "workspace.hpp"
+
+namespace MatrixTransform {
+
+    // Strassen-Winograd recursion (7 half-size products, 15 additions) for large products,
+    // down to leaf blocks no larger than "cutoff" that run on the fastest blocked kernel.
+    // Operands are zero padded to a multiple of 2^depth. The 7 products of the top
+    // "task_depth" levels run as OpenMP tasks. Each call logs the worst error of sampled
+    // entries against classical dot products.
+    class StrassenMultiplier : public IMultiplier, public IConfigurable {
+    public:
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+        Matrix multiply(const Matrix& a, const Matrix& b) override;
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override;
+        void gemm(float alpha, ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c) override;
+
+        void configure(const nlohmann::json& options) override;
+        std::vector<nlohmann::json> tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const override;
+
+    protected:
+        // Batch entries and async tiles are below any useful cutoff and run as single leaves.
+        SerialProduct serialProduct() const override;
+
+    private:
+        Eigen::Index cutoff_ = 1024;
+        int taskDepth_ = 1;
+        Workspace arena_;
+    };
+
+} // namespace MatrixTransform
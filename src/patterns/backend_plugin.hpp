@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include "logger.hpp"
+#include "multiplier_registry.hpp"
+
+// Versioned C ABI between MultiplierRegistry and backend plugins. A plugin is a module named
+// <prefix>matrix_backend_<KEY><suffix> that exports MATRIX_TRANSFORM_BACKEND_ENTRY. The registry
+// rejects a plugin whose abiVersion or key does not match, and otherwise calls create once per
+// instance: it returns an IMultiplier* owned by the caller, or nullptr when the backend failed
+// to initialize. Plugins link against the same matrix_core and are never unloaded.
+extern "C" {
+    struct MatrixTransformBackend {
+        std::uint32_t abiVersion;
+        const char* key;
+        void* (*create)();
+    };
+
+    typedef const MatrixTransformBackend* (*MatrixTransformBackendEntry)();
+}
+
+#define MATRIX_TRANSFORM_BACKEND_ABI_VERSION 2u
+#define MATRIX_TRANSFORM_BACKEND_ENTRY "matrixTransformBackend"
+
+// Registers Type under key: as the plugin entry point when the file is built into a backend
+// plugin, or through a static MultiplierRegistrar when it is linked into matrix_core.
+#ifdef MATRIX_TRANSFORM_BACKEND_PLUGIN
+
+#if defined(_WIN32)
+#define MATRIX_TRANSFORM_BACKEND_EXPORT __declspec(dllexport)
+#else
+#define MATRIX_TRANSFORM_BACKEND_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define MATRIX_TRANSFORM_BACKEND(key, Type)                                                              \
+    extern "C" MATRIX_TRANSFORM_BACKEND_EXPORT const MatrixTransformBackend* matrixTransformBackend() {  \
+        static const MatrixTransformBackend backend = {                                                  \
+            MATRIX_TRANSFORM_BACKEND_ABI_VERSION, key,                                                   \
+            []() -> void* {                                                                              \
+                try {                                                                                    \
+                    return static_cast<IMultiplier*>(new Type());                                        \
+                } catch (const std::exception& e) {                                                      \
+                    Logger::getInstance().log(LogLevel::Error, "Backend {} failed to initialize: {}", key, e.what()); \
+                    return nullptr;                                                                      \
+                }                                                                                        \
+            }                                                                                            \
+        };                                                                                               \
+        return &backend;                                                                                 \
+    }
+
+#else
+
+#define MATRIX_TRANSFORM_BACKEND(key, Type)                                                              \
+    namespace {                                                                                          \
+        MultiplierRegistrar Type##Registrar(key, []() -> std::unique_ptr<IMultiplier> {                  \
+            return std::make_unique<Type>();                                                             \
+        });                                                                                              \
+    }
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "matrix_transform/matrix_types.hpp"
+
+namespace MatrixTransform {
+
+    // Optional second interface for backends with runtime parameters. The factory applies the
+    // "backend_options" object from the config, and the BEST autotuner sweeps the candidates.
+    class IConfigurable {
+    public:
+        virtual ~IConfigurable() = default;
+
+        virtual void configure(const nlohmann::json& options) = 0;
+
+        // Parameter sets worth timing for an (m x k) * (k x n) product; empty if nothing to tune.
+        virtual std::vector<nlohmann::json> tuningCandidates(Eigen::Index m, Eigen::Index n, Eigen::Index k) const {
+            (void)m; (void)n; (void)k;
+            return {};
+        }
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,306 @@
+#include "matrix_transform/expression.hpp"
+#include "logger.hpp"
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace MatrixTransform {
+
+    struct Expression::Node {
+        enum class Kind { Leaf, Product, Sum };
+
+        Kind kind = Kind::Leaf;
+        float scale = 1.0f;
+        const Matrix* leaf = nullptr;
+        // Product: the chain factors in order, each with scale 1. Sum: the terms.
+        std::vector<std::shared_ptr<const Node>> operands;
+        Eigen::Index rows = 0;
+        Eigen::Index cols = 0;
+    };
+
+    namespace {
+        using NodePtr = std::shared_ptr<const Expression::Node>;
+
+        NodePtr withScale(const NodePtr& node, float scale) {
+            if (scale == 1.0f) {
+                return node;
+            }
+            auto scaled = std::make_shared<Expression::Node>(*node);
+            scaled->scale *= scale;
+            return scaled;
+        }
+
+        NodePtr unscaled(const NodePtr& node) {
+            if (node->scale == 1.0f) {
+                return node;
+            }
+            auto copy = std::make_shared<Expression::Node>(*node);
+            copy->scale = 1.0f;
+            return copy;
+        }
+
+        std::string formatNumber(double value) {
+            std::ostringstream text;
+            text << value;
+            return text.str();
+        }
+
+        std::string describe(const Expression::Node& node) {
+            std::string text;
+            if (node.scale != 1.0f) {
+                text = formatNumber(node.scale) + " * ";
+            }
+            switch (node.kind) {
+                case Expression::Node::Kind::Leaf:
+                    return text + "[" + std::to_string(node.rows) + "x" + std::to_string(node.cols) + "]";
+                case Expression::Node::Kind::Product:
+                    for (std::size_t i = 0; i < node.operands.size(); ++i) {
+                        text += (i ? " * " : "") + describe(*node.operands[i]);
+                    }
+                    return text;
+                case Expression::Node::Kind::Sum:
+                    text += "(";
+                    for (std::size_t i = 0; i < node.operands.size(); ++i) {
+                        text += (i ? " + " : "") + describe(*node.operands[i]);
+                    }
+                    return text + ")";
+            }
+            return text;
+        }
+
+        // Classic O(n^3) matrix-chain order: cost[i][j] is the fewest multiply-adds for
+        // factors i..j, split[i * n + j] the last factor of the left part.
+        double chainOrder(const std::vector<Eigen::Index>& dims, std::vector<std::size_t>& split) {
+            const std::size_t n = dims.size() - 1;
+            std::vector<double> cost(n * n, 0.0);
+            split.assign(n * n, 0);
+            for (std::size_t length = 2; length <= n; ++length) {
+                for (std::size_t i = 0; i + length <= n; ++i) {
+                    const std::size_t j = i + length - 1;
+                    cost[i * n + j] = std::numeric_limits<double>::infinity();
+                    for (std::size_t s = i; s < j; ++s) {
+                        const double candidate = cost[i * n + s] + cost[(s + 1) * n + j] +
+                                                 static_cast<double>(dims[i]) * dims[s + 1] * dims[j + 1];
+                        if (candidate < cost[i * n + j]) {
+                            cost[i * n + j] = candidate;
+                            split[i * n + j] = s;
+                        }
+                    }
+                }
+            }
+            return cost[n - 1];
+        }
+
+        std::string parenthesize(const std::vector<std::size_t>& split, std::size_t n, std::size_t i, std::size_t j) {
+            if (i == j) {
+                return "A" + std::to_string(i);
+            }
+            const std::size_t s = split[i * n + j];
+            return "(" + parenthesize(split, n, i, s) + " " + parenthesize(split, n, s + 1, j) + ")";
+        }
+    }
+
+    Expression::Expression(const Matrix& matrix) {
+        auto node = std::make_shared<Node>();
+        node->leaf = &matrix;
+        node->rows = matrix.rows();
+        node->cols = matrix.cols();
+        node_ = std::move(node);
+    }
+
+    Expression::Expression(std::shared_ptr<const Node> node) : node_(std::move(node)) {}
+
+    Eigen::Index Expression::rows() const { return node_->rows; }
+    Eigen::Index Expression::cols() const { return node_->cols; }
+
+    std::string Expression::toString() const {
+        return describe(*node_);
+    }
+
+    Expression operator*(const Expression& lhs, const Expression& rhs) {
+        if (lhs.cols() != rhs.rows()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+
+        auto product = std::make_shared<Expression::Node>();
+        product->kind = Expression::Node::Kind::Product;
+        product->rows = lhs.rows();
+        product->cols = rhs.cols();
+        // Nested products are spliced into one chain; every scale moves onto the chain itself.
+        for (const NodePtr& side : {lhs.node_, rhs.node_}) {
+            product->scale *= side->scale;
+            if (side->kind == Expression::Node::Kind::Product) {
+                product->operands.insert(product->operands.end(), side->operands.begin(), side->operands.end());
+            } else {
+                product->operands.push_back(unscaled(side));
+            }
+        }
+        return Expression(std::move(product));
+    }
+
+    Expression operator*(float scale, const Expression& expression) {
+        return Expression(withScale(expression.node_, scale));
+    }
+
+    Expression operator*(const Expression& expression, float scale) {
+        return scale * expression;
+    }
+
+    Expression operator+(const Expression& lhs, const Expression& rhs) {
+        if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+            Logger::getInstance().log(LogLevel::Error, "Matrix dimension mismatch.");
+            throw std::invalid_argument("Matrix dimensions do not match for addition.");
+        }
+
+        auto sum = std::make_shared<Expression::Node>();
+        sum->kind = Expression::Node::Kind::Sum;
+        sum->rows = lhs.rows();
+        sum->cols = lhs.cols();
+        for (const NodePtr& side : {lhs.node_, rhs.node_}) {
+            if (side->kind == Expression::Node::Kind::Sum) {
+                for (const NodePtr& term : side->operands) {
+                    sum->operands.push_back(withScale(term, side->scale));
+                }
+            } else {
+                sum->operands.push_back(side);
+            }
+        }
+        return Expression(std::move(sum));
+    }
+
+    Expression operator-(const Expression& lhs, const Expression& rhs) {
+        return lhs + (-rhs);
+    }
+
+    Expression operator-(const Expression& expression) {
+        return -1.0f * expression;
+    }
+
+    ExpressionEvaluator::ExpressionEvaluator(IMultiplier& multiplier) : multiplier_(multiplier) {}
+
+    Matrix ExpressionEvaluator::evaluate(const Expression& expression) {
+        Matrix out;
+        evaluate(expression, out);
+        return out;
+    }
+
+    void ExpressionEvaluator::evaluate(const Expression& expression, Matrix& out) {
+        if (Logger::getInstance().enabled(LogLevel::Debug)) {
+            Logger::getInstance().log(LogLevel::Debug, "Evaluating expression {}.", expression.toString());
+        }
+        out.resize(expression.rows(), expression.cols());
+        evaluateInto(*expression.node_, out, 1.0f, 0.0f);
+    }
+
+    // out = alpha * node + beta * out; out is not read when beta == 0.
+    void ExpressionEvaluator::evaluateInto(const Expression::Node& node, Matrix& out, float alpha, float beta) {
+        alpha *= node.scale;
+        switch (node.kind) {
+            case Expression::Node::Kind::Leaf:
+                if (beta == 0.0f) {
+                    out.noalias() = alpha * *node.leaf;
+                } else {
+                    out = alpha * *node.leaf + beta * out;
+                }
+                break;
+            case Expression::Node::Kind::Sum:
+                for (std::size_t i = 0; i < node.operands.size(); ++i) {
+                    evaluateInto(*node.operands[i], out, alpha, i == 0 ? beta : 1.0f);
+                }
+                break;
+            case Expression::Node::Kind::Product:
+                evaluateChain(node, out, alpha, beta);
+                break;
+        }
+    }
+
+    void ExpressionEvaluator::evaluateChain(const Expression::Node& node, Matrix& out, float alpha, float beta) {
+        const std::size_t n = node.operands.size();
+
+        // Leaves are used in place; sums inside a chain are materialized once up front.
+        std::vector<const Matrix*> factors(n);
+        std::vector<Matrix> materialized;
+        std::vector<Eigen::Index> dims(n + 1);
+        dims[0] = node.operands[0]->rows;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Expression::Node& factor = *node.operands[i];
+            dims[i + 1] = factor.cols;
+            if (factor.kind != Expression::Node::Kind::Leaf) {
+                materialized.push_back(acquire(factor.rows, factor.cols));
+                evaluateInto(factor, materialized.back(), 1.0f, 0.0f);
+            }
+        }
+        for (std::size_t i = 0, next = 0; i < n; ++i) {
+            factors[i] = node.operands[i]->kind == Expression::Node::Kind::Leaf ? node.operands[i]->leaf : &materialized[next++];
+        }
+
+        std::vector<std::size_t> split;
+        const double cost = chainOrder(dims, split);
+        if (n > 2 && Logger::getInstance().enabled(LogLevel::Debug)) {
+            double naive = 0.0;
+            for (std::size_t i = 1; i < n; ++i) {
+                naive += static_cast<double>(dims[0]) * dims[i] * dims[i + 1];
+            }
+            Logger::getInstance().log(LogLevel::Debug, "Chain order {}: {} multiply-adds vs {} left to right.",
+                                      parenthesize(split, n, 0, n - 1), formatNumber(cost), formatNumber(naive));
+        }
+
+        evaluateRange(factors, split, 0, n - 1, out, alpha, beta);
+
+        for (Matrix& buffer : materialized) {
+            release(std::move(buffer));
+        }
+    }
+
+    void ExpressionEvaluator::evaluateRange(const std::vector<const Matrix*>& factors, const std::vector<std::size_t>& split,
+                                            std::size_t i, std::size_t j, Matrix& out, float alpha, float beta) {
+        if (i == j) {
+            if (beta == 0.0f) {
+                out.noalias() = alpha * *factors[i];
+            } else {
+                out = alpha * *factors[i] + beta * out;
+            }
+            return;
+        }
+
+        const std::size_t n = factors.size();
+        const std::size_t s = split[i * n + j];
+        Matrix left, right;
+        if (s > i) {
+            left = acquire(factors[i]->rows(), factors[s]->cols());
+            evaluateRange(factors, split, i, s, left, 1.0f, 0.0f);
+        }
+        if (j > s + 1) {
+            right = acquire(factors[s + 1]->rows(), factors[j]->cols());
+            evaluateRange(factors, split, s + 1, j, right, 1.0f, 0.0f);
+        }
+
+        multiplier_.gemm(alpha, s > i ? left : *factors[i], j > s + 1 ? right : *factors[j], beta, out);
+
+        if (s > i) {
+            release(std::move(left));
+        }
+        if (j > s + 1) {
+            release(std::move(right));
+        }
+    }
+
+    Matrix ExpressionEvaluator::acquire(Eigen::Index rows, Eigen::Index cols) {
+        // Same element count means resize() keeps the existing allocation.
+        for (std::size_t i = 0; i < pool_.size(); ++i) {
+            if (pool_[i].size() == rows * cols) {
+                Matrix buffer = std::move(pool_[i]);
+                pool_.erase(pool_.begin() + static_cast<std::ptrdiff_t>(i));
+                buffer.resize(rows, cols);
+                return buffer;
+            }
+        }
+        return Matrix(rows, cols);
+    }
+
+    void ExpressionEvaluator::release(Matrix&& buffer) {
+        pool_.push_back(std::move(buffer));
+    }
+
+} // namespace MatrixTransform
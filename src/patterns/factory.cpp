@@ -5,10 +5,14 @@
 #include "nlohmann/json.hpp"
 #include "logger.hpp"
 #include "multiplier_registry.hpp"
+#include "configurable.hpp"
+#include "tuning_cache.hpp"
+#include "numa.hpp"
+#include "parallel_runtime.hpp"
+#include "matrix_transform/metrics.hpp"
 #include "matrix_transform/interfaces.hpp"
 #include "matrix_transform/factory.hpp"
 
-
 namespace MatrixTransform {
 
     std::unique_ptr<MatrixTransform::IMultiplier> Factory::createMultiplier() {
@@ -32,14 +36,57 @@ namespace MatrixTransform {
             Logger::getInstance().setLevel(logLevelStr);
 
             if (configJson.is_null()) {
-                Logger::getInstance().log(LogLevel::Error, "Failed to parse JSON from " + configFilePath);
+                Logger::getInstance().log(LogLevel::Error, "Failed to parse JSON from {}", configFilePath);
                 throw std::runtime_error("Config file is empty or contains only null.");
             }
 
+            // Thread count, pinning and NUMA placement shared by every parallel backend.
+            if (configJson.contains("parallelism")) {
+                const nlohmann::json& parallelism = configJson["parallelism"];
+                ThreadPlacement& placement = ThreadPlacement::global();
+                placement.pinning = ThreadPlacement::parsePinning(parallelism.value("pinning", "none"));
+                placement.numa = ThreadPlacement::parseNuma(parallelism.value("numa", "off"));
+                ParallelRuntime::getInstance().setThreads(parallelism.value("threads", 0));
+                Logger::getInstance().log(LogLevel::Info, "Parallelism: {} NUMA node(s), pinning {}, NUMA mode {}.",
+                                          NumaTopology::get().nodes().size(), ThreadPlacement::toString(placement.pinning),
+                                          ThreadPlacement::toString(placement.numa));
+            }
+
+            // Loaded after the thread count is applied: the cache is keyed by it. Without a path,
+            // tuning results are kept for this process only.
+            if (configJson.contains("tuning_cache")) {
+                TuningCache::getInstance().load(configJson["tuning_cache"].get<std::string>());
+            }
+
+            // Backend plugins are looked up next to libmatrix_core unless the config names a directory.
+            if (configJson.contains("plugin_dir")) {
+                MultiplierRegistry::getInstance().setPluginDirectory(configJson["plugin_dir"].get<std::string>());
+            }
+
             std::string multiplierType = configJson.value("backend", "CPU");
-            Logger::getInstance().log(LogLevel::Info, "Creating backend: " + multiplierType);
+            Logger::getInstance().log(LogLevel::Info, "Creating backend: {}", multiplierType);
 
             multiplier = MultiplierRegistry::getInstance().createMultiplier(multiplierType);
+
+            if (configJson.contains("backend_options")) {
+                if (auto* configurable = dynamic_cast<IConfigurable*>(multiplier.get())) {
+                    configurable->configure(configJson["backend_options"]);
+                } else {
+                    Logger::getInstance().log(LogLevel::Warning, "Backend {} takes no options; ignoring backend_options.", multiplierType);
+                }
+            }
+
+            // Per-backend call metrics; see MetricsRegistry for the dump formats.
+            if (configJson.contains("metrics") && configJson["metrics"].value("enabled", false)) {
+                const nlohmann::json& metrics = configJson["metrics"];
+                if (metrics.value("hardware_counters", false)) {
+                    const std::uint64_t flopEvent = std::stoull(metrics.value("flop_event", std::string("0")), nullptr, 0);
+                    if (!MetricsRegistry::getInstance().enableHardwareCounters(flopEvent)) {
+                        Logger::getInstance().log(LogLevel::Warning, "perf_event_open is unavailable; recording metrics without hardware counters.");
+                    }
+                }
+                multiplier = instrumentMultiplier(std::move(multiplier), multiplierType);
+            }
         } catch (const std::exception& e) {
             throw std::runtime_error("Error parsing JSON from " + configFilePath + ": " + e.what());
         }
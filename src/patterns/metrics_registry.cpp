@@ -0,0 +1,268 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "nlohmann/json.hpp"
+#include "perf_counters.hpp"
+#include "matrix_transform/metrics.hpp"
+
+namespace MatrixTransform {
+
+    namespace {
+        const char* const OpNames[MetricOpCount] = {"multiply", "gemm", "batch", "async", "sparse", "reduced"};
+        const char* const CounterNames[HardwareCounterCount] = {"cycles", "instructions", "llc_misses", "flop_events", "task_clock_ns"};
+
+        constexpr int FirstBucketShift = 10;
+
+        int latencyBucket(std::uint64_t nanos) {
+            int bucket = 0;
+            while (bucket < BackendMetrics::LatencyBuckets - 1 && nanos > (std::uint64_t(1) << (bucket + FirstBucketShift))) {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        // Exponent of the smallest power of two >= value, capped at 2^31.
+        std::uint32_t ceilLog2(Eigen::Index value) {
+            std::uint32_t shift = 0;
+            while (shift < 31 && (Eigen::Index(1) << shift) < value) {
+                ++shift;
+            }
+            return shift;
+        }
+
+        std::string number(double value) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.9g", value);
+            return text;
+        }
+
+        // Upper bound of the bucket holding the q-quantile; an estimate good to a factor of two.
+        std::uint64_t latencyQuantile(const BackendMetrics::OpCounters& op, std::uint64_t calls, double q) {
+            const double target = q * static_cast<double>(calls);
+            std::uint64_t seen = 0;
+            for (int bucket = 0; bucket < BackendMetrics::LatencyBuckets - 1; ++bucket) {
+                seen += op.latency[bucket].load(std::memory_order_relaxed);
+                if (static_cast<double>(seen) >= target) {
+                    return std::uint64_t(1) << (bucket + FirstBucketShift);
+                }
+            }
+            return std::uint64_t(1) << (BackendMetrics::LatencyBuckets - 1 + FirstBucketShift);
+        }
+    }
+
+    void BackendMetrics::record(MetricOp op, std::uint64_t nanos, std::uint64_t flops, std::uint64_t bytesAllocated,
+                                const std::uint64_t* hardware) {
+        OpCounters& counters = ops_[static_cast<int>(op)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.nanos.fetch_add(nanos, std::memory_order_relaxed);
+        counters.flops.fetch_add(flops, std::memory_order_relaxed);
+        counters.bytesAllocated.fetch_add(bytesAllocated, std::memory_order_relaxed);
+        counters.latency[latencyBucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+        if (hardware != nullptr) {
+            for (int c = 0; c < HardwareCounterCount; ++c) {
+                counters.hardware[c].fetch_add(hardware[c], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void BackendMetrics::recordError(MetricOp op) {
+        ops_[static_cast<int>(op)].errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void BackendMetrics::recordShape(Eigen::Index m, Eigen::Index n, Eigen::Index k, std::uint64_t count) {
+        const std::uint32_t key = (ceilLog2(m) << 16) | (ceilLog2(n) << 8) | ceilLog2(k);
+        std::lock_guard<std::mutex> lock(shapeMutex_);
+        shapes_[key] += count;
+    }
+
+    std::map<std::array<std::uint64_t, 3>, std::uint64_t> BackendMetrics::shapes() const {
+        std::map<std::array<std::uint64_t, 3>, std::uint64_t> rounded;
+        std::lock_guard<std::mutex> lock(shapeMutex_);
+        for (const auto& [key, calls] : shapes_) {
+            rounded[{std::uint64_t(1) << (key >> 16), std::uint64_t(1) << ((key >> 8) & 0xff), std::uint64_t(1) << (key & 0xff)}] = calls;
+        }
+        return rounded;
+    }
+
+    void BackendMetrics::reset() {
+        for (OpCounters& counters : ops_) {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.errors.store(0, std::memory_order_relaxed);
+            counters.nanos.store(0, std::memory_order_relaxed);
+            counters.flops.store(0, std::memory_order_relaxed);
+            counters.bytesAllocated.store(0, std::memory_order_relaxed);
+            for (std::atomic<std::uint64_t>& bucket : counters.latency) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            for (std::atomic<std::uint64_t>& value : counters.hardware) {
+                value.store(0, std::memory_order_relaxed);
+            }
+        }
+        std::lock_guard<std::mutex> lock(shapeMutex_);
+        shapes_.clear();
+    }
+
+    MetricsRegistry& MetricsRegistry::getInstance() {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    BackendMetrics& MetricsRegistry::backend(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<BackendMetrics>& metrics = backends_[name];
+        if (!metrics) {
+            metrics = std::make_unique<BackendMetrics>();
+        }
+        return *metrics;
+    }
+
+    bool MetricsRegistry::enableHardwareCounters(std::uint64_t rawFlopEvent) {
+        return PerfCounters::getInstance().enable(rawFlopEvent);
+    }
+
+    std::string MetricsRegistry::toPrometheus() const {
+        const PerfCounters& perf = PerfCounters::getInstance();
+        std::ostringstream calls, errors, duration, flops, gflops, bytes, hardware, shapes;
+        calls << "# HELP matrix_calls_total Completed calls per backend and entry point.\n# TYPE matrix_calls_total counter\n";
+        errors << "# HELP matrix_errors_total Calls that threw.\n# TYPE matrix_errors_total counter\n";
+        duration << "# HELP matrix_call_duration_seconds Wall time per call.\n# TYPE matrix_call_duration_seconds histogram\n";
+        flops << "# HELP matrix_flops_total Floating-point operations requested (2mnk per product).\n# TYPE matrix_flops_total counter\n";
+        gflops << "# HELP matrix_gflops Average throughput over all calls.\n# TYPE matrix_gflops gauge\n";
+        bytes << "# HELP matrix_allocated_bytes_total Result matrices and scratch buffers allocated during calls.\n# TYPE matrix_allocated_bytes_total counter\n";
+        hardware << "# HELP matrix_hardware_events_total perf_event counters summed over the counted threads.\n# TYPE matrix_hardware_events_total counter\n";
+        shapes << "# HELP matrix_shape_calls_total Products per shape, dimensions rounded up to a power of two.\n# TYPE matrix_shape_calls_total counter\n";
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, metrics] : backends_) {
+            for (int o = 0; o < MetricOpCount; ++o) {
+                const BackendMetrics::OpCounters& op = metrics->op(static_cast<MetricOp>(o));
+                const std::uint64_t count = op.calls.load(std::memory_order_relaxed);
+                const std::uint64_t failed = op.errors.load(std::memory_order_relaxed);
+                if (count == 0 && failed == 0) {
+                    continue;
+                }
+                const std::string labels = "backend=\"" + name + "\",op=\"" + OpNames[o] + "\"";
+                const double seconds = op.nanos.load(std::memory_order_relaxed) * 1e-9;
+                const double work = static_cast<double>(op.flops.load(std::memory_order_relaxed));
+
+                calls << "matrix_calls_total{" << labels << "} " << count << "\n";
+                errors << "matrix_errors_total{" << labels << "} " << failed << "\n";
+                std::uint64_t cumulative = 0;
+                for (int bucket = 0; bucket < BackendMetrics::LatencyBuckets; ++bucket) {
+                    cumulative += op.latency[bucket].load(std::memory_order_relaxed);
+                    const std::string bound = bucket + 1 < BackendMetrics::LatencyBuckets
+                        ? number(static_cast<double>(std::uint64_t(1) << (bucket + FirstBucketShift)) * 1e-9) : "+Inf";
+                    duration << "matrix_call_duration_seconds_bucket{" << labels << ",le=\"" << bound << "\"} " << cumulative << "\n";
+                }
+                duration << "matrix_call_duration_seconds_sum{" << labels << "} " << number(seconds) << "\n";
+                duration << "matrix_call_duration_seconds_count{" << labels << "} " << count << "\n";
+                flops << "matrix_flops_total{" << labels << "} " << number(work) << "\n";
+                // Async calls are timed to submission only, so they have no meaningful rate.
+                if (o != static_cast<int>(MetricOp::Async)) {
+                    gflops << "matrix_gflops{" << labels << "} " << number(seconds > 0.0 ? work / seconds * 1e-9 : 0.0) << "\n";
+                }
+                bytes << "matrix_allocated_bytes_total{" << labels << "} " << op.bytesAllocated.load(std::memory_order_relaxed) << "\n";
+                if (perf.enabled()) {
+                    for (int c = 0; c < HardwareCounterCount; ++c) {
+                        if (perf.available(static_cast<HardwareCounter>(c))) {
+                            hardware << "matrix_hardware_events_total{" << labels << ",event=\"" << CounterNames[c] << "\"} "
+                                     << op.hardware[c].load(std::memory_order_relaxed) << "\n";
+                        }
+                    }
+                }
+            }
+            for (const auto& [shape, count] : metrics->shapes()) {
+                shapes << "matrix_shape_calls_total{backend=\"" << name << "\",m=\"" << shape[0] << "\",n=\"" << shape[1]
+                       << "\",k=\"" << shape[2] << "\"} " << count << "\n";
+            }
+        }
+        return calls.str() + errors.str() + duration.str() + flops.str() + gflops.str() + bytes.str() +
+               (perf.enabled() ? hardware.str() : std::string()) + shapes.str();
+    }
+
+    std::string MetricsRegistry::toJson() const {
+        const PerfCounters& perf = PerfCounters::getInstance();
+        nlohmann::json root;
+        root["backends"] = nlohmann::json::object();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, metrics] : backends_) {
+            nlohmann::json entry;
+            entry["ops"] = nlohmann::json::object();
+            for (int o = 0; o < MetricOpCount; ++o) {
+                const BackendMetrics::OpCounters& op = metrics->op(static_cast<MetricOp>(o));
+                const std::uint64_t count = op.calls.load(std::memory_order_relaxed);
+                const std::uint64_t failed = op.errors.load(std::memory_order_relaxed);
+                if (count == 0 && failed == 0) {
+                    continue;
+                }
+                const double seconds = op.nanos.load(std::memory_order_relaxed) * 1e-9;
+                const double work = static_cast<double>(op.flops.load(std::memory_order_relaxed));
+                nlohmann::json stats;
+                stats["calls"] = count;
+                stats["errors"] = failed;
+                stats["seconds"] = seconds;
+                stats["flops"] = work;
+                if (o != static_cast<int>(MetricOp::Async)) {
+                    stats["gflops"] = seconds > 0.0 ? work / seconds * 1e-9 : 0.0;
+                }
+                stats["allocated_bytes"] = op.bytesAllocated.load(std::memory_order_relaxed);
+
+                nlohmann::json latency;
+                nlohmann::json buckets = nlohmann::json::array();
+                for (int bucket = 0; bucket < BackendMetrics::LatencyBuckets; ++bucket) {
+                    buckets.push_back(op.latency[bucket].load(std::memory_order_relaxed));
+                }
+                latency["bucket_upper_ns"] = "2^(i + 10), last unbounded";
+                latency["buckets"] = buckets;
+                if (count != 0) {
+                    latency["p50_ns"] = latencyQuantile(op, count, 0.50);
+                    latency["p90_ns"] = latencyQuantile(op, count, 0.90);
+                    latency["p99_ns"] = latencyQuantile(op, count, 0.99);
+                }
+                stats["latency"] = latency;
+
+                if (perf.enabled()) {
+                    nlohmann::json hardware;
+                    for (int c = 0; c < HardwareCounterCount; ++c) {
+                        if (perf.available(static_cast<HardwareCounter>(c))) {
+                            hardware[CounterNames[c]] = op.hardware[c].load(std::memory_order_relaxed);
+                        }
+                    }
+                    stats["hardware"] = hardware;
+                }
+                entry["ops"][OpNames[o]] = stats;
+            }
+
+            nlohmann::json shapes = nlohmann::json::array();
+            for (const auto& [shape, count] : metrics->shapes()) {
+                shapes.push_back({{"m", shape[0]}, {"n", shape[1]}, {"k", shape[2]}, {"calls", count}});
+            }
+            entry["shapes"] = shapes;
+            root["backends"][name] = entry;
+        }
+        return root.dump(2);
+    }
+
+    void MetricsRegistry::writeFile(const std::string& path) const {
+        const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+        const std::string text = json ? toJson() : toPrometheus();
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Could not write metrics to " + path);
+        }
+        out << text;
+        if (json) {
+            out << "\n";
+        }
+    }
+
+    void MetricsRegistry::reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : backends_) {
+            entry.second->reset();
+        }
+    }
+
+} // namespace MatrixTransform
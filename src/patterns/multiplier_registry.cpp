@@ -1,25 +1,137 @@
 #include "multiplier_registry.hpp"
+#include "backend_plugin.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef WITH_BACKEND_PLUGINS
+#include <filesystem>
+#include <system_error>
+#include <dlfcn.h>
+#endif
 
 namespace MatrixTransform {
 
+#ifdef WITH_BACKEND_PLUGINS
+    namespace {
+        // Plugins are built next to libmatrix_core; find the library this code was loaded from.
+        std::string defaultPluginDirectory() {
+            Dl_info info{};
+            if (dladdr(reinterpret_cast<void*>(&defaultPluginDirectory), &info) != 0 && info.dli_fname != nullptr) {
+                return std::filesystem::path(info.dli_fname).parent_path().string();
+            }
+            return ".";
+        }
+
+        std::function<std::unique_ptr<IMultiplier>()> loadPlugin(const std::string& key, const std::string& path) {
+            void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (handle == nullptr) {
+                throw std::runtime_error("MultiplierRegistry: Could not load plugin " + path + ": " + dlerror());
+            }
+            auto entry = reinterpret_cast<MatrixTransformBackendEntry>(dlsym(handle, MATRIX_TRANSFORM_BACKEND_ENTRY));
+            const MatrixTransformBackend* backend = entry != nullptr ? entry() : nullptr;
+            if (backend == nullptr || backend->abiVersion != MATRIX_TRANSFORM_BACKEND_ABI_VERSION ||
+                backend->key == nullptr || key != backend->key || backend->create == nullptr) {
+                dlclose(handle);
+                throw std::runtime_error("MultiplierRegistry: Plugin " + path + " does not provide backend " + key +
+                                         " with ABI version " + std::to_string(MATRIX_TRANSFORM_BACKEND_ABI_VERSION));
+            }
+            Logger::getInstance().log(LogLevel::Debug, "Loaded backend plugin {} from {}.", key, path);
+
+            void* (*create)() = backend->create;
+            return [create, key]() -> std::unique_ptr<IMultiplier> {
+                auto* multiplier = static_cast<IMultiplier*>(create());
+                if (multiplier == nullptr) {
+                    throw std::runtime_error("MultiplierRegistry: Backend " + key + " failed to initialize.");
+                }
+                return std::unique_ptr<IMultiplier>(multiplier);
+            };
+        }
+    }
+#endif
+
+    MultiplierRegistry::MultiplierRegistry() {
+#ifdef WITH_BACKEND_PLUGINS
+        discoverPlugins(defaultPluginDirectory());
+#endif
+    }
+
     MultiplierRegistry& MultiplierRegistry::getInstance(){
         static MultiplierRegistry instance;
         return instance;
     }
-    
+
     std::unique_ptr<IMultiplier> MultiplierRegistry::createMultiplier(const std::string& key){
-        auto it = creatorMap_.find(key);
-        if (it != creatorMap_.end()) {
-            return it->second(); 
+        std::function<std::unique_ptr<IMultiplier>()> creator;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            auto it = creatorMap_.find(key);
+#ifdef WITH_BACKEND_PLUGINS
+            if (it == creatorMap_.end()) {
+                auto plugin = pluginPaths_.find(key);
+                if (plugin != pluginPaths_.end()) {
+                    it = creatorMap_.try_emplace(key, loadPlugin(key, plugin->second)).first;
+                }
+            }
+#endif
+            if (it == creatorMap_.end()) {
+                throw std::runtime_error("MultiplierRegistry: Unknown multiplier type requested: " + key);
+            }
+            creator = it->second;
         }
-        throw std::runtime_error("MultiplierRegistry: Unknown multiplier type requested: " + key);
+        // Outside the lock: meta-backends create the backends they dispatch to.
+        return creator();
     }
 
     bool MultiplierRegistry::registerMultiplier(const std::string& key, std::function<std::unique_ptr<IMultiplier>()> creator){
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         auto [iterator, inserted] = creatorMap_.try_emplace(key, std::move(creator));
-        if (!inserted) { 
+        if (!inserted) {
             iterator->second = std::move(creator);
         }
         return true;
-    } 
-}
\ No newline at end of file
+    }
+
+    std::vector<std::string> MultiplierRegistry::registeredKeys() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        std::vector<std::string> keys;
+        keys.reserve(creatorMap_.size() + pluginPaths_.size());
+        for (const auto& entry : creatorMap_) {
+            keys.push_back(entry.first);
+        }
+        for (const auto& entry : pluginPaths_) {
+            if (creatorMap_.count(entry.first) == 0) {
+                keys.push_back(entry.first);
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    void MultiplierRegistry::setPluginDirectory(const std::string& directory) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        pluginPaths_.clear();
+        discoverPlugins(directory);
+    }
+
+    void MultiplierRegistry::discoverPlugins(const std::string& directory) {
+#ifdef WITH_BACKEND_PLUGINS
+        // Only file names are read here: <prefix>matrix_backend_<KEY><suffix>.
+        const std::string prefix = BACKEND_PLUGIN_PREFIX;
+        const std::string suffix = BACKEND_PLUGIN_SUFFIX;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() > prefix.size() + suffix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+                name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                pluginPaths_[name.substr(prefix.size(), name.size() - prefix.size() - suffix.size())] = entry.path().string();
+            }
+        }
+        if (error) {
+            Logger::getInstance().log(LogLevel::Warning, "Could not read plugin directory {}: {}", directory, error.message());
+        }
+#else
+        Logger::getInstance().log(LogLevel::Warning, "Backends are linked into matrix_core; ignoring plugin directory {}.", directory);
+#endif
+    }
+}
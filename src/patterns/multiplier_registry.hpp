@@ -1,8 +1,17 @@
+#pragma once
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "matrix_transform/interfaces.hpp"
 
 namespace MatrixTransform {
+    // Creates backends by key. Backends linked into matrix_core register through static
+    // MultiplierRegistrar objects. Backends built as plugins (see backend_plugin.hpp) are found
+    // by file name in the plugin directory, which defaults to the one holding libmatrix_core,
+    // and a plugin is only loaded on the first createMultiplier() for its key.
     class MultiplierRegistry {
         public:
             MultiplierRegistry(const MultiplierRegistry&) = delete;
@@ -11,12 +20,21 @@ namespace MatrixTransform {
             static MultiplierRegistry& getInstance();
             std::unique_ptr<IMultiplier> createMultiplier(const std::string& key);
             bool registerMultiplier(const std::string& key, std::function<std::unique_ptr<IMultiplier>()> creator);
+            std::vector<std::string> registeredKeys() const;
+
+            // Replaces the plugins found so far with those in directory. Plugins that are
+            // already loaded stay registered.
+            void setPluginDirectory(const std::string& directory);
 
         private:
-            MultiplierRegistry() = default;
+            MultiplierRegistry();
             ~MultiplierRegistry() = default;
 
+            void discoverPlugins(const std::string& directory);
+
+            mutable std::recursive_mutex mutex_;
             std::map<std::string, std::function<std::unique_ptr<IMultiplier>()>> creatorMap_;
+            std::map<std::string, std::string> pluginPaths_;
     };
 
     class MultiplierRegistrar {
@@ -0,0 +1,93 @@
+#include <fstream>
+#include "tuning_cache.hpp"
+#include "cpu_features.hpp"
+#include "logger.hpp"
+#include "parallel_runtime.hpp"
+
+namespace MatrixTransform {
+
+    TuningCache& TuningCache::getInstance() {
+        static TuningCache instance;
+        return instance;
+    }
+
+    std::string TuningCache::bucketKey(Eigen::Index m, Eigen::Index n, Eigen::Index k) {
+        auto roundUpPow2 = [](Eigen::Index value) {
+            Eigen::Index bucket = 1;
+            while (bucket < value) {
+                bucket *= 2;
+            }
+            return bucket;
+        };
+        return "m" + std::to_string(roundUpPow2(m)) + "_n" + std::to_string(roundUpPow2(n)) +
+               "_k" + std::to_string(roundUpPow2(k));
+    }
+
+    std::string TuningCache::hostSignature() {
+        const int threads = ParallelRuntime::getInstance().maxThreads();
+        return CpuFeatures::get().toString() + " threads=" + std::to_string(threads);
+    }
+
+    void TuningCache::load(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        path_ = path;
+        entries_.clear();
+
+        std::ifstream cacheStream(path);
+        if (!cacheStream.is_open()) {
+            Logger::getInstance().log(LogLevel::Debug, "No tuning cache at {}, starting empty.", path);
+            return;
+        }
+
+        try {
+            nlohmann::json cacheJson;
+            cacheStream >> cacheJson;
+            if (cacheJson.value("host", "") != hostSignature()) {
+                Logger::getInstance().log(LogLevel::Warning, "Tuning cache {} was written on a different host configuration; ignoring it.", path);
+                return;
+            }
+            for (const auto& [bucket, entry] : cacheJson.at("entries").items()) {
+                entries_[bucket] = entry;
+            }
+            Logger::getInstance().log(LogLevel::Info, "Loaded {} tuning entries from {}", entries_.size(), path);
+        } catch (const std::exception& e) {
+            Logger::getInstance().log(LogLevel::Warning, "Could not parse tuning cache {}: {}", path, e.what());
+            entries_.clear();
+        }
+    }
+
+    void TuningCache::save() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (path_.empty()) {
+            return;
+        }
+        nlohmann::json cacheJson;
+        cacheJson["host"] = hostSignature();
+        cacheJson["entries"] = nlohmann::json::object();
+        for (const auto& [bucket, entry] : entries_) {
+            cacheJson["entries"][bucket] = entry;
+        }
+
+        std::ofstream cacheStream(path_);
+        if (!cacheStream.is_open()) {
+            Logger::getInstance().log(LogLevel::Warning, "Could not write tuning cache {}", path_);
+            return;
+        }
+        cacheStream << cacheJson.dump(2) << std::endl;
+    }
+
+    std::optional<nlohmann::json> TuningCache::lookup(const std::string& bucket) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(bucket);
+        if (it == entries_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void TuningCache::store(const std::string& bucket, const nlohmann::json& entry) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[bucket] = entry;
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,42 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "nlohmann/json.hpp"
+#include "matrix_transform/matrix_types.hpp"
+
+namespace MatrixTransform {
+
+    // Process-wide store of autotuning winners, keyed by shape bucket and persisted as JSON.
+    // Entries are only trusted on the host they were measured on: a cache written with other
+    // CPU features or another thread count is ignored on load. Until load names a file the
+    // cache lives in memory only and save does nothing.
+    class TuningCache {
+        public:
+            TuningCache(const TuningCache&) = delete;
+            TuningCache& operator=(const TuningCache&) = delete;
+
+            static TuningCache& getInstance();
+
+            // Rounds each dimension up to a power of two, e.g. 1000x1000x1000 -> "m1024_n1024_k1024".
+            static std::string bucketKey(Eigen::Index m, Eigen::Index n, Eigen::Index k);
+
+            void load(const std::string& path);
+            void save() const;
+
+            std::optional<nlohmann::json> lookup(const std::string& bucket) const;
+            void store(const std::string& bucket, const nlohmann::json& entry);
+
+        private:
+            TuningCache() = default;
+            ~TuningCache() = default;
+
+            static std::string hostSignature();
+
+            mutable std::mutex mutex_;
+            std::string path_;
+            std::map<std::string, nlohmann::json> entries_;
+    };
+
+} // namespace MatrixTransform
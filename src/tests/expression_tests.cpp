@@ -0,0 +1,164 @@
+// The expression evaluator on the CPU backend: the chain order it picks, seen through the
+// GEMM shapes it issues, and whole expressions with scales, differences and sums inside
+// chains checked against a left-to-right Eigen product in double precision. Exits non-zero
+// if any check fails.
+
+#include "matrix_transform/expression.hpp"
+#include "multiplier_registry.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace MatrixTransform;
+
+namespace {
+
+    using Reference = Eigen::MatrixXd;
+    using Shape = std::array<Eigen::Index, 3>;
+
+    constexpr double Tolerance = 1e-5;
+
+    int failures = 0;
+
+    // Forwards to a real backend and records m, k, n of every gemm the evaluator issues.
+    class RecordingMultiplier : public IMultiplier {
+    public:
+        explicit RecordingMultiplier(IMultiplier& inner) : inner_(inner) {}
+
+        using IMultiplier::multiply;
+        using IMultiplier::gemm;
+
+        Matrix multiply(const Matrix& a, const Matrix& b) override {
+            shapes.push_back({a.rows(), a.cols(), b.cols()});
+            return inner_.multiply(a, b);
+        }
+
+        void gemm(float alpha, const Matrix& a, const Matrix& b, float beta, Matrix& c) override {
+            shapes.push_back({a.rows(), a.cols(), b.cols()});
+            inner_.gemm(alpha, a, b, beta, c);
+        }
+
+        std::vector<Shape> shapes;
+
+    private:
+        IMultiplier& inner_;
+    };
+
+    void expect(bool condition, const std::string& what) {
+        if (!condition) {
+            std::cerr << "FAIL " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    void check(const std::string& what, const Matrix& result, const Reference& expected) {
+        if (result.rows() != expected.rows() || result.cols() != expected.cols()) {
+            std::cerr << "FAIL " << what << ": result is " << result.rows() << "x" << result.cols() << ", expected "
+                      << expected.rows() << "x" << expected.cols() << std::endl;
+            ++failures;
+            return;
+        }
+        const double error = (result.cast<double>() - expected).cwiseAbs().maxCoeff();
+        const double bound = Tolerance * std::max(1.0, expected.cwiseAbs().maxCoeff());
+        if (!(error <= bound)) {
+            std::cerr << "FAIL " << what << ": max error " << error << " > " << bound << std::endl;
+            ++failures;
+        }
+    }
+
+    // The textbook six-matrix chain 30x35x15x5x10x20x25, whose optimum is
+    // ((A0 (A1 A2)) ((A3 A4) A5)) at 15125 multiply-adds.
+    void testChainOrder(IMultiplier& backend) {
+        const std::vector<Eigen::Index> dims = {30, 35, 15, 5, 10, 20, 25};
+        std::vector<Matrix> factors;
+        for (std::size_t i = 0; i + 1 < dims.size(); ++i) {
+            factors.push_back(Matrix::Random(dims[i], dims[i + 1]));
+        }
+
+        RecordingMultiplier recorder(backend);
+        ExpressionEvaluator evaluator(recorder);
+        Expression chain(factors[0]);
+        for (std::size_t i = 1; i < factors.size(); ++i) {
+            chain = chain * factors[i];
+        }
+        const Matrix result = evaluator.evaluate(chain);
+
+        const std::vector<Shape> expected = {{35, 15, 5}, {30, 35, 5}, {5, 10, 20}, {5, 20, 25}, {30, 5, 25}};
+        expect(recorder.shapes == expected, "chain order: gemm sequence is not ((A0 (A1 A2)) ((A3 A4) A5))");
+        double cost = 0.0;
+        for (const Shape& shape : recorder.shapes) {
+            cost += static_cast<double>(shape[0]) * shape[1] * shape[2];
+        }
+        expect(cost == 15125.0, "chain order: " + std::to_string(cost) + " multiply-adds instead of 15125");
+
+        Reference reference = factors[0].cast<double>();
+        for (std::size_t i = 1; i < factors.size(); ++i) {
+            reference = reference * factors[i].cast<double>();
+        }
+        check("chain order: result", result, reference);
+    }
+
+    // 2 * (A B C v) - w + A (B + B) v: a scaled chain, a difference, and a sum materialized
+    // inside a chain. Both chains should run right to left, as matrix-vector products.
+    void testExpression(IMultiplier& backend) {
+        const Eigen::Index n = 120;
+        const Matrix a = Matrix::Random(n, n);
+        const Matrix b = Matrix::Random(n, n);
+        const Matrix c = Matrix::Random(n, n);
+        const Matrix v = Matrix::Random(n, 1);
+        const Matrix w = Matrix::Random(n, 1);
+
+        const Reference ad = a.cast<double>(), bd = b.cast<double>(), cd = c.cast<double>();
+        const Reference vd = v.cast<double>(), wd = w.cast<double>();
+        const Reference abc = Reference(ad * bd) * cd;
+        const Reference expected = 2.0 * Reference(abc * vd) - wd + Reference(ad * (bd + bd)) * vd;
+
+        RecordingMultiplier recorder(backend);
+        ExpressionEvaluator evaluator(recorder);
+        const Expression expression = 2.0f * (Expression(a) * b * c * v) - w + Expression(a) * (Expression(b) + b) * v;
+        expect(expression.rows() == n && expression.cols() == 1, "expression: recorded shape is not 120x1");
+
+        const Matrix first = evaluator.evaluate(expression);
+        check("expression", first, expected);
+        for (const Shape& shape : recorder.shapes) {
+            expect(shape[2] == 1, "expression: a chain ran a matrix-matrix product");
+        }
+
+        // Later evaluations take every intermediate from the pool instead of growing it.
+        const std::size_t pooled = evaluator.pooledBuffers();
+        expect(pooled > 0, "expression: no intermediates were returned to the pool");
+        Matrix out;
+        for (int run = 0; run < 3; ++run) {
+            evaluator.evaluate(expression, out);
+        }
+        expect(evaluator.pooledBuffers() == pooled,
+               "expression: pool grew from " + std::to_string(pooled) + " to " + std::to_string(evaluator.pooledBuffers()));
+        check("expression reevaluated", out, expected);
+    }
+
+} // namespace
+
+int main() {
+    Logger::getInstance().setLevel(LogLevel::Error);
+
+    std::unique_ptr<IMultiplier> backend;
+    try {
+        backend = MultiplierRegistry::getInstance().createMultiplier("CPU");
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL CPU backend: " << e.what() << std::endl;
+        return 1;
+    }
+
+    try {
+        testChainOrder(*backend);
+        testExpression(*backend);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL threw " << e.what() << std::endl;
+        ++failures;
+    }
+    std::cout << "expression: " << (failures == 0 ? "ok" : std::to_string(failures) + " failures") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+// Tiled matrix files and the out-of-core driver on the CPU backend: write/open/toMatrix round
+// trips on shapes that end in partial edge tiles, tile sizes that would break page alignment,
+// and OutOfCoreMultiplier under a budget small enough to split C into several blocks, checked
+// against Eigen in double precision. Exits non-zero if any check fails.
+
+#include "matrix_transform/out_of_core.hpp"
+#include "multiplier_registry.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace MatrixTransform;
+
+namespace {
+
+    // 64 x 64 floats is 16 KiB, a whole number of pages on 4 KiB and 16 KiB page hosts.
+    constexpr Eigen::Index TileSize = 64;
+    constexpr double Tolerance = 1e-5;
+
+    // Offset of the tile size in the file header, after the magic and the format version.
+    constexpr std::streamoff TileSizeOffset = 12;
+
+    int failures = 0;
+
+    void expect(bool condition, const std::string& what) {
+        if (!condition) {
+            std::cerr << "FAIL " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    std::string label(Eigen::Index rows, Eigen::Index cols) {
+        return std::to_string(rows) + "x" + std::to_string(cols);
+    }
+
+    template <typename Action>
+    bool throws(Action&& action) {
+        try {
+            action();
+        } catch (const std::exception&) {
+            return true;
+        }
+        return false;
+    }
+
+    // Removes the files a test wrote, also when it fails part way.
+    struct ScratchFiles {
+        ScratchFiles() : directory(std::filesystem::temp_directory_path()) {}
+        ~ScratchFiles() {
+            for (const std::string& path : paths) {
+                std::error_code ignored;
+                std::filesystem::remove(path, ignored);
+            }
+        }
+
+        std::string path(const std::string& name) {
+            paths.push_back((directory / ("matrix_out_of_core_tests_" + name + ".tiled")).string());
+            return paths.back();
+        }
+
+        std::filesystem::path directory;
+        std::vector<std::string> paths;
+    };
+
+    void testRoundTrip(ScratchFiles& files) {
+        const Eigen::Index shapes[][2] = {{150, 77}, {64, 128}, {5, 3}, {1, 200}};
+        for (const auto& shape : shapes) {
+            const std::string what = "round trip " + label(shape[0], shape[1]);
+            const Matrix matrix = Matrix::Random(shape[0], shape[1]);
+            const std::string path = files.path(label(shape[0], shape[1]));
+            TiledMatrixFile::write(path, matrix, TileSize);
+
+            const TiledMatrixFile file = TiledMatrixFile::open(path);
+            expect(file.rows() == shape[0] && file.cols() == shape[1] && file.tileSize() == TileSize, what + ": header");
+            expect(file.toMatrix() == matrix, what + ": elements differ");
+
+            // Edge tiles are zero past the matrix.
+            const Eigen::Index ti = file.tileRowCount() - 1, tj = file.tileColCount() - 1;
+            const auto last = Eigen::Map<const Matrix>(file.tile(ti, tj), TileSize, TileSize);
+            const Eigen::Index rows = shape[0] - ti * TileSize, cols = shape[1] - tj * TileSize;
+            expect(last.bottomRows(TileSize - rows).isZero(0.0f) && last.rightCols(TileSize - cols).isZero(0.0f),
+                   what + ": edge tile padding is not zero");
+        }
+    }
+
+    void testTileSizes(ScratchFiles& files) {
+        const Matrix matrix = Matrix::Random(10, 10);
+        expect(throws([&]() { TiledMatrixFile::write(files.path("unaligned_write"), matrix, 48); }),
+               "write accepted a tile size of 48");
+
+        // A header whose tile size does not keep tiles page aligned is rejected by open().
+        const std::string path = files.path("unaligned_open");
+        TiledMatrixFile::write(path, matrix, TileSize);
+        {
+            std::fstream header(path, std::ios::in | std::ios::out | std::ios::binary);
+            const std::uint32_t tileSize = 48;
+            header.seekp(TileSizeOffset);
+            header.write(reinterpret_cast<const char*>(&tileSize), sizeof(tileSize));
+        }
+        expect(throws([&]() { TiledMatrixFile::open(path); }), "open accepted a tile size of 48");
+    }
+
+    void testOutOfCore(IMultiplier& backend, ScratchFiles& files) {
+        // 3 x 2 tiles of A and 2 x 3 of B, all with partial edges; 12 tiles of budget fit
+        // less than the 3 x 3 tiles of C, so C is produced in several blocks.
+        const Eigen::Index m = 150, k = 77, n = 170;
+        const Matrix a = Matrix::Random(m, k);
+        const Matrix b = Matrix::Random(k, n);
+        const Eigen::MatrixXd expected = a.cast<double>() * b.cast<double>();
+
+        const std::string pathA = files.path("a"), pathB = files.path("b"), pathC = files.path("c");
+        TiledMatrixFile::write(pathA, a, TileSize);
+        TiledMatrixFile::write(pathB, b, TileSize);
+        {
+            const TiledMatrixFile fileA = TiledMatrixFile::open(pathA);
+            const TiledMatrixFile fileB = TiledMatrixFile::open(pathB);
+            TiledMatrixFile fileC = TiledMatrixFile::create(pathC, m, n, TileSize);
+            OutOfCoreMultiplier(backend, 12 * TileSize * TileSize * sizeof(float)).multiply(fileA, fileB, fileC);
+        }
+
+        const Matrix c = TiledMatrixFile::open(pathC).toMatrix();
+        const double error = (c.cast<double>() - expected).cwiseAbs().maxCoeff();
+        const double bound = Tolerance * std::max(1.0, expected.cwiseAbs().maxCoeff());
+        if (!(error <= bound)) {
+            std::cerr << "FAIL out-of-core " << label(m, n) << ": max error " << error << " > " << bound << std::endl;
+            ++failures;
+        }
+    }
+
+} // namespace
+
+int main() {
+    Logger::getInstance().setLevel(LogLevel::None);
+
+    std::unique_ptr<IMultiplier> backend;
+    try {
+        backend = MultiplierRegistry::getInstance().createMultiplier("CPU");
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL CPU backend: " << e.what() << std::endl;
+        return 1;
+    }
+
+    ScratchFiles files;
+    try {
+        testRoundTrip(files);
+        testTileSizes(files);
+        testOutOfCore(*backend, files);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL threw " << e.what() << std::endl;
+        ++failures;
+    }
+    std::cout << "out-of-core: " << (failures == 0 ? "ok" : std::to_string(failures) + " failures") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,450 @@
+// Edge cases of the view interface on every in-process fp32 backend, checked against Eigen
+// in double precision: strided, row-major, sub-block and transposed operands, beta == 0 over
+// NaN outputs, the structured products on both triangles, fused epilogues on row-major
+// outputs, packed right-hand operands and the STRASSEN recursion. Exits non-zero if any
+// product is off.
+
+#include "matrix_transform/interfaces.hpp"
+#include "multiplier_registry.hpp"
+#include "configurable.hpp"
+#include "parallel_runtime.hpp"
+#include "logger.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace MatrixTransform;
+
+namespace {
+
+    using Reference = Eigen::MatrixXd;
+
+    enum class Layout { ColMajor, RowMajor, SubBlock, Transposed };
+
+    const Layout Layouts[] = {Layout::ColMajor, Layout::RowMajor, Layout::SubBlock, Layout::Transposed};
+    const char* const LayoutNames[] = {"col-major", "row-major", "sub-block", "transposed"};
+
+    // Outside the view every buffer holds this, so stray writes show up.
+    constexpr float Padding = 7777.0f;
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+
+    std::mt19937 rng(42);
+
+    // A rows x cols operand inside a larger buffer, stored with the given layout and a leading
+    // dimension past its extent.
+    struct Buffer {
+        Buffer(Eigen::Index rows, Eigen::Index cols, Layout layout) {
+            Eigen::Index size = 0;
+            switch (layout) {
+                case Layout::ColMajor:
+                    size = (rows + 3) * cols;
+                    data.assign(size, Padding);
+                    view = MatrixView(data.data(), rows, cols, rows + 3);
+                    break;
+                case Layout::RowMajor:
+                    size = rows * (cols + 5);
+                    data.assign(size, Padding);
+                    view = MatrixView(data.data(), rows, cols, cols + 5, StorageOrder::RowMajor);
+                    break;
+                case Layout::SubBlock:
+                    size = (rows + 4) * (cols + 3);
+                    data.assign(size, Padding);
+                    view = MatrixView(data.data(), rows + 4, cols + 3, rows + 4).block(2, 1, rows, cols);
+                    break;
+                case Layout::Transposed:
+                    size = (cols + 2) * rows;
+                    data.assign(size, Padding);
+                    view = MatrixView(data.data(), cols, rows, cols + 2, StorageOrder::ColMajor, true);
+                    break;
+            }
+        }
+
+        void fill() {
+            std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+            for (Eigen::Index j = 0; j < view.cols(); ++j) {
+                for (Eigen::Index i = 0; i < view.rows(); ++i) {
+                    view(i, j) = value(rng);
+                }
+            }
+        }
+
+        void fill(float value) {
+            for (Eigen::Index j = 0; j < view.cols(); ++j) {
+                for (Eigen::Index i = 0; i < view.rows(); ++i) {
+                    view(i, j) = value;
+                }
+            }
+        }
+
+        Reference values() const { return view.map().cast<double>(); }
+
+        bool paddingIntact() const {
+            std::set<const float*> inside;
+            for (Eigen::Index j = 0; j < view.cols(); ++j) {
+                for (Eigen::Index i = 0; i < view.rows(); ++i) {
+                    inside.insert(&view(i, j));
+                }
+            }
+            for (const float& value : data) {
+                if (inside.count(&value) == 0 && value != Padding) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::vector<float> data;
+        MatrixView view{nullptr, 0, 0, 1};
+    };
+
+    // About 100 fp32 ulps of the summed magnitudes, enough for k = 300 in any summation order.
+    constexpr double Tolerance = 1e-5;
+
+    int failures = 0;
+
+    // Passes when every entry of c is within fp32 rounding of expected, where bound holds the
+    // summed magnitudes of the terms behind it. Also fails on NaN and on writes past the view.
+    void check(const std::string& what, const Buffer& c, const Reference& expected, const Reference& bound) {
+        for (Eigen::Index j = 0; j < expected.cols(); ++j) {
+            for (Eigen::Index i = 0; i < expected.rows(); ++i) {
+                const double error = std::abs(static_cast<double>(c.view(i, j)) - expected(i, j));
+                if (!(error <= Tolerance * bound(i, j) + 1e-6)) {
+                    std::cerr << "FAIL " << what << ": c(" << i << ", " << j << ") = " << c.view(i, j)
+                              << ", expected " << expected(i, j) << std::endl;
+                    ++failures;
+                    return;
+                }
+            }
+        }
+        if (!c.paddingIntact()) {
+            std::cerr << "FAIL " << what << ": wrote outside the output view" << std::endl;
+            ++failures;
+        }
+    }
+
+    std::string label(const std::string& backend, const std::string& test, Eigen::Index m, Eigen::Index n, Eigen::Index k) {
+        return backend + " " + test + " " + std::to_string(m) + "x" + std::to_string(n) + "x" + std::to_string(k);
+    }
+
+    void testViews(IMultiplier& multiplier, const std::string& backend) {
+        const Eigen::Index shapes[][3] = {{1, 1, 1}, {17, 5, 33}, {130, 17, 64}, {1, 130, 17}, {130, 1, 300}, {67, 130, 129}};
+        for (const auto& shape : shapes) {
+            const Eigen::Index m = shape[0], n = shape[1], k = shape[2];
+            for (int la = 0; la < 4; ++la) {
+                for (int lb = 0; lb < 4; ++lb) {
+                    for (int lc = 0; lc < 4; ++lc) {
+                        const std::string what = label(backend, std::string("gemm A ") + LayoutNames[la] + " B " +
+                                                       LayoutNames[lb] + " C " + LayoutNames[lc], m, n, k);
+                        Buffer a(m, k, Layouts[la]), b(k, n, Layouts[lb]), c(m, n, Layouts[lc]);
+                        a.fill();
+                        b.fill();
+                        c.fill();
+                        const Reference product = a.values() * b.values();
+                        const Reference magnitude = a.values().cwiseAbs() * b.values().cwiseAbs();
+
+                        const Reference c0 = c.values();
+                        multiplier.gemm(1.5f, a.view, b.view, -0.5f, c.view);
+                        check(what + " beta", c, 1.5 * product - 0.5 * c0, 1.5 * magnitude + 0.5 * c0.cwiseAbs());
+
+                        c.fill(NaN);
+                        multiplier.gemm(2.0f, a.view, b.view, 0.0f, c.view);
+                        check(what + " beta=0 over NaN", c, 2.0 * product, 2.0 * magnitude);
+                    }
+                }
+            }
+        }
+    }
+
+    // Mirrors the given triangle of a square matrix into the other one.
+    Reference symmetric(const Reference& a, Triangle triangle) {
+        if (triangle == Triangle::Lower) {
+            return a.selfadjointView<Eigen::Lower>();
+        }
+        return a.selfadjointView<Eigen::Upper>();
+    }
+
+    bool inTriangle(Eigen::Index i, Eigen::Index j, Triangle triangle) {
+        return triangle == Triangle::Lower ? i >= j : i <= j;
+    }
+
+    void testStructured(IMultiplier& multiplier, const std::string& backend) {
+        int round = 0;
+        for (Eigen::Index n : {1, 17, 130, 300}) {
+            for (Triangle triangle : {Triangle::Lower, Triangle::Upper}) {
+                const char* side = triangle == Triangle::Lower ? " lower" : " upper";
+                const Layout layoutA = Layouts[round % 4];
+                const Layout layoutC = Layouts[(round + 1) % 4];
+                ++round;
+
+                // syrk on a n x 37 A, with and without mirroring the triangle.
+                for (bool mirror : {false, true}) {
+                    const std::string what = label(backend, std::string("syrk") + side + (mirror ? " mirrored" : ""), n, n, 37);
+                    Buffer a(n, 37, layoutA), c(n, n, layoutC);
+                    a.fill();
+                    c.fill();
+                    const Reference c0 = c.values();
+                    const Reference product = a.values() * a.values().transpose();
+                    const Reference magnitude = a.values().cwiseAbs() * a.values().cwiseAbs().transpose();
+                    multiplier.syrk(0.75f, a.view, 0.5f, c.view, triangle, mirror);
+
+                    // The other triangle is either left alone or a copy of the computed one.
+                    Reference expected = 0.75 * product + 0.5 * c0;
+                    Reference bound = 0.75 * magnitude + 0.5 * c0.cwiseAbs();
+                    for (Eigen::Index j = 0; j < n; ++j) {
+                        for (Eigen::Index i = 0; i < n; ++i) {
+                            if (!inTriangle(i, j, triangle)) {
+                                expected(i, j) = mirror ? expected(j, i) : c0(i, j);
+                                bound(i, j) = mirror ? bound(j, i) : 0.0;
+                            }
+                        }
+                    }
+                    check(what, c, expected, bound);
+                }
+
+                // symm and trmm must not read the other triangle of A, which holds NaN.
+                const Eigen::Index cols = 23;
+                Buffer a(n, n, layoutA), b(n, cols, Layouts[(round + 2) % 4]), c(n, cols, layoutC);
+                a.fill();
+                b.fill();
+                const Reference full = a.values();
+                for (Eigen::Index j = 0; j < n; ++j) {
+                    for (Eigen::Index i = 0; i < n; ++i) {
+                        if (!inTriangle(i, j, triangle)) {
+                            a.view(i, j) = NaN;
+                        }
+                    }
+                }
+
+                c.fill();
+                Reference c0 = c.values();
+                const Reference sym = symmetric(full, triangle);
+                multiplier.symm(1.25f, a.view, b.view, 0.5f, c.view, triangle);
+                check(label(backend, std::string("symm") + side, n, cols, n), c,
+                      1.25 * sym * b.values() + 0.5 * c0,
+                      1.25 * sym.cwiseAbs() * b.values().cwiseAbs() + 0.5 * c0.cwiseAbs());
+
+                for (bool unitDiagonal : {false, true}) {
+                    Reference factor = triangle == Triangle::Lower ? Reference(full.triangularView<Eigen::Lower>())
+                                                                   : Reference(full.triangularView<Eigen::Upper>());
+                    if (unitDiagonal) {
+                        factor.diagonal().setOnes();
+                    }
+                    c.fill();
+                    c0 = c.values();
+                    multiplier.trmm(-1.0f, a.view, b.view, 0.5f, c.view, triangle, unitDiagonal);
+                    check(label(backend, std::string("trmm") + side + (unitDiagonal ? " unit" : ""), n, cols, n), c,
+                          -1.0 * factor * b.values() + 0.5 * c0,
+                          factor.cwiseAbs() * b.values().cwiseAbs() + 0.5 * c0.cwiseAbs());
+                }
+            }
+        }
+    }
+
+    double activate(double x, Activation activation) {
+        switch (activation) {
+            case Activation::ReLU:
+                return std::max(0.0, x);
+            case Activation::GELU:
+                return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+            case Activation::None:
+                break;
+        }
+        return x;
+    }
+
+    // c = activation(scale * product + bias) + residual for an epilogue and the unfused product.
+    void checkEpilogue(const std::string& what, const Buffer& c, const Epilogue& epilogue,
+                       const Reference& product, const Reference& magnitude) {
+        Reference expected(product.rows(), product.cols());
+        Reference bound(product.rows(), product.cols());
+        for (Eigen::Index j = 0; j < product.cols(); ++j) {
+            for (Eigen::Index i = 0; i < product.rows(); ++i) {
+                double x = epilogue.scale * product(i, j);
+                double terms = std::abs(epilogue.scale) * magnitude(i, j);
+                if (epilogue.bias != nullptr) {
+                    const float bias = epilogue.bias[epilogue.biasPerRow ? i : j];
+                    x += bias;
+                    terms += std::abs(bias);
+                }
+                expected(i, j) = activate(x, epilogue.activation);
+                // GELU's slope stays below 1.13.
+                bound(i, j) = 1.13 * terms;
+                if (epilogue.residual) {
+                    expected(i, j) += (*epilogue.residual)(i, j);
+                    bound(i, j) += std::abs((*epilogue.residual)(i, j));
+                }
+            }
+        }
+        check(what, c, expected, bound);
+    }
+
+    void testEpilogues(IMultiplier& multiplier, const std::string& backend) {
+        const Eigen::Index shapes[][3] = {{17, 33, 20}, {130, 67, 129}, {1, 130, 17}, {130, 1, 64}};
+        for (const auto& shape : shapes) {
+            const Eigen::Index m = shape[0], n = shape[1], k = shape[2];
+            Buffer a(m, k, Layout::SubBlock), b(k, n, Layout::ColMajor);
+            a.fill();
+            b.fill();
+            const Reference product = a.values() * b.values();
+            const Reference magnitude = a.values().cwiseAbs() * b.values().cwiseAbs();
+            std::vector<float> columnBias(n), rowBias(m);
+            std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+            for (float& bias : columnBias) {
+                bias = value(rng);
+            }
+            for (float& bias : rowBias) {
+                bias = value(rng);
+            }
+            Buffer residual(m, n, Layout::RowMajor);
+            residual.fill();
+
+            for (Activation activation : {Activation::None, Activation::ReLU, Activation::GELU}) {
+                for (int variant = 0; variant < 3; ++variant) {
+                    Epilogue epilogue;
+                    epilogue.scale = 0.5f;
+                    epilogue.activation = activation;
+                    if (variant == 1) {
+                        epilogue.bias = columnBias.data();
+                        epilogue.residual = ConstMatrixView(residual.view);
+                    } else if (variant == 2) {
+                        epilogue.bias = rowBias.data();
+                        epilogue.biasPerRow = true;
+                    }
+                    const std::string what = label(backend, "epilogue activation " + std::to_string(static_cast<int>(activation)) +
+                                                   " variant " + std::to_string(variant), m, n, k);
+                    for (Layout layoutC : {Layout::RowMajor, Layout::Transposed}) {
+                        Buffer c(m, n, layoutC);
+                        c.fill(NaN);
+                        multiplier.gemm(a.view, b.view, c.view, epilogue);
+                        checkEpilogue(what + (layoutC == Layout::RowMajor ? " row-major C" : " transposed C"),
+                                      c, epilogue, product, magnitude);
+                    }
+                }
+            }
+        }
+    }
+
+    void testPacked(IMultiplier& multiplier, const std::string& backend) {
+        const Eigen::Index shapes[][3] = {{1, 1, 1}, {17, 33, 20}, {130, 67, 129}, {1, 130, 300}, {130, 1, 64}};
+        for (const auto& shape : shapes) {
+            const Eigen::Index m = shape[0], n = shape[1], k = shape[2];
+            for (Layout layoutB : {Layout::ColMajor, Layout::Transposed}) {
+                Buffer b(k, n, layoutB);
+                b.fill();
+                const std::shared_ptr<const PackedOperand> packed = multiplier.prepare(b.view);
+                const std::string what = label(backend, std::string("packed B ") + LayoutNames[static_cast<int>(layoutB)], m, n, k);
+
+                for (int la = 0; la < 4; ++la) {
+                    Buffer a(m, k, Layouts[la]), c(m, n, Layouts[(la + 1) % 4]);
+                    a.fill();
+                    c.fill();
+                    const Reference product = a.values() * b.values();
+                    const Reference magnitude = a.values().cwiseAbs() * b.values().cwiseAbs();
+
+                    const Reference c0 = c.values();
+                    multiplier.gemm(-0.5f, a.view, *packed, 0.75f, c.view);
+                    check(what + " A " + LayoutNames[la] + " beta", c, -0.5 * product + 0.75 * c0,
+                          0.5 * magnitude + 0.75 * c0.cwiseAbs());
+
+                    c.fill(NaN);
+                    multiplier.gemm(1.0f, a.view, *packed, 0.0f, c.view);
+                    check(what + " A " + LayoutNames[la] + " beta=0 over NaN", c, product, magnitude);
+                }
+
+                Buffer a(m, k, Layout::RowMajor), c(m, n, Layout::RowMajor);
+                a.fill();
+                c.fill(NaN);
+                std::vector<float> bias(n, 0.25f);
+                Epilogue epilogue;
+                epilogue.scale = 2.0f;
+                epilogue.bias = bias.data();
+                epilogue.activation = Activation::ReLU;
+                multiplier.gemm(a.view, *packed, c.view, epilogue);
+                checkEpilogue(what + " epilogue row-major C", c, epilogue, a.values() * b.values(),
+                              a.values().cwiseAbs() * b.values().cwiseAbs());
+            }
+        }
+    }
+
+    // The default cutoff keeps every shape above on the classical path. A cutoff of 16 runs the
+    // Winograd recursion several levels deep on odd shapes, which are zero padded to 2^depth,
+    // and a team of four threads runs the top two levels as tasks. Strassen's error grows with
+    // the norms of A and B rather than per entry, so the bound is the largest magnitude.
+    void testStrassen(IMultiplier& multiplier, const std::string& backend) {
+        dynamic_cast<IConfigurable&>(multiplier).configure({{"cutoff", 16}, {"task_depth", 2}});
+        ParallelRuntime::getInstance().setThreads(4);
+        const Eigen::Index shapes[][3] = {{300, 300, 300}, {257, 130, 199}, {1000, 33, 520}, {67, 129, 45}};
+        for (const auto& shape : shapes) {
+            const Eigen::Index m = shape[0], n = shape[1], k = shape[2];
+            for (int la = 0; la < 4; la += 3) {
+                const std::string what = label(backend, std::string("recursion A ") + LayoutNames[la], m, n, k);
+                Buffer a(m, k, Layouts[la]), b(k, n, Layout::SubBlock), c(m, n, Layout::RowMajor);
+                a.fill();
+                b.fill();
+                c.fill();
+                const Reference product = a.values() * b.values();
+                const double magnitude = (a.values().cwiseAbs() * b.values().cwiseAbs()).maxCoeff();
+
+                const Reference c0 = c.values();
+                multiplier.gemm(0.5f, a.view, b.view, -1.5f, c.view);
+                check(what + " beta", c, 0.5 * product - 1.5 * c0,
+                      Reference::Constant(m, n, 0.5 * magnitude + 1.5 * c0.cwiseAbs().maxCoeff()));
+
+                c.fill(NaN);
+                multiplier.gemm(1.0f, a.view, b.view, 0.0f, c.view);
+                check(what + " beta=0 over NaN", c, product, Reference::Constant(m, n, magnitude));
+            }
+        }
+    }
+
+} // namespace
+
+int main() {
+    Logger::getInstance().setLevel(LogLevel::Error);
+
+    // BEST tunes across the others and SHARDED needs worker processes; both forward to backends
+    // tested here. GPU backends are skipped to keep the test host-only.
+    const std::set<std::string> skipped = {"BEST", "SHARDED", "CUDA", "cuBLAS"};
+    int tested = 0;
+    for (const std::string& backend : MultiplierRegistry::getInstance().registeredKeys()) {
+        if (skipped.count(backend) != 0) {
+            continue;
+        }
+        std::unique_ptr<IMultiplier> multiplier;
+        try {
+            multiplier = MultiplierRegistry::getInstance().createMultiplier(backend);
+        } catch (const std::exception& e) {
+            std::cout << "skip " << backend << ": " << e.what() << std::endl;
+            continue;
+        }
+        if (multiplier->precision() != Precision::Float32) {
+            continue;
+        }
+
+        const int before = failures;
+        try {
+            testViews(*multiplier, backend);
+            testStructured(*multiplier, backend);
+            testEpilogues(*multiplier, backend);
+            testPacked(*multiplier, backend);
+            if (backend == "STRASSEN") {
+                testStrassen(*multiplier, backend);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "FAIL " << backend << ": threw " << e.what() << std::endl;
+            ++failures;
+        }
+        std::cout << backend << ": " << (failures == before ? "ok" : std::to_string(failures - before) + " failures") << std::endl;
+        ++tested;
+    }
+
+    if (tested == 0) {
+        std::cerr << "FAIL no fp32 backend could be created" << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace MatrixTransform {
+
+    // Bytes allocated by AlignedBuffer on the current thread; instrumented backends sample it.
+    inline thread_local std::uint64_t alignedBytesAllocated = 0;
+
+    // Grow-only, 64-byte aligned scratch storage for packed GEMM panels.
+    template <typename T>
+    class AlignedBuffer {
+    public:
+        static constexpr std::size_t Alignment = 64;
+
+        AlignedBuffer() = default;
+        explicit AlignedBuffer(std::size_t count) { reserve(count); }
+        ~AlignedBuffer() { std::free(data_); }
+
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+        AlignedBuffer(AlignedBuffer&& other) noexcept : data_(other.data_), capacity_(other.capacity_) {
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+            if (this != &other) {
+                std::free(data_);
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = nullptr;
+                other.capacity_ = 0;
+            }
+            return *this;
+        }
+
+        void reserve(std::size_t count) {
+            if (count <= capacity_) {
+                return;
+            }
+            std::size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+            void* memory = std::aligned_alloc(Alignment, bytes);
+            if (memory == nullptr) {
+                throw std::bad_alloc();
+            }
+            alignedBytesAllocated += bytes;
+            std::free(data_);
+            data_ = static_cast<T*>(memory);
+            capacity_ = bytes / sizeof(T);
+        }
+
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+        std::size_t capacity() const { return capacity_; }
+
+    private:
+        T* data_ = nullptr;
+        std::size_t capacity_ = 0;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,36 @@
+#include "cpu_features.hpp"
+
+namespace MatrixTransform {
+
+    namespace {
+        CpuFeatures probe() {
+            CpuFeatures features;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            // libgcc checks both the cpuid bits and the OS-enabled XSAVE state.
+            __builtin_cpu_init();
+            features.avx2 = __builtin_cpu_supports("avx2");
+            features.fma = __builtin_cpu_supports("fma");
+            features.avx512f = __builtin_cpu_supports("avx512f");
+#if defined(__clang__) || __GNUC__ >= 11
+            features.avxvnni = __builtin_cpu_supports("avxvnni");
+#endif
+#endif
+            return features;
+        }
+    }
+
+    const CpuFeatures& CpuFeatures::get() {
+        static const CpuFeatures features = probe();
+        return features;
+    }
+
+    std::string CpuFeatures::toString() const {
+        std::string result = "scalar";
+        if (avx2) result += " avx2";
+        if (fma) result += " fma";
+        if (avx512f) result += " avx512f";
+        if (avxvnni) result += " avxvnni";
+        return result;
+    }
+
+} // namespace MatrixTransform
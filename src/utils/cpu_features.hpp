@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace MatrixTransform {
+
+    // Instruction set extensions of the running CPU, probed once via cpuid.
+    struct CpuFeatures {
+        bool avx2 = false;
+        bool fma = false;
+        bool avx512f = false;
+        bool avxvnni = false;
+
+        static const CpuFeatures& get();
+        std::string toString() const;
+    };
+
+} // namespace MatrixTransform
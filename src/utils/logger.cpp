@@ -1,50 +1,232 @@
 #include "logger.hpp"
-#include <chrono> 
-#include <sstream>  
-#include <iomanip>  
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
 
 namespace MatrixTransform {
 
+namespace {
+    // Writes that are not urgent are picked up on this period rather than waking the writer.
+    constexpr std::chrono::milliseconds WriterPeriod(10);
+}
+
+Logger::Logger() : current_level_(LogLevel::Info) {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    running_.store(false, std::memory_order_release);
+    // Anything logged while the writer was stopping, and afterwards, is written in place.
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+}
+
 void Logger::setLevel(const std::string& levelStr) {
     if (levelStr == "debug") {
-        current_level_ = LogLevel::Debug;
+        setLevel(LogLevel::Debug);
     } else if (levelStr == "info") {
-        current_level_ = LogLevel::Info;
+        setLevel(LogLevel::Info);
     } else if (levelStr == "warning") {
-        current_level_ = LogLevel::Warning;
+        setLevel(LogLevel::Warning);
     } else if (levelStr == "error") {
-        current_level_ = LogLevel::Error;
+        setLevel(LogLevel::Error);
     } else if (levelStr == "none") {
-        current_level_ = LogLevel::None;
+        setLevel(LogLevel::None);
     } else {
-        log(LogLevel::Warning, "Unknown log level '" + levelStr + "' in config. Using default.");
+        log(LogLevel::Warning, "Unknown log level '{}' in config. Using default.", levelStr);
     }
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
-    if (level >= current_level_) {
-        const auto now = std::chrono::system_clock::now();
-        const auto now_time_t = std::chrono::system_clock::to_time_t(now);
+void Logger::flush() {
+    const std::uint64_t target = head_.load(std::memory_order_acquire);
+    while (written_.load(std::memory_order_acquire) < target && running_.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeRequested_ = true;
+        }
+        wake_.notify_one();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
 
-        std::stringstream time_stream;
-        time_stream << std::put_time(std::localtime(&now_time_t), "%Y-%m-%d %H:%M:%S");
-        const std::string time_str = time_stream.str();
+// Bounded MPMC queue claim (Vyukov): a slot is free for position p when its sequence is p.
+Logger::Record* Logger::claim(std::uint64_t& position) {
+    position = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Record& record = ring_[position % Capacity];
+        const std::uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        const std::int64_t lag = static_cast<std::int64_t>(sequence - position);
+        if (lag == 0) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return &record;
+            }
+        } else if (lag < 0) {
+            return nullptr;
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publish(Record& record, std::uint64_t position, LogLevel level) {
+    record.sequence.store(position + 1, std::memory_order_release);
 
-        std::string level_str;
-        switch (level) {
-            case LogLevel::Debug:   level_str = "[DEBUG]";   break;
-            case LogLevel::Info:    level_str = "[INFO]";    break;
-            case LogLevel::Warning: level_str = "[WARNING]"; break;
-            case LogLevel::Error:   level_str = "[ERROR]";   break;
-            case LogLevel::None:    return; 
+    if (!running_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drain();
+        return;
+    }
+    // Warnings and errors are written promptly; everything else waits for the next period
+    // unless the ring is filling up.
+    if (level >= LogLevel::Warning || position - written_.load(std::memory_order_relaxed) > Capacity / 2) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeRequested_ = true;
         }
+        wake_.notify_one();
+    }
+}
 
-        if (level >= LogLevel::Warning) {
-            std::cerr << time_str << " " << level_str << " " << message << std::endl;
-        } else {
-            std::cout << time_str << " " << level_str << " " << message << std::endl;
+std::int64_t Logger::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void Logger::format(const Record& record, std::string& out) {
+    const std::time_t seconds = static_cast<std::time_t>(record.timestamp / 1000000000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char time_str[32];
+    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &local);
+    out += time_str;
+
+    switch (record.level) {
+        case LogLevel::Debug:   out += " [DEBUG] ";   break;
+        case LogLevel::Info:    out += " [INFO] ";    break;
+        case LogLevel::Warning: out += " [WARNING] "; break;
+        case LogLevel::Error:   out += " [ERROR] ";   break;
+        case LogLevel::None:    break;
+    }
+
+    std::size_t cursor = 0;
+    for (const char* f = record.format; *f != '\0'; ++f) {
+        if (f[0] != '{' || f[1] != '}' || cursor >= record.size) {
+            out += *f;
+            continue;
+        }
+        ++f;
+        const char tag = record.payload[cursor++];
+        const char* value = record.payload + cursor;
+        switch (tag) {
+            case Signed: {
+                std::int64_t v;
+                std::memcpy(&v, value, sizeof(v));
+                out += std::to_string(v);
+                cursor += sizeof(v);
+                break;
+            }
+            case Unsigned: {
+                std::uint64_t v;
+                std::memcpy(&v, value, sizeof(v));
+                out += std::to_string(v);
+                cursor += sizeof(v);
+                break;
+            }
+            case Double: {
+                double v;
+                std::memcpy(&v, value, sizeof(v));
+                char text[32];
+                std::snprintf(text, sizeof(text), "%g", v);
+                out += text;
+                cursor += sizeof(v);
+                break;
+            }
+            case Bool: {
+                bool v;
+                std::memcpy(&v, value, sizeof(v));
+                out += v ? "true" : "false";
+                cursor += sizeof(v);
+                break;
+            }
+            case String: {
+                std::uint16_t length;
+                std::memcpy(&length, value, sizeof(length));
+                out.append(value + sizeof(length), length);
+                cursor += sizeof(length) + length;
+                break;
+            }
+            case HeapString: {
+                const std::string* v;
+                std::memcpy(&v, value, sizeof(v));
+                out += *v;
+                delete v;
+                cursor += sizeof(v);
+                break;
+            }
+        }
+    }
+    out += '\n';
+}
+
+void Logger::run() {
+    for (;;) {
+        const bool wrote = drain();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopRequested_ && !wrote) {
+            break;
+        }
+        if (!wrote) {
+            wake_.wait_for(lock, WriterPeriod, [this]() { return wakeRequested_ || stopRequested_; });
         }
+        wakeRequested_ = false;
+    }
+}
+
+// Formats every published record in order and writes each stream once. Only one thread
+// drains at a time: the writer, or callers holding mutex_ once it has stopped.
+bool Logger::drain() {
+    std::string out;
+    std::string err;
+    std::uint64_t position = tail_;
+    for (;;) {
+        Record& record = ring_[position % Capacity];
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;
+        }
+        format(record, record.level >= LogLevel::Warning ? err : out);
+        record.sequence.store(position + Capacity, std::memory_order_release);
+        ++position;
+    }
+
+    const std::uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped != 0) {
+        err += "[WARNING] Logger dropped " + std::to_string(dropped) + " messages (ring full).\n";
+    }
+    if (position == tail_ && dropped == 0) {
+        return false;
+    }
+
+    if (!out.empty()) {
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cout.flush();
+    }
+    if (!err.empty()) {
+        std::cerr.write(err.data(), static_cast<std::streamsize>(err.size()));
+        std::cerr.flush();
     }
+    tail_ = position;
+    written_.store(position, std::memory_order_release);
+    return true;
 }
 
-} // namespace MatrixTransform
\ No newline at end of file
+} // namespace MatrixTransform
@@ -1,7 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <string>
-#include <iostream>
+#include <thread>
+#include <type_traits>
+
+// Messages below this level are compiled out of every log call (0 = Debug ... 4 = None).
+#ifndef MATRIX_TRANSFORM_MIN_LOG_LEVEL
+#define MATRIX_TRANSFORM_MIN_LOG_LEVEL 0
+#endif
 
 namespace MatrixTransform {
 
@@ -13,6 +25,13 @@ namespace MatrixTransform {
         None
     };
 
+    constexpr LogLevel MinLogLevel = static_cast<LogLevel>(MATRIX_TRANSFORM_MIN_LOG_LEVEL);
+
+    // Asynchronous logger. Callers copy the format pointer and raw arguments into a slot of a
+    // lock-free multi-producer ring; a background thread formats and writes them, so a call
+    // costs a timestamp, one compare-and-swap and a small copy. With the formatting overload,
+    // messages below the compile-time or runtime level cost a single load. If the ring is
+    // full the message is dropped and counted rather than blocking the caller.
     class Logger {
     public:
         static Logger& getInstance() {
@@ -24,13 +43,144 @@ namespace MatrixTransform {
         Logger& operator=(const Logger&) = delete;
 
         void setLevel(const std::string& levelStr);
-        void log(LogLevel level, const std::string& message);
+        void setLevel(LogLevel level) { current_level_.store(level, std::memory_order_relaxed); }
+        LogLevel level() const { return current_level_.load(std::memory_order_relaxed); }
+
+        bool enabled(LogLevel level) const {
+            return level >= MinLogLevel && level != LogLevel::None && level >= current_level_.load(std::memory_order_relaxed);
+        }
+
+        // Logs a message that is already built.
+        void log(LogLevel level, const std::string& message) {
+            if (enabled(level)) {
+                enqueue(level, "{}", message);
+            }
+        }
+
+        // Deferred formatting: each "{}" in format is replaced by the next argument on the
+        // writer thread. format must outlive the call (use a literal); arguments may be
+        // integers, floating point, bool, C strings or std::string. C strings are truncated to
+        // fit one record.
+        template <typename... Args>
+        void log(LogLevel level, const char* format, const Args&... args) {
+            if (enabled(level)) {
+                enqueue(level, format, args...);
+            }
+        }
+
+        // Blocks until every message logged before the call has been written.
+        void flush();
 
     private:
-        Logger() : current_level_(LogLevel::Info) {}
-        ~Logger() = default;
+        static constexpr std::size_t Capacity = 4096;
+        static constexpr std::size_t PayloadBytes = 216;
+
+        enum Tag : char { Signed = 'i', Unsigned = 'u', Double = 'd', Bool = 'b', String = 's', HeapString = 'h' };
+
+        struct alignas(64) Record {
+            std::atomic<std::uint64_t> sequence;
+            LogLevel level;
+            std::uint32_t size;
+            std::int64_t timestamp;
+            const char* format;
+            char payload[PayloadBytes];
+        };
+
+        // Appends tagged arguments to a record payload; silently stops when it is full.
+        struct Encoder {
+            char* data;
+            std::size_t size;
+
+            void raw(char tag, const void* bytes, std::size_t count) {
+                if (size + 1 + count > PayloadBytes) {
+                    return;
+                }
+                data[size] = tag;
+                std::memcpy(data + size + 1, bytes, count);
+                size += 1 + count;
+            }
+
+            void text(const char* value, std::size_t length) {
+                if (size + 3 > PayloadBytes) {
+                    return;
+                }
+                const std::uint16_t fit = static_cast<std::uint16_t>(std::min(length, PayloadBytes - size - 3));
+                data[size] = String;
+                std::memcpy(data + size + 1, &fit, sizeof(fit));
+                std::memcpy(data + size + 3, value, fit);
+                size += 3 + fit;
+            }
+
+            template <typename T>
+            void put(const T& value) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    raw(Bool, &value, sizeof(value));
+                } else if constexpr (std::is_same_v<T, char>) {
+                    text(&value, 1);
+                } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                    const std::int64_t widened = value;
+                    raw(Signed, &widened, sizeof(widened));
+                } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+                    const std::uint64_t widened = static_cast<std::uint64_t>(value);
+                    raw(Unsigned, &widened, sizeof(widened));
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    const double widened = value;
+                    raw(Double, &widened, sizeof(widened));
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    // Prebuilt messages that do not fit are handed over on the heap instead of
+                    // being cut short; the writer frees them.
+                    if (size + 3 + value.size() > PayloadBytes && size + 1 + sizeof(std::string*) <= PayloadBytes) {
+                        const std::string* copy = new std::string(value);
+                        raw(HeapString, &copy, sizeof(copy));
+                    } else {
+                        text(value.data(), value.size());
+                    }
+                } else {
+                    const char* string = value;
+                    text(string, string != nullptr ? std::strlen(string) : 0);
+                }
+            }
+        };
+
+        Logger();
+        ~Logger();
+
+        template <typename... Args>
+        void enqueue(LogLevel level, const char* format, const Args&... args) {
+            std::uint64_t position = 0;
+            Record* record = claim(position);
+            if (record == nullptr) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            record->level = level;
+            record->timestamp = now();
+            record->format = format;
+            Encoder encoder{record->payload, 0};
+            (encoder.put(args), ...);
+            record->size = static_cast<std::uint32_t>(encoder.size);
+            publish(*record, position, level);
+        }
+
+        Record* claim(std::uint64_t& position);
+        void publish(Record& record, std::uint64_t position, LogLevel level);
+        static std::int64_t now();
+        static void format(const Record& record, std::string& out);
+        void run();
+        bool drain();
 
-        LogLevel current_level_;
+        std::atomic<LogLevel> current_level_;
+        alignas(64) std::atomic<std::uint64_t> head_{0};
+        alignas(64) std::atomic<std::uint64_t> written_{0};
+        std::atomic<std::uint64_t> dropped_{0};
+        std::atomic<bool> running_{false};
+        std::uint64_t tail_ = 0;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool wakeRequested_ = false;
+        bool stopRequested_ = false;
+        std::thread writer_;
+        Record ring_[Capacity];
     };
 
-} // namespace MatrixTransform
\ No newline at end of file
+} // namespace MatrixTransform
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "matrix_transform/matrix_types.hpp"
+
+namespace MatrixTransform {
+
+    // Runs compute(c, ldc), which writes a column-major C, on any output view. Views that are
+    // not column-major go through a temporary, loaded first when beta != 0.
+    template <typename Compute>
+    void withColumnMajorStorage(float beta, MatrixView c, Compute&& compute) {
+        if (c.isColumnMajor()) {
+            compute(c.data(), c.colStride());
+            return;
+        }
+        Matrix staged(c.rows(), c.cols());
+        if (beta != 0.0f) {
+            staged = c.map();
+        }
+        compute(staged.data(), staged.outerStride());
+        c.map() = staged;
+    }
+
+    // As above for kernels that also take strided operands: compute(a, b, c, ldc) performs
+    // c = alpha * a * b + beta * c. A row-major C is handled as the transposed product
+    // C^T = B^T * A^T, which is column-major in the same memory, so only other strides are staged.
+    template <typename Compute>
+    void withColumnMajorOutput(ConstMatrixView a, ConstMatrixView b, float beta, MatrixView c, Compute&& compute) {
+        if (!c.isColumnMajor() && c.colStride() == 1) {
+            compute(b.transpose(), a.transpose(), c.data(), c.rowStride());
+            return;
+        }
+        withColumnMajorStorage(beta, c, [&](float* out, Eigen::Index ldc) {
+            compute(a, b, out, ldc);
+        });
+    }
+
+    // Eigen's product kernels read a map in place only when its inner stride is 1 at compile
+    // time, and copy a StridedMap operand first. Calls compute(operand) with a column-major
+    // OuterStride map of v, or the transpose of one when v is row-major; only views strided in
+    // both directions are copied.
+    template <typename Compute>
+    void withDenseOperand(ConstMatrixView v, Compute&& compute) {
+        using DenseMap = Eigen::Map<const Matrix, 0, Eigen::OuterStride<>>;
+        if (v.isColumnMajor()) {
+            compute(DenseMap(v.data(), v.rows(), v.cols(), Eigen::OuterStride<>(v.colStride())));
+        } else if (v.colStride() == 1) {
+            compute(DenseMap(v.data(), v.cols(), v.rows(), Eigen::OuterStride<>(v.rowStride())).transpose());
+        } else {
+            const Matrix copy = v.map();
+            compute(DenseMap(copy.data(), copy.rows(), copy.cols(), Eigen::OuterStride<>(copy.outerStride())));
+        }
+    }
+
+    // Copies the given triangle of the square c over the other one.
+    inline void mirrorTriangle(MatrixView c, Triangle from) {
+        for (Eigen::Index j = 0; j < c.cols(); ++j) {
+            for (Eigen::Index i = 0; i < j; ++i) {
+                if (from == Triangle::Lower) {
+                    c(i, j) = c(j, i);
+                } else {
+                    c(j, i) = c(i, j);
+                }
+            }
+        }
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,272 @@
+#include "numa.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+namespace MatrixTransform {
+
+    namespace {
+        // Parses a kernel CPU list such as "0-3,8-11".
+        std::vector<int> parseCpuList(const std::string& text) {
+            std::vector<int> cpus;
+            std::stringstream stream(text);
+            std::string range;
+            while (std::getline(stream, range, ',')) {
+                if (range.empty()) {
+                    continue;
+                }
+                const std::size_t dash = range.find('-');
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+
+#ifdef __linux__
+        cpu_set_t& processCpus() {
+            static cpu_set_t set = []() {
+                cpu_set_t initial;
+                CPU_ZERO(&initial);
+                if (sched_getaffinity(0, sizeof(initial), &initial) != 0) {
+                    for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()) && cpu < CPU_SETSIZE; ++cpu) {
+                        CPU_SET(cpu, &initial);
+                    }
+                }
+                return initial;
+            }();
+            return set;
+        }
+#endif
+
+        thread_local int pinnedCpu = -1;
+    }
+
+    ThreadPlacement& ThreadPlacement::global() {
+        static ThreadPlacement placement;
+        return placement;
+    }
+
+    PinPolicy ThreadPlacement::parsePinning(const std::string& name) {
+        if (name == "none") {
+            return PinPolicy::None;
+        }
+        if (name == "compact") {
+            return PinPolicy::Compact;
+        }
+        if (name == "spread") {
+            return PinPolicy::Spread;
+        }
+        throw std::invalid_argument("Unknown pinning policy '" + name + "'; expected none, compact or spread.");
+    }
+
+    NumaMode ThreadPlacement::parseNuma(const std::string& name) {
+        if (name == "off") {
+            return NumaMode::Off;
+        }
+        if (name == "first_touch") {
+            return NumaMode::FirstTouch;
+        }
+        if (name == "replicate") {
+            return NumaMode::Replicate;
+        }
+        throw std::invalid_argument("Unknown NUMA mode '" + name + "'; expected off, first_touch or replicate.");
+    }
+
+    std::string ThreadPlacement::toString(PinPolicy pinning) {
+        switch (pinning) {
+            case PinPolicy::None:    return "none";
+            case PinPolicy::Compact: return "compact";
+            case PinPolicy::Spread:  return "spread";
+        }
+        return "none";
+    }
+
+    std::string ThreadPlacement::toString(NumaMode numa) {
+        switch (numa) {
+            case NumaMode::Off:        return "off";
+            case NumaMode::FirstTouch: return "first_touch";
+            case NumaMode::Replicate:  return "replicate";
+        }
+        return "off";
+    }
+
+    NumaTopology::NumaTopology() {
+#ifdef __linux__
+        const cpu_set_t& allowed = processCpus();
+        if (DIR* dir = opendir("/sys/devices/system/node")) {
+            while (dirent* entry = readdir(dir)) {
+                const std::string name = entry->d_name;
+                if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                    name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                    continue;
+                }
+                std::ifstream list("/sys/devices/system/node/" + name + "/cpulist");
+                std::string text;
+                std::getline(list, text);
+                Node node{std::stoi(name.substr(4)), {}};
+                for (int cpu : parseCpuList(text)) {
+                    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                        node.cpus.push_back(cpu);
+                    }
+                }
+                // Memory-only nodes and nodes outside our cpuset have no threads to place.
+                if (!node.cpus.empty()) {
+                    nodes_.push_back(std::move(node));
+                }
+            }
+            closedir(dir);
+        }
+        if (nodes_.empty()) {
+            Node node{0, {}};
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+            nodes_.push_back(std::move(node));
+        }
+#else
+        Node node{0, {}};
+        for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu) {
+            node.cpus.push_back(cpu);
+        }
+        nodes_.push_back(std::move(node));
+#endif
+        std::sort(nodes_.begin(), nodes_.end(), [](const Node& x, const Node& y) { return x.id < y.id; });
+        for (const Node& node : nodes_) {
+            for (int cpu : node.cpus) {
+                if (cpu >= static_cast<int>(cpuNode_.size())) {
+                    cpuNode_.resize(cpu + 1, -1);
+                }
+                cpuNode_[cpu] = node.id;
+            }
+        }
+    }
+
+    const NumaTopology& NumaTopology::get() {
+        static const NumaTopology topology;
+        return topology;
+    }
+
+    int NumaTopology::nodeOfCpu(int cpu) const {
+        if (cpu < 0 || cpu >= static_cast<int>(cpuNode_.size()) || cpuNode_[cpu] < 0) {
+            return nodes_.front().id;
+        }
+        return cpuNode_[cpu];
+    }
+
+    int NumaTopology::currentNode() const {
+#ifdef __linux__
+        return nodeOfCpu(sched_getcpu());
+#else
+        return nodes_.front().id;
+#endif
+    }
+
+    const TeamLayout& NumaTopology::layout(PinPolicy pinning, int threads) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<TeamLayout>& cached = layouts_[{pinning, threads}];
+        if (cached) {
+            return *cached;
+        }
+
+        std::vector<int> order;
+        if (pinning == PinPolicy::Spread) {
+            std::size_t longest = 0;
+            for (const Node& node : nodes_) {
+                longest = std::max(longest, node.cpus.size());
+            }
+            for (std::size_t i = 0; i < longest; ++i) {
+                for (const Node& node : nodes_) {
+                    if (i < node.cpus.size()) {
+                        order.push_back(node.cpus[i]);
+                    }
+                }
+            }
+        } else {
+            for (const Node& node : nodes_) {
+                order.insert(order.end(), node.cpus.begin(), node.cpus.end());
+            }
+        }
+
+        auto layout = std::make_unique<TeamLayout>();
+        std::map<int, int> replicaOfNode;
+        for (int t = 0; t < threads; ++t) {
+            const int cpu = order[t % order.size()];
+            const int node = nodeOfCpu(cpu);
+            auto it = replicaOfNode.find(node);
+            if (it == replicaOfNode.end()) {
+                it = replicaOfNode.emplace(node, static_cast<int>(layout->replicaSize.size())).first;
+                layout->replicaSize.push_back(0);
+            }
+            layout->cpu.push_back(cpu);
+            layout->node.push_back(node);
+            layout->replica.push_back(it->second);
+            layout->replicaRank.push_back(layout->replicaSize[it->second]++);
+        }
+        cached = std::move(layout);
+        return *cached;
+    }
+
+    void pinCurrentThread(int cpu) {
+        if (cpu == pinnedCpu) {
+            return;
+        }
+#ifdef __linux__
+        cpu_set_t set;
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+        } else {
+            set = processCpus();
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            return;
+        }
+#endif
+        pinnedCpu = cpu;
+    }
+
+    NumaStats& NumaStats::getInstance() {
+        static NumaStats stats;
+        return stats;
+    }
+
+    void NumaStats::record(int node, double busySeconds, double flops) {
+        const int slot = std::clamp(node, 0, MaxNodes - 1);
+        threadCalls_[slot].fetch_add(1, std::memory_order_relaxed);
+        busyNanos_[slot].fetch_add(static_cast<std::uint64_t>(busySeconds * 1e9), std::memory_order_relaxed);
+        flops_[slot].fetch_add(static_cast<std::uint64_t>(flops), std::memory_order_relaxed);
+    }
+
+    void NumaStats::reset() {
+        for (int node = 0; node < MaxNodes; ++node) {
+            threadCalls_[node].store(0, std::memory_order_relaxed);
+            busyNanos_[node].store(0, std::memory_order_relaxed);
+            flops_[node].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<NumaStats::Node> NumaStats::snapshot() const {
+        std::vector<Node> nodes;
+        for (int node = 0; node < MaxNodes; ++node) {
+            const std::uint64_t calls = threadCalls_[node].load(std::memory_order_relaxed);
+            if (calls != 0) {
+                nodes.push_back({node, calls, busyNanos_[node].load(std::memory_order_relaxed) * 1e-9,
+                                 static_cast<double>(flops_[node].load(std::memory_order_relaxed))});
+            }
+        }
+        return nodes;
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MatrixTransform {
+
+    // Where the threads of a parallel kernel run. "compact" fills one NUMA node's CPUs before
+    // the next, "spread" deals threads round-robin across nodes.
+    enum class PinPolicy {
+        None,
+        Compact,
+        Spread
+    };
+
+    // How shared packed panels are placed. "first_touch" packs them in parallel from pinned
+    // threads so their pages are spread over the nodes that use them; "replicate" gives every
+    // node its own copy, packed by that node's threads, so no thread reads B across the
+    // interconnect.
+    enum class NumaMode {
+        Off,
+        FirstTouch,
+        Replicate
+    };
+
+    struct ThreadPlacement {
+        PinPolicy pinning = PinPolicy::None;
+        NumaMode numa = NumaMode::Off;
+
+        // Process-wide default for backends that are not configured individually; set from the
+        // "parallelism" section of the config.
+        static ThreadPlacement& global();
+
+        // Accept "none" / "compact" / "spread" and "off" / "first_touch" / "replicate".
+        static PinPolicy parsePinning(const std::string& name);
+        static NumaMode parseNuma(const std::string& name);
+        static std::string toString(PinPolicy pinning);
+        static std::string toString(NumaMode numa);
+    };
+
+    // CPU and node of every thread of an OpenMP team, plus its rank among the team threads
+    // on the same node (its "replica").
+    struct TeamLayout {
+        std::vector<int> cpu;
+        std::vector<int> node;
+        std::vector<int> replica;
+        std::vector<int> replicaRank;
+        std::vector<int> replicaSize;
+    };
+
+    // NUMA nodes and their CPUs from /sys/devices/system/node, restricted to the CPUs this
+    // process may run on. Hosts without that information report a single node.
+    class NumaTopology {
+    public:
+        struct Node {
+            int id;
+            std::vector<int> cpus;
+        };
+
+        static const NumaTopology& get();
+
+        const std::vector<Node>& nodes() const { return nodes_; }
+        int nodeOfCpu(int cpu) const;
+        int currentNode() const;
+
+        // Layouts are computed once per (policy, team size) and cached.
+        const TeamLayout& layout(PinPolicy pinning, int threads) const;
+
+    private:
+        NumaTopology();
+
+        std::vector<Node> nodes_;
+        std::vector<int> cpuNode_;
+        mutable std::mutex mutex_;
+        mutable std::map<std::pair<PinPolicy, int>, std::unique_ptr<TeamLayout>> layouts_;
+    };
+
+    // Pins the calling thread to one CPU, or back to the process's CPU set for cpu < 0.
+    // Repeated calls with the same CPU are free.
+    void pinCurrentThread(int cpu);
+
+    // Busy time and flops of the packed kernels per NUMA node, summed over threads. Off by
+    // default; the benchmark enables it and resets and reads it around its timed runs.
+    class NumaStats {
+    public:
+        struct Node {
+            int node;
+            std::uint64_t threadCalls;
+            double busySeconds;
+            double flops;
+        };
+
+        static NumaStats& getInstance();
+
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+        void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        void record(int node, double busySeconds, double flops);
+        void reset();
+        std::vector<Node> snapshot() const;
+
+    private:
+        static constexpr int MaxNodes = 64;
+
+        NumaStats() = default;
+
+        std::atomic<bool> enabled_{false};
+        std::atomic<std::uint64_t> threadCalls_[MaxNodes] = {};
+        std::atomic<std::uint64_t> busyNanos_[MaxNodes] = {};
+        std::atomic<std::uint64_t> flops_[MaxNodes] = {};
+    };
+
+} // namespace MatrixTransform
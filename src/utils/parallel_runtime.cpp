@@ -0,0 +1,148 @@
+#include "parallel_runtime.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MatrixTransform {
+
+    namespace {
+        // One loop run without a runtime: the caller and pool workers claim chunks of iterations
+        // until none are left, and the caller waits only for chunks already claimed, so a loop
+        // started on a pool worker never waits on queued tasks. Helpers that start after the
+        // loop has finished find nothing to claim and never touch body.
+        struct PoolLoop {
+            std::ptrdiff_t count = 0;
+            std::ptrdiff_t chunk = 1;
+            const std::function<void(std::ptrdiff_t)>* body = nullptr;
+            std::atomic<std::ptrdiff_t> next{0};
+            std::atomic<std::ptrdiff_t> done{0};
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;
+        };
+
+        void runChunks(PoolLoop& loop) {
+            for (;;) {
+                const std::ptrdiff_t begin = loop.next.fetch_add(loop.chunk, std::memory_order_acq_rel);
+                if (begin >= loop.count) {
+                    return;
+                }
+                const std::ptrdiff_t end = std::min(loop.count, begin + loop.chunk);
+                try {
+                    for (std::ptrdiff_t i = begin; i < end; ++i) {
+                        (*loop.body)(i);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(loop.mutex);
+                    if (!loop.error) {
+                        loop.error = std::current_exception();
+                    }
+                }
+                if (loop.done.fetch_add(end - begin, std::memory_order_acq_rel) + (end - begin) == loop.count) {
+                    std::lock_guard<std::mutex> lock(loop.mutex);
+                    loop.finished.notify_all();
+                }
+            }
+        }
+
+        void poolFor(std::ptrdiff_t count, bool dynamic, const std::function<void(std::ptrdiff_t)>& body) {
+            ThreadPool& pool = ThreadPool::getInstance();
+            const std::ptrdiff_t threads = static_cast<std::ptrdiff_t>(pool.workerCount()) + 1;
+            if (count <= 1 || threads == 1) {
+                for (std::ptrdiff_t i = 0; i < count; ++i) {
+                    body(i);
+                }
+                return;
+            }
+
+            auto loop = std::make_shared<PoolLoop>();
+            loop->count = count;
+            loop->chunk = dynamic ? 1 : (count + threads - 1) / threads;
+            loop->body = &body;
+            const std::ptrdiff_t helpers = std::min(threads - 1, (count + loop->chunk - 1) / loop->chunk - 1);
+            std::vector<std::function<void()>> tasks;
+            for (std::ptrdiff_t h = 0; h < helpers; ++h) {
+                tasks.push_back([loop]() { runChunks(*loop); });
+            }
+            pool.submit(std::move(tasks));
+
+            runChunks(*loop);
+            std::unique_lock<std::mutex> lock(loop->mutex);
+            loop->finished.wait(lock, [&]() { return loop->done.load(std::memory_order_acquire) == count; });
+            if (loop->error) {
+                std::rethrow_exception(loop->error);
+            }
+        }
+    }
+
+    ParallelRuntime& ParallelRuntime::getInstance() {
+        static ParallelRuntime instance;
+        return instance;
+    }
+
+    void ParallelRuntime::install(const Hooks& hooks) {
+        if (installed()) {
+            return;
+        }
+        hooks_ = hooks;
+        const int requested = requestedThreads_.load(std::memory_order_acquire);
+        if (requested > 0) {
+            hooks_.setThreads(requested);
+        }
+        installed_.store(true, std::memory_order_release);
+    }
+
+    void ParallelRuntime::setThreads(int threads) {
+        if (threads <= 0) {
+            return;
+        }
+        requestedThreads_.store(threads, std::memory_order_release);
+        if (installed()) {
+            hooks_.setThreads(threads);
+        }
+    }
+
+    int ParallelRuntime::maxThreads() const {
+        if (installed()) {
+            return hooks_.maxThreads();
+        }
+        const int requested = requestedThreads_.load(std::memory_order_acquire);
+        if (requested > 0) {
+            return requested;
+        }
+        if (const char* env = std::getenv("OMP_NUM_THREADS")) {
+            const int threads = std::atoi(env);
+            if (threads > 0) {
+                return threads;
+            }
+        }
+        return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    bool ParallelRuntime::inParallel() const {
+        return installed() && hooks_.inParallel();
+    }
+
+    void ParallelRuntime::parallelFor(std::ptrdiff_t count, bool dynamic, const std::function<void(std::ptrdiff_t)>& body) const {
+        if (installed()) {
+            hooks_.parallelFor(count, dynamic, body);
+            return;
+        }
+        poolFor(count, dynamic, body);
+    }
+
+    void ParallelRuntime::onEachThread(int team, const std::function<void()>& body) const {
+        if (installed()) {
+            hooks_.onEachThread(team, body);
+            return;
+        }
+        poolFor(team, false, [&](std::ptrdiff_t) { body(); });
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace MatrixTransform {
+
+    // The thread team the library's own parallel loops run on. matrix_core does not link an
+    // OpenMP runtime: the kernels library, which every OpenMP backend links, installs its team
+    // here when it is loaded. Until then, as in the CPU and NEON plugins, loops are spread over
+    // the calling thread and the shared ThreadPool, and a team size set through setThreads() is
+    // kept and handed to the runtime once it is installed.
+    class ParallelRuntime {
+    public:
+        struct Hooks {
+            void (*setThreads)(int threads);
+            int (*maxThreads)();
+            bool (*inParallel)();
+            // Calls body(i) for every i in [0, count); dynamic hands iterations out one at a time.
+            void (*parallelFor)(std::ptrdiff_t count, bool dynamic, const std::function<void(std::ptrdiff_t)>& body);
+            // Calls body() once on each thread of a team of the given size.
+            void (*onEachThread)(int team, const std::function<void()>& body);
+        };
+
+        static ParallelRuntime& getInstance();
+
+        ParallelRuntime(const ParallelRuntime&) = delete;
+        ParallelRuntime& operator=(const ParallelRuntime&) = delete;
+
+        void install(const Hooks& hooks);
+        bool installed() const { return installed_.load(std::memory_order_acquire); }
+
+        void setThreads(int threads);
+        // Team size of the next parallel region. Without a runtime, the size it will start
+        // with: the requested count, else OMP_NUM_THREADS, else the hardware thread count.
+        int maxThreads() const;
+        bool inParallel() const;
+
+        void parallelFor(std::ptrdiff_t count, bool dynamic, const std::function<void(std::ptrdiff_t)>& body) const;
+        // Without a runtime, body() runs team times over the calling thread and pool workers.
+        void onEachThread(int team, const std::function<void()>& body) const;
+
+    private:
+        ParallelRuntime() = default;
+
+        Hooks hooks_{};
+        std::atomic<bool> installed_{false};
+        std::atomic<int> requestedThreads_{0};
+    };
+
+} // namespace MatrixTransform
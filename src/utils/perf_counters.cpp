@@ -0,0 +1,159 @@
+#include "perf_counters.hpp"
+#include "parallel_runtime.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MatrixTransform {
+
+    namespace {
+        thread_local bool threadRegistered = false;
+
+#ifdef __linux__
+        int openCounter(HardwareCounter counter, std::uint64_t rawFlopEvent) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            switch (counter) {
+                case HardwareCounter::Cycles:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                    break;
+                case HardwareCounter::Instructions:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    break;
+                case HardwareCounter::LlcMisses:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+                case HardwareCounter::FlopEvents:
+                    if (rawFlopEvent == 0) {
+                        return -1;
+                    }
+                    attr.type = PERF_TYPE_RAW;
+                    attr.config = rawFlopEvent;
+                    break;
+                case HardwareCounter::TaskClock:
+                    attr.type = PERF_TYPE_SOFTWARE;
+                    attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                    break;
+            }
+            // pid 0, cpu -1: this thread, wherever it runs.
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+
+        // Counter value scaled up for the time the kernel multiplexed it out.
+        std::uint64_t readCounter(int fd) {
+            std::uint64_t value[3];
+            if (::read(fd, value, sizeof(value)) != static_cast<ssize_t>(sizeof(value)) || value[2] == 0) {
+                return 0;
+            }
+            if (value[2] >= value[1]) {
+                return value[0];
+            }
+            return static_cast<std::uint64_t>(static_cast<double>(value[0]) * value[1] / value[2]);
+        }
+#endif
+    }
+
+    PerfCounters& PerfCounters::getInstance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    PerfCounters::~PerfCounters() {
+#ifdef __linux__
+        for (const Thread& thread : threads_) {
+            for (int fd : thread.fds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        }
+#endif
+    }
+
+    bool PerfCounters::enable(std::uint64_t rawFlopEvent) {
+#ifdef __linux__
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (enabled()) {
+                return true;
+            }
+            bool any = false;
+            for (int c = 0; c < HardwareCounterCount; ++c) {
+                const int fd = openCounter(static_cast<HardwareCounter>(c), rawFlopEvent);
+                available_[c] = fd >= 0;
+                any = any || fd >= 0;
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+            if (!any) {
+                return false;
+            }
+            rawFlopEvent_ = rawFlopEvent;
+            enabled_.store(true, std::memory_order_release);
+        }
+        registerThreads();
+        return true;
+#else
+        (void)rawFlopEvent;
+        return false;
+#endif
+    }
+
+    void PerfCounters::registerThreads() {
+        if (!threadRegistered) {
+            registerCurrentThread();
+        }
+        // Threads that join later teams are picked up the first time the team grows.
+        const ParallelRuntime& runtime = ParallelRuntime::getInstance();
+        const int team = runtime.maxThreads();
+        if (runtime.installed() && team > teamSize_.load(std::memory_order_acquire) && !runtime.inParallel()) {
+            runtime.onEachThread(team, [this]() {
+                if (!threadRegistered) {
+                    registerCurrentThread();
+                }
+            });
+            teamSize_.store(team, std::memory_order_release);
+        }
+    }
+
+    void PerfCounters::registerCurrentThread() {
+#ifdef __linux__
+        Thread thread;
+        for (int c = 0; c < HardwareCounterCount; ++c) {
+            thread.fds[c] = available_[c] ? openCounter(static_cast<HardwareCounter>(c), rawFlopEvent_) : -1;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.push_back(thread);
+#endif
+        threadRegistered = true;
+    }
+
+    void PerfCounters::read(std::uint64_t (&values)[HardwareCounterCount]) {
+        std::fill(values, values + HardwareCounterCount, 0);
+#ifdef __linux__
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Thread& thread : threads_) {
+            for (int c = 0; c < HardwareCounterCount; ++c) {
+                if (thread.fds[c] >= 0) {
+                    values[c] += readCounter(thread.fds[c]);
+                }
+            }
+        }
+#endif
+    }
+
+} // namespace MatrixTransform
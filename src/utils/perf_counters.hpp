@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "matrix_transform/metrics.hpp"
+
+namespace MatrixTransform {
+
+    // Per-thread perf_event_open counters summed over every registered thread, so the work of
+    // OpenMP teams is included. Concurrent calls on different threads see each other's events.
+    // Without Linux perf support enable() returns false and nothing is counted.
+    class PerfCounters {
+    public:
+        static PerfCounters& getInstance();
+
+        bool enable(std::uint64_t rawFlopEvent);
+        bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+        bool available(HardwareCounter counter) const { return available_[static_cast<int>(counter)]; }
+
+        // Registers the calling thread, and the OpenMP team if it has grown since last time.
+        // Cheap once both are registered.
+        void registerThreads();
+
+        // Current totals over the registered threads; unavailable counters read 0.
+        void read(std::uint64_t (&values)[HardwareCounterCount]);
+
+    private:
+        struct Thread {
+            int fds[HardwareCounterCount];
+        };
+
+        PerfCounters() = default;
+        ~PerfCounters();
+
+        void registerCurrentThread();
+
+        std::mutex mutex_;
+        std::vector<Thread> threads_;
+        std::atomic<bool> enabled_{false};
+        std::atomic<int> teamSize_{0};
+        std::uint64_t rawFlopEvent_ = 0;
+        bool available_[HardwareCounterCount] = {};
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include "shard_protocol.hpp"
+
+namespace MatrixTransform {
+namespace ServeProtocol {
+
+    // Messages between matrix_app in server mode and its clients over a SOCK_SEQPACKET Unix
+    // socket, one fixed-size record per message. Each client shares one memory buffer with
+    // the server by passing its file descriptor (a memfd, or any mappable fd) with Attach;
+    // operands are read from and results written to that buffer in place, so requests carry
+    // only shapes and byte offsets. A client may pipeline several requests and match the
+    // replies by id.
+    constexpr std::uint32_t Version = 1;
+
+    enum class Op : std::uint32_t {
+        Attach = 1,     // map the buffer passed as SCM_RIGHTS (replacing any previous one)
+        Multiply = 2,   // C = A * B on column-major, densely packed operands in the buffer
+    };
+
+    struct Request {
+        std::uint32_t version;
+        Op op;
+        std::uint64_t id;
+        std::uint64_t bufferBytes;
+        std::int64_t m, n, k;
+        std::uint64_t aOffset, bOffset, cOffset;
+    };
+
+    struct Reply {
+        std::uint64_t id;
+        std::int32_t status;    // 0 on success
+        std::uint32_t batchSize;    // products executed together with this one
+        double queueSeconds;    // from arrival until its batch started
+        double computeSeconds;  // time the batch spent in the backend
+        char message[200];
+    };
+
+    using ShardProtocol::send;
+    using ShardProtocol::receive;
+
+    // Sends a record together with a file descriptor.
+    template <typename T>
+    bool sendWithDescriptor(int socket, const T& record, int fd) {
+        iovec data{const_cast<T*>(&record), sizeof(T)};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr message{};
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+        for (;;) {
+            const ssize_t sent = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+            if (sent == static_cast<ssize_t>(sizeof(T))) {
+                return true;
+            }
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+    }
+
+    // Receives one record and the descriptor sent with it, if any (fd is -1 otherwise).
+    template <typename T>
+    bool receiveWithDescriptor(int socket, T& record, int& fd) {
+        iovec data{&record, sizeof(T)};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr message{};
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        fd = -1;
+        for (;;) {
+            const ssize_t received = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+                if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+                    std::memcpy(&fd, CMSG_DATA(header), sizeof(int));
+                }
+            }
+            return received == static_cast<ssize_t>(sizeof(T));
+        }
+    }
+
+} // namespace ServeProtocol
+} // namespace MatrixTransform
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace MatrixTransform {
+namespace ShardProtocol {
+
+    // Messages exchanged between the SHARDED backend and matrix_worker processes over a
+    // SOCK_SEQPACKET Unix socket, one fixed-size record per message. Bulk data never goes
+    // through the socket: operands and results live in a POSIX shared memory segment that both
+    // sides map, and requests carry byte offsets into it.
+    constexpr std::uint32_t Version = 1;
+
+    enum class Op : std::uint32_t {
+        Attach = 1,     // map the segment named in `segment` (replacing any previous one)
+        Gemm = 2,       // C block = alpha * A panel * B panel + beta * C block
+        Shutdown = 3,
+    };
+
+    struct Request {
+        std::uint32_t version;
+        Op op;
+        char segment[64];
+        std::uint64_t segmentBytes;
+        // Column-major blocks inside the segment; offsets in bytes, leading dimensions in floats.
+        std::int64_t m, n, k;
+        std::uint64_t aOffset, bOffset, cOffset;
+        std::int64_t lda, ldb, ldc;
+        float alpha, beta;
+    };
+
+    struct Reply {
+        std::int32_t status;    // 0 on success
+        double seconds;         // time spent in the worker's backend
+        char message[240];
+    };
+
+    // Sends or receives one whole record. Returns false on a closed or failed socket.
+    template <typename T>
+    bool send(int socket, const T& record) {
+        for (;;) {
+            const ssize_t sent = ::send(socket, &record, sizeof(T), MSG_NOSIGNAL);
+            if (sent == static_cast<ssize_t>(sizeof(T))) {
+                return true;
+            }
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+    }
+
+    template <typename T>
+    bool receive(int socket, T& record) {
+        for (;;) {
+            const ssize_t received = ::recv(socket, &record, sizeof(T), 0);
+            if (received == static_cast<ssize_t>(sizeof(T))) {
+                return true;
+            }
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+    }
+
+} // namespace ShardProtocol
+} // namespace MatrixTransform
@@ -0,0 +1,103 @@
+#include "thread_pool.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace MatrixTransform {
+
+    ThreadPool& ThreadPool::getInstance() {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    ThreadPool::ThreadPool() {
+        const std::size_t count = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < count; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        std::vector<std::function<void()>> tasks;
+        tasks.push_back(std::move(task));
+        submit(std::move(tasks));
+    }
+
+    void ThreadPool::submit(std::vector<std::function<void()>> tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+        // Count first so a worker that pops a task early never drives the counter below zero.
+        pending_.fetch_add(tasks.size(), std::memory_order_release);
+        std::size_t queue = nextQueue_.fetch_add(tasks.size(), std::memory_order_relaxed);
+        for (std::function<void()>& task : tasks) {
+            WorkerQueue& target = *queues_[queue++ % queues_.size()];
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.tasks.push_back(std::move(task));
+        }
+
+        // Taking the sleep mutex orders this wake-up after any worker's predicate check.
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wakeUp_.notify_all();
+    }
+
+    bool ThreadPool::tryPop(std::size_t index, std::function<void()>& task) {
+        WorkerQueue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.tasks.empty()) {
+            return false;
+        }
+        task = std::move(own.tasks.front());
+        own.tasks.pop_front();
+        return true;
+    }
+
+    bool ThreadPool::trySteal(std::size_t thief, std::function<void()>& task) {
+        for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+            WorkerQueue& victim = *queues_[(thief + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::workerLoop(std::size_t index) {
+        std::function<void()> task;
+        for (;;) {
+            if (tryPop(index, task) || trySteal(index, task)) {
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+                try {
+                    task();
+                } catch (const std::exception& e) {
+                    Logger::getInstance().log(LogLevel::Error, "Unhandled exception in pool task: {}", e.what());
+                }
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wakeUp_.wait(lock, [this]() { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+            if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+} // namespace MatrixTransform
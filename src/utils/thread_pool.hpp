@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MatrixTransform {
+
+    // Library-owned pool with one thread per hardware core. Every worker has its own task
+    // deque; a worker serves its deque in FIFO order and steals from the back of the others
+    // when it runs dry, so tiles of concurrent requests interleave and no core idles while
+    // work is queued. Tasks must not block on other tasks.
+    class ThreadPool {
+    public:
+        static ThreadPool& getInstance();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Spreads the tasks round-robin across the worker deques. Safe from any thread.
+        void submit(std::vector<std::function<void()>> tasks);
+        void submit(std::function<void()> task);
+
+        std::size_t workerCount() const { return workers_.size(); }
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        ThreadPool();
+        ~ThreadPool();
+
+        void workerLoop(std::size_t index);
+        bool tryPop(std::size_t index, std::function<void()>& task);
+        bool trySteal(std::size_t thief, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> workers_;
+        std::atomic<std::size_t> nextQueue_{0};
+        std::atomic<std::size_t> pending_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable wakeUp_;
+        bool stopping_ = false;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,238 @@
+#include "matrix_transform/tiled_matrix.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MatrixTransform {
+
+    namespace {
+        constexpr char Magic[8] = {'M', 'T', 'T', 'I', 'L', 'E', '0', '1'};
+        constexpr std::uint32_t FormatVersion = 1;
+        constexpr std::size_t HeaderBytes = 4096;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t tileSize;
+            std::uint64_t rows;
+            std::uint64_t cols;
+        };
+
+        [[noreturn]] void fail(const std::string& message) {
+            Logger::getInstance().log(LogLevel::Error, message);
+            throw std::runtime_error(message);
+        }
+
+        std::size_t pageSize() {
+            static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        // Whole tiles must stay page aligned.
+        bool validTileSize(Eigen::Index tileSize) {
+            return tileSize > 0 && (static_cast<std::size_t>(tileSize * tileSize) * sizeof(float)) % pageSize() == 0;
+        }
+
+        // Paging hints are advisory, so a failure is logged once and otherwise ignored.
+        void adviceFailed(const char* call) {
+            static std::atomic<bool> logged{false};
+            if (!logged.exchange(true, std::memory_order_relaxed)) {
+                Logger::getInstance().log(LogLevel::Warning, "TiledMatrixFile: {} failed: {}", call, std::strerror(errno));
+            }
+        }
+    }
+
+    TiledMatrixFile TiledMatrixFile::create(const std::string& path, Eigen::Index rows, Eigen::Index cols, Eigen::Index tileSize) {
+        if (rows < 0 || cols < 0 || !validTileSize(tileSize)) {
+            fail("TiledMatrixFile: invalid shape or tile size " + std::to_string(tileSize) + " for " + path + ".");
+        }
+
+        TiledMatrixFile file;
+        file.rows_ = rows;
+        file.cols_ = cols;
+        file.tileSize_ = tileSize;
+
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            fail("TiledMatrixFile: cannot create " + path + ": " + std::strerror(errno));
+        }
+        const std::size_t bytes = HeaderBytes + static_cast<std::size_t>(file.tileRowCount() * file.tileColCount()) * file.tileBytes();
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            fail("TiledMatrixFile: cannot size " + path + ": " + std::strerror(errno));
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = FormatVersion;
+        header.tileSize = static_cast<std::uint32_t>(tileSize);
+        header.rows = static_cast<std::uint64_t>(rows);
+        header.cols = static_cast<std::uint64_t>(cols);
+        if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+            ::close(fd);
+            fail("TiledMatrixFile: cannot write header of " + path + ": " + std::strerror(errno));
+        }
+
+        file.map(fd, true);
+        return file;
+    }
+
+    TiledMatrixFile TiledMatrixFile::open(const std::string& path, bool writable) {
+        const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            fail("TiledMatrixFile: cannot open " + path + ": " + std::strerror(errno));
+        }
+
+        FileHeader header{};
+        if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != FormatVersion) {
+            ::close(fd);
+            fail("TiledMatrixFile: " + path + " is not a tiled matrix file.");
+        }
+        if (!validTileSize(static_cast<Eigen::Index>(header.tileSize))) {
+            ::close(fd);
+            fail("TiledMatrixFile: invalid tile size " + std::to_string(header.tileSize) + " in " + path + ".");
+        }
+
+        TiledMatrixFile file;
+        file.rows_ = static_cast<Eigen::Index>(header.rows);
+        file.cols_ = static_cast<Eigen::Index>(header.cols);
+        file.tileSize_ = static_cast<Eigen::Index>(header.tileSize);
+
+        struct stat info {};
+        const std::size_t expected = HeaderBytes + static_cast<std::size_t>(file.tileRowCount() * file.tileColCount()) * file.tileBytes();
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < expected) {
+            ::close(fd);
+            fail("TiledMatrixFile: " + path + " is truncated.");
+        }
+
+        file.map(fd, writable);
+        return file;
+    }
+
+    void TiledMatrixFile::map(int fd, bool writable) {
+        fd_ = fd;
+        writable_ = writable;
+        mappedBytes_ = HeaderBytes + static_cast<std::size_t>(tileRowCount() * tileColCount()) * tileBytes();
+        void* mapping = ::mmap(nullptr, mappedBytes_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            fd_ = -1;
+            fail(std::string("TiledMatrixFile: mmap failed: ") + std::strerror(errno));
+        }
+        mapping_ = static_cast<unsigned char*>(mapping);
+    }
+
+    void TiledMatrixFile::write(const std::string& path, const Matrix& matrix, Eigen::Index tileSize) {
+        TiledMatrixFile file = create(path, matrix.rows(), matrix.cols(), tileSize);
+        for (Eigen::Index tj = 0; tj < file.tileColCount(); ++tj) {
+            for (Eigen::Index ti = 0; ti < file.tileRowCount(); ++ti) {
+                const Eigen::Index rows = std::min(tileSize, matrix.rows() - ti * tileSize);
+                const Eigen::Index cols = std::min(tileSize, matrix.cols() - tj * tileSize);
+                Eigen::Map<Matrix>(file.tile(ti, tj), tileSize, tileSize).topLeftCorner(rows, cols) =
+                    matrix.block(ti * tileSize, tj * tileSize, rows, cols);
+            }
+            file.evict(0, tj, file.tileRowCount(), 1);
+        }
+    }
+
+    Matrix TiledMatrixFile::toMatrix() const {
+        Matrix matrix(rows_, cols_);
+        for (Eigen::Index tj = 0; tj < tileColCount(); ++tj) {
+            for (Eigen::Index ti = 0; ti < tileRowCount(); ++ti) {
+                const Eigen::Index rows = std::min(tileSize_, rows_ - ti * tileSize_);
+                const Eigen::Index cols = std::min(tileSize_, cols_ - tj * tileSize_);
+                matrix.block(ti * tileSize_, tj * tileSize_, rows, cols) =
+                    Eigen::Map<const Matrix>(tile(ti, tj), tileSize_, tileSize_).topLeftCorner(rows, cols);
+            }
+        }
+        return matrix;
+    }
+
+    TiledMatrixFile::TiledMatrixFile(TiledMatrixFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    TiledMatrixFile& TiledMatrixFile::operator=(TiledMatrixFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd_ = std::exchange(other.fd_, -1);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mappedBytes_ = std::exchange(other.mappedBytes_, 0);
+            writable_ = other.writable_;
+            rows_ = other.rows_;
+            cols_ = other.cols_;
+            tileSize_ = other.tileSize_;
+        }
+        return *this;
+    }
+
+    TiledMatrixFile::~TiledMatrixFile() {
+        release();
+    }
+
+    void TiledMatrixFile::release() {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mappedBytes_);
+            mapping_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    unsigned char* TiledMatrixFile::tileAddress(Eigen::Index ti, Eigen::Index tj) const {
+        return mapping_ + HeaderBytes + static_cast<std::size_t>(tj * tileRowCount() + ti) * tileBytes();
+    }
+
+    const float* TiledMatrixFile::tile(Eigen::Index ti, Eigen::Index tj) const {
+        return reinterpret_cast<const float*>(tileAddress(ti, tj));
+    }
+
+    float* TiledMatrixFile::tile(Eigen::Index ti, Eigen::Index tj) {
+        return reinterpret_cast<float*>(tileAddress(ti, tj));
+    }
+
+    void TiledMatrixFile::prefetch(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols) const {
+        advise(ti, tj, tileRows, tileCols, false);
+    }
+
+    void TiledMatrixFile::evict(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols) const {
+        advise(ti, tj, tileRows, tileCols, true);
+    }
+
+    void TiledMatrixFile::advise(Eigen::Index ti, Eigen::Index tj, Eigen::Index tileRows, Eigen::Index tileCols, bool evict) const {
+        tileRows = std::min(tileRows, tileRowCount() - ti);
+        tileCols = std::min(tileCols, tileColCount() - tj);
+        if (tileRows <= 0 || tileCols <= 0) {
+            return;
+        }
+        // Tiles of one tile column are contiguous, so each column of the range is one call.
+        for (Eigen::Index j = tj; j < tj + tileCols; ++j) {
+            unsigned char* start = tileAddress(ti, j);
+            const std::size_t length = static_cast<std::size_t>(tileRows) * tileBytes();
+            if (!evict) {
+                if (::madvise(start, length, MADV_WILLNEED) != 0) {
+                    adviceFailed("madvise(MADV_WILLNEED)");
+                }
+                continue;
+            }
+            if (writable_ && ::msync(start, length, MS_ASYNC) != 0) {
+                adviceFailed("msync(MS_ASYNC)");
+            }
+            if (::madvise(start, length, MADV_DONTNEED) != 0) {
+                adviceFailed("madvise(MADV_DONTNEED)");
+            }
+        }
+    }
+
+} // namespace MatrixTransform
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "aligned_buffer.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace MatrixTransform {
+
+    // Per-multiplier scratch arena. Each slot is an aligned buffer that grows to the largest
+    // request seen and is then reused, so steady-state calls perform no heap allocation.
+    // Not thread-safe: reserve every slot up front, then hand the raw pointers to workers.
+    class Workspace {
+    public:
+        float* acquire(std::size_t slot, std::size_t count) {
+            if (slot >= buffers_.size()) {
+                buffers_.resize(slot + 1);
+            }
+            buffers_[slot].reserve(count);
+            return buffers_[slot].data();
+        }
+
+        // Pointer to a slot that has already been acquired; safe to call from worker threads.
+        float* data(std::size_t slot) { return buffers_[slot].data(); }
+
+        std::size_t bytesReserved() const {
+            std::size_t bytes = 0;
+            for (const AlignedBuffer<float>& buffer : buffers_) {
+                bytes += buffer.capacity() * sizeof(float);
+            }
+            return bytes;
+        }
+
+    private:
+        std::vector<AlignedBuffer<float>> buffers_;
+    };
+
+} // namespace MatrixTransform
@@ -0,0 +1,157 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "matrix_transform/matrix_types.hpp"
+#include "matrix_transform/interfaces.hpp"
+#include "multiplier_registry.hpp"
+#include "shard_protocol.hpp"
+#include "logger.hpp"
+
+// Worker process for the SHARDED backend. Serves requests from the socket passed as --fd
+// against blocks of a shared memory segment, running them on the --backend multiplier.
+
+using MatrixTransform::Logger;
+using MatrixTransform::LogLevel;
+namespace ShardProtocol = MatrixTransform::ShardProtocol;
+
+namespace {
+
+    struct Segment {
+        char* base = nullptr;
+        std::size_t bytes = 0;
+
+        ~Segment() { unmap(); }
+
+        void unmap() {
+            if (base != nullptr) {
+                munmap(base, bytes);
+            }
+            base = nullptr;
+            bytes = 0;
+        }
+
+        // True if a rows x cols column-major block at offset with leading dimension ld lies
+        // inside the segment.
+        bool contains(std::uint64_t offset, std::int64_t rows, std::int64_t cols, std::int64_t ld) const {
+            if (rows < 0 || cols < 0 || ld < rows || offset % sizeof(float) != 0) {
+                return false;
+            }
+            const std::uint64_t extent = (rows == 0 || cols == 0) ? 0 : sizeof(float) * ((cols - 1) * ld + rows);
+            return offset <= bytes && extent <= bytes - offset;
+        }
+    };
+
+    void fail(ShardProtocol::Reply& reply, const std::string& message) {
+        reply.status = 1;
+        std::strncpy(reply.message, message.c_str(), sizeof(reply.message) - 1);
+    }
+
+    void attach(Segment& segment, const ShardProtocol::Request& request, ShardProtocol::Reply& reply) {
+        segment.unmap();
+        const std::string name(request.segment, strnlen(request.segment, sizeof(request.segment)));
+        const int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            fail(reply, "shm_open " + name + ": " + std::strerror(errno));
+            return;
+        }
+        void* mapping = mmap(nullptr, request.segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            fail(reply, "mmap " + name + ": " + std::strerror(errno));
+            return;
+        }
+        segment.base = static_cast<char*>(mapping);
+        segment.bytes = request.segmentBytes;
+    }
+
+    void gemm(MatrixTransform::IMultiplier& multiplier, const Segment& segment,
+              const ShardProtocol::Request& request, ShardProtocol::Reply& reply) {
+        if (!segment.contains(request.aOffset, request.m, request.k, request.lda) ||
+            !segment.contains(request.bOffset, request.k, request.n, request.ldb) ||
+            !segment.contains(request.cOffset, request.m, request.n, request.ldc)) {
+            fail(reply, "request addresses memory outside the shared segment");
+            return;
+        }
+
+        // Backends read the panels and write the output block in place in the segment.
+        const ConstMatrixView a(reinterpret_cast<const float*>(segment.base + request.aOffset), request.m, request.k, request.lda);
+        const ConstMatrixView b(reinterpret_cast<const float*>(segment.base + request.bOffset), request.k, request.n, request.ldb);
+        const MatrixView c(reinterpret_cast<float*>(segment.base + request.cOffset), request.m, request.n, request.ldc);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        multiplier.gemm(request.alpha, a, b, request.beta, c);
+        reply.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+int main(int argc, char const *argv[])
+{
+    int socket = -1;
+    std::string backend = "AUTO";
+    std::string logLevel = "warning";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        if (arg == "--fd") {
+            socket = std::atoi(argv[i + 1]);
+        } else if (arg == "--backend") {
+            backend = argv[i + 1];
+        } else if (arg == "--log-level") {
+            logLevel = argv[i + 1];
+        }
+    }
+    if (socket < 0) {
+        std::cerr << "Usage: " << argv[0] << " --fd N [--backend KEY] [--log-level level]" << std::endl;
+        std::cerr << "matrix_worker is started by the SHARDED backend." << std::endl;
+        return 1;
+    }
+    Logger::getInstance().setLevel(logLevel);
+
+    ShardProtocol::Reply hello{};
+    std::unique_ptr<MatrixTransform::IMultiplier> multiplier;
+    try {
+        if (backend == "SHARDED") {
+            throw std::invalid_argument("worker backend cannot be SHARDED");
+        }
+        multiplier = MatrixTransform::MultiplierRegistry::getInstance().createMultiplier(backend);
+    } catch (const std::exception& e) {
+        fail(hello, std::string("could not create worker backend ") + backend + ": " + e.what());
+    }
+    if (!ShardProtocol::send(socket, hello) || !multiplier) {
+        return 1;
+    }
+
+    Segment segment;
+    ShardProtocol::Request request{};
+    while (ShardProtocol::receive(socket, request)) {
+        ShardProtocol::Reply reply{};
+        if (request.version != ShardProtocol::Version) {
+            fail(reply, "protocol version mismatch");
+        } else if (request.op == ShardProtocol::Op::Shutdown) {
+            break;
+        } else if (request.op == ShardProtocol::Op::Attach) {
+            attach(segment, request, reply);
+        } else if (request.op == ShardProtocol::Op::Gemm) {
+            try {
+                gemm(*multiplier, segment, request, reply);
+            } catch (const std::exception& e) {
+                fail(reply, e.what());
+            }
+        } else {
+            fail(reply, "unknown request");
+        }
+        if (!ShardProtocol::send(socket, reply)) {
+            break;
+        }
+    }
+
+    return 0;
+}